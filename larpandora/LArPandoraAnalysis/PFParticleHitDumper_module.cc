@@ -66,20 +66,20 @@ private:
      *  @brief Store 2D hits
      *
      *  @param hitVector the input vector of 2D hits
-     *  @param hitsToParticles mapping between 2D hits and PFParticles
+     *  @param hitsToParticles index from 2D hits to PFParticles
      */
-     void FillReco2D(const HitVector &hitVector, const HitsToPFParticles &hitsToParticles);
+     void FillReco2D(const HitVector &hitVector, const HitsToPFParticlesIndex &hitsToParticles);
 
     /**
      *  @brief Store number of 2D hits associated to PFParticle in different ways
      *
      *  @param particleVector the input vector of PFParticles
-     *  @param particlesToHits mapping between PFParticles and 2D hits through space points
-     *  @param particlesToHitsClusters mapping between PFParticles and 2D hits through clusters
+     *  @param particlesToHits index from PFParticles to 2D hits through space points
+     *  @param particlesToHitsClusters index from PFParticles to 2D hits through clusters
      *  @param particlesToTracks mapping between PFParticles and tracks
      *  @param particlesToShowers mapping between PFParticles and showers
      */
-     void FillAssociated2DHits(const art::Event &evt, const PFParticleVector &particleVector, const PFParticlesToHits &particlesToHits, const PFParticlesToHits &particlesToHitsClusters,
+     void FillAssociated2DHits(const art::Event &evt, const PFParticleVector &particleVector, const PFParticlesToHitsIndex &particlesToHits, const PFParticlesToHitsIndex &particlesToHitsClusters,
           const PFParticlesToTracks &particlesToTracks, const TracksToHits &tracksToHits, const PFParticlesToShowers &particlesToShowers, const ShowersToHits &showersToHits);
 
     /**
@@ -343,10 +343,10 @@ void PFParticleHitDumper::analyze(const art::Event &evt)
     PFParticlesToTracks      particlesToTracks;
     PFParticlesToShowers     particlesToShowers;
     PFParticlesToSpacePoints particlesToSpacePoints;
-    PFParticlesToHits        particlesToHits, particlesToHitsClusters;
+    PFParticlesToHitsIndex   particlesToHits, particlesToHitsClusters;
     TracksToHits             tracksToHits;
     ShowersToHits            showersToHits;
-    HitsToPFParticles        hitsToParticles, hitsToParticlesClusters;
+    HitsToPFParticlesIndex   hitsToParticles, hitsToParticlesClusters;
     SpacePointsToHits        spacePointsToHits;
 
     LArPandoraHelper::CollectHits(evt, m_hitfinderLabel, hitVector);
@@ -535,7 +535,7 @@ void PFParticleHitDumper::FillReco3D(const PFParticleVector &particleVector, con
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleHitDumper::FillAssociated2DHits(const art::Event &evt, const PFParticleVector &particleVector, const PFParticlesToHits &particlesToHits, const PFParticlesToHits &particlesToHitsClusters,
+void PFParticleHitDumper::FillAssociated2DHits(const art::Event &evt, const PFParticleVector &particleVector, const PFParticlesToHitsIndex &particlesToHits, const PFParticlesToHitsIndex &particlesToHitsClusters,
     const PFParticlesToTracks &particlesToTracks, const TracksToHits &tracksToHits, const PFParticlesToShowers &particlesToShowers, const ShowersToHits &showersToHits)
 {
     // Create dummy entry if there are no 2D hits
@@ -557,12 +557,10 @@ void PFParticleHitDumper::FillAssociated2DHits(const art::Event &evt, const PFPa
         m_particle = particle->Self();
         m_pdgcode = particle->PdgCode();
 
-        PFParticlesToHits::const_iterator pIter  = particlesToHits.find(particle);
-        PFParticlesToHits::const_iterator pIter2 = particlesToHitsClusters.find(particle);
-        if (particlesToHits.end() != pIter)
-            m_hitsFromSpacePoints = pIter->second.size();
-        if (particlesToHitsClusters.end() != pIter2)
-            m_hitsFromClusters = pIter2->second.size();
+        if (particlesToHits.count(particle))
+            m_hitsFromSpacePoints = particlesToHits.at(particle).size();
+        if (particlesToHitsClusters.count(particle))
+            m_hitsFromClusters = particlesToHitsClusters.at(particle).size();
 
         if (m_pdgcode == 13)
         {
@@ -599,7 +597,7 @@ void PFParticleHitDumper::FillAssociated2DHits(const art::Event &evt, const PFPa
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleHitDumper::FillReco2D(const HitVector &hitVector, const HitsToPFParticles &hitsToParticles)
+void PFParticleHitDumper::FillReco2D(const HitVector &hitVector, const HitsToPFParticlesIndex &hitsToParticles)
 {
     // Initialise variables
     m_particle = -1;
@@ -629,10 +627,9 @@ void PFParticleHitDumper::FillReco2D(const HitVector &hitVector, const HitsToPFP
         m_particle = -1;
         m_pdgcode = 0;
 
-        HitsToPFParticles::const_iterator pIter = hitsToParticles.find(hit);
-        if (hitsToParticles.end() != pIter)
+        if (hitsToParticles.count(hit))
         {
-            const art::Ptr<recob::PFParticle> particle = pIter->second;
+            const art::Ptr<recob::PFParticle> particle = hitsToParticles.at(hit);
             m_particle = particle->Self();
             m_pdgcode = particle->PdgCode();
         }
@@ -48,6 +48,7 @@ private:
 
     bool            m_ShouldProduceNeutrinos;          ///< If we should produce collections related to neutrino top-level PFParticles
     bool            m_ShouldProduceT0s;                ///< If we should produce T0s (relevant when stitching over multiple drift volumes)
+    bool            m_ShouldDeferFilteredCopies;       ///< If filtering should produce views of the input collections, copied only when written or merged
 };
 
 DEFINE_ART_MODULE(CollectionMerging)
@@ -87,7 +88,8 @@ CollectionMerging::CollectionMerging(fhicl::ParameterSet const &pset) :
     m_ClearCRTagProducerLabel(pset.get<std::string>("ClearCRTagProducerLabel")),
     m_NuIdCRTagProducerLabel(pset.get<std::string>("NuIdCRTagProducerLabel")),
     m_ShouldProduceNeutrinos(pset.get<bool>("ShouldProduceNeutrinos", true)),
-    m_ShouldProduceT0s(pset.get<bool>("ShouldProduceT0s", false))
+    m_ShouldProduceT0s(pset.get<bool>("ShouldProduceT0s", false)),
+    m_ShouldDeferFilteredCopies(pset.get<bool>("ShouldDeferFilteredCopies", false))
 {
     produces< std::vector<recob::PFParticle> >();
     produces< std::vector<recob::SpacePoint> >();
@@ -133,14 +135,15 @@ void CollectionMerging::produce(art::Event &evt)
 
     if (m_ShouldProduceNeutrinos)
     {
-        const lar_pandora::LArPandoraEvent filteredCRRemHitsNuEvent(crRemHitsNuEvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_NuIdCRTagProducerLabel));
+        const lar_pandora::LArPandoraEvent filteredCRRemHitsNuEvent(crRemHitsNuEvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_NuIdCRTagProducerLabel, m_ShouldDeferFilteredCopies));
         filteredCRRemHitsNuEvent.WriteToEvent();
     }
     else
     {
-        const lar_pandora::LArPandoraEvent filteredAllHitsCREvent(allHitsCREvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_ClearCRTagProducerLabel));
-        const lar_pandora::LArPandoraEvent filteredCRRemHitsCREvent(crRemHitsCREvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_NuIdCRTagProducerLabel));
-        const lar_pandora::LArPandoraEvent mergedEvent(filteredAllHitsCREvent.Merge(filteredCRRemHitsCREvent));
+        const lar_pandora::LArPandoraEvent filteredAllHitsCREvent(allHitsCREvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_ClearCRTagProducerLabel, m_ShouldDeferFilteredCopies));
+        const lar_pandora::LArPandoraEvent filteredCRRemHitsCREvent(crRemHitsCREvent.FilterByCRTag(m_ShouldProduceNeutrinos, m_NuIdCRTagProducerLabel, m_ShouldDeferFilteredCopies));
+        const std::vector<const lar_pandora::LArPandoraEvent *> eventsToMerge = {&filteredCRRemHitsCREvent, &filteredAllHitsCREvent};
+        const lar_pandora::LArPandoraEvent mergedEvent(lar_pandora::LArPandoraEvent::Merge(eventsToMerge));
         mergedEvent.WriteToEvent();
     }
 }
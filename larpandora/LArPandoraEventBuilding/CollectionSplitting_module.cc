@@ -38,6 +38,7 @@ private:
     bool            m_ShouldProduceNeutrinos;       ///< If we should produce collections related to neutrino top-level PFParticles
     bool            m_ShouldProduceCosmics;         ///< If we should produce collections related to cosmic top-level PFParticles
     bool            m_ShouldProduceT0s;             ///< If we should produce T0s (relevant when stitching over multiple drift volumes)
+    bool            m_ShouldDeferFilteredCopies;    ///< If filtering should produce views of the input collections, copied only when written
 };
 
 DEFINE_ART_MODULE(CollectionSplitting)
@@ -68,7 +69,8 @@ CollectionSplitting::CollectionSplitting(fhicl::ParameterSet const &pset) :
     m_HitProducerLabel(pset.get<std::string>("HitProducerLabel")),
     m_ShouldProduceNeutrinos(pset.get<bool>("ShouldProduceNeutrinos", true)),
     m_ShouldProduceCosmics(pset.get<bool>("ShouldProduceCosmics", true)),
-    m_ShouldProduceT0s(pset.get<bool>("ShouldProduceT0s", false))
+    m_ShouldProduceT0s(pset.get<bool>("ShouldProduceT0s", false)),
+    m_ShouldDeferFilteredCopies(pset.get<bool>("ShouldDeferFilteredCopies", false))
 {
     produces< std::vector<recob::PFParticle> >();
     produces< std::vector<recob::SpacePoint> >();
@@ -115,7 +117,7 @@ void CollectionSplitting::produce(art::Event &evt)
     }
     else
     {
-        const lar_pandora::LArPandoraEvent filteredEvent(fullEvent.FilterByPdgCode(m_ShouldProduceNeutrinos));
+        const lar_pandora::LArPandoraEvent filteredEvent(fullEvent.FilterByPdgCode(m_ShouldProduceNeutrinos, m_ShouldDeferFilteredCopies));
         filteredEvent.WriteToEvent();
     }
 }
@@ -14,14 +14,16 @@ LArPandoraEvent::LArPandoraEvent(art::EDProducer *pProducer, art::Event *pEvent,
     m_pEvent(pEvent),
     m_labels(inputLabels),
     m_shouldProduceT0s(shouldProduceT0s),
-    m_shift(shift)
+    m_shift(shift),
+    m_pCollections(std::make_shared<Collections>()),
+    m_isFilteredView(false)
 {
-    this->GetCollections();
-
-    for (const art::Ptr<recob::PFParticle> &part : m_pfParticles)
+    // ATTN each collection and association is only read from the event when first needed by a filter, merge or write. The T0s are
+    // never read unless they should be produced
+    if (!m_shouldProduceT0s)
     {
-        if (!m_pfParticleToOriginIdMap.insert(std::map< art::Ptr< recob::PFParticle >, unsigned int >::value_type(part, 0)).second)
-            throw cet::exception("LArPandora") << " LArPandoraEvent::LArPandoraEvent -- Repeated input PFParticles!" << std::endl;
+        m_pCollections->m_t0s.m_isLoaded = true;
+        m_pCollections->m_pfParticleT0Map.m_isLoaded = true;
     }
 }
 
@@ -33,44 +35,72 @@ LArPandoraEvent::LArPandoraEvent(const LArPandoraEvent &event, const PFParticleV
     m_labels(event.m_labels),
     m_shouldProduceT0s(event.m_shouldProduceT0s),
     m_shift(event.m_shift),
-    m_hits(event.m_hits)
+    m_pCollections(std::make_shared<Collections>()),
+    m_isFilteredView(false)
 {
-    m_pfParticles = selectedPFParticles;
-    this->FillPFParticleToOriginIdMap(event.m_pfParticleToOriginIdMap);
+    Collections &collections(*m_pCollections);
+    collections.SetFilled();
+
+    collections.m_hits.m_collection = event.GetHits();
+    collections.m_pfParticles.m_collection = selectedPFParticles;
+    this->FillPFParticleToOriginIdMap(event.GetPFParticleToOriginIdMap());
+
+    // ATTN the associations are indexed by position in the source collections of the input event
+    PtrKeyToIndexMap pfParticleIndex, spacePointIndex, clusterIndex, trackIndex, showerIndex;
+    this->GetPositionIndex(event.GetPFParticles(), pfParticleIndex);
+    this->GetPositionIndex(event.GetSpacePoints(), spacePointIndex);
+    this->GetPositionIndex(event.GetClusters(), clusterIndex);
+    this->GetPositionIndex(event.GetTracks(), trackIndex);
+    this->GetPositionIndex(event.GetShowers(), showerIndex);
 
     for (art::Ptr< recob::PFParticle > part : selectedPFParticles)
     {
-        this->CollectAssociated(part, event.m_pfParticleSpacePointMap, m_spacePoints);
-        this->CollectAssociated(part, event.m_pfParticleClusterMap, m_clusters);
-        this->CollectAssociated(part, event.m_pfParticleVertexMap, m_vertices);
-        this->CollectAssociated(part, event.m_pfParticleTrackMap, m_tracks);
-        this->CollectAssociated(part, event.m_pfParticleShowerMap, m_showers);
-        this->CollectAssociated(part, event.m_pfParticlePCAxisMap, m_pcAxes);
-        this->CollectAssociated(part, event.m_pfParticleMetadataMap, m_metadata);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleSpacePointMap(), collections.m_spacePoints.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleClusterMap(), collections.m_clusters.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleVertexMap(), collections.m_vertices.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleTrackMap(), collections.m_tracks.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleShowerMap(), collections.m_showers.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticlePCAxisMap(), collections.m_pcAxes.m_collection);
+        this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleMetadataMap(), collections.m_metadata.m_collection);
 
         if (m_shouldProduceT0s)
-            this->CollectAssociated(part, event.m_pfParticleT0Map, m_t0s);
+            this->CollectAssociated(part, pfParticleIndex, event.GetPFParticleT0Map(), collections.m_t0s.m_collection);
     }
 
-    this->GetFilteredAssociationMap(m_pfParticles, m_spacePoints, event.m_pfParticleSpacePointMap, m_pfParticleSpacePointMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_clusters, event.m_pfParticleClusterMap, m_pfParticleClusterMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_vertices, event.m_pfParticleVertexMap, m_pfParticleVertexMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_tracks, event.m_pfParticleTrackMap, m_pfParticleTrackMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_showers, event.m_pfParticleShowerMap, m_pfParticleShowerMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_pcAxes, event.m_pfParticlePCAxisMap, m_pfParticlePCAxisMap);
-    this->GetFilteredAssociationMap(m_pfParticles, m_metadata, event.m_pfParticleMetadataMap, m_pfParticleMetadataMap);
-    this->GetFilteredAssociationMap(m_spacePoints, event.m_hits, event.m_spacePointHitMap, m_spacePointHitMap);
-    this->GetFilteredAssociationMap(m_clusters, event.m_hits, event.m_clusterHitMap, m_clusterHitMap);
-    this->GetFilteredAssociationMap(m_tracks, event.m_hits, event.m_trackHitMap, m_trackHitMap);
-    this->GetFilteredAssociationMap(m_showers, event.m_hits, event.m_showerHitMap, m_showerHitMap);
-    this->GetFilteredAssociationMap(m_showers, m_pcAxes, event.m_showerPCAxisMap, m_showerPCAxisMap);
+    // ATTN membership of the filtered collections is tested against sets built once per collection, so filtering is linear
+    PtrKeySet spacePointKeys, clusterKeys, vertexKeys, trackKeys, showerKeys, pcAxisKeys, metadataKeys, t0Keys, hitKeys;
+    GetPtrKeySet(collections.m_spacePoints.m_collection, spacePointKeys);
+    GetPtrKeySet(collections.m_clusters.m_collection, clusterKeys);
+    GetPtrKeySet(collections.m_vertices.m_collection, vertexKeys);
+    GetPtrKeySet(collections.m_tracks.m_collection, trackKeys);
+    GetPtrKeySet(collections.m_showers.m_collection, showerKeys);
+    GetPtrKeySet(collections.m_pcAxes.m_collection, pcAxisKeys);
+    GetPtrKeySet(collections.m_metadata.m_collection, metadataKeys);
+    GetPtrKeySet(collections.m_t0s.m_collection, t0Keys);
+    GetPtrKeySet(collections.m_hits.m_collection, hitKeys);
+
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, spacePointKeys, pfParticleIndex, event.GetPFParticleSpacePointMap(), collections.m_pfParticleSpacePointMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, clusterKeys, pfParticleIndex, event.GetPFParticleClusterMap(), collections.m_pfParticleClusterMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, vertexKeys, pfParticleIndex, event.GetPFParticleVertexMap(), collections.m_pfParticleVertexMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, trackKeys, pfParticleIndex, event.GetPFParticleTrackMap(), collections.m_pfParticleTrackMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, showerKeys, pfParticleIndex, event.GetPFParticleShowerMap(), collections.m_pfParticleShowerMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, pcAxisKeys, pfParticleIndex, event.GetPFParticlePCAxisMap(), collections.m_pfParticlePCAxisMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, metadataKeys, pfParticleIndex, event.GetPFParticleMetadataMap(), collections.m_pfParticleMetadataMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_spacePoints.m_collection, hitKeys, spacePointIndex, event.GetSpacePointHitMap(), collections.m_spacePointHitMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_clusters.m_collection, hitKeys, clusterIndex, event.GetClusterHitMap(), collections.m_clusterHitMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_tracks.m_collection, hitKeys, trackIndex, event.GetTrackHitMap(), collections.m_trackHitMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_showers.m_collection, hitKeys, showerIndex, event.GetShowerHitMap(), collections.m_showerHitMap.m_association);
+    this->GetFilteredAssociationMap(collections.m_showers.m_collection, pcAxisKeys, showerIndex, event.GetShowerPCAxisMap(), collections.m_showerPCAxisMap.m_association);
+
+    if (m_shouldProduceT0s)
+        this->GetFilteredAssociationMap(collections.m_pfParticles.m_collection, t0Keys, pfParticleIndex, event.GetPFParticleT0Map(), collections.m_pfParticleT0Map.m_association);
 
-    this->GetFilteredHierarchyMap(selectedPFParticles, event.m_pfParticleDaughterMap, m_pfParticleDaughterMap);
+    this->GetFilteredHierarchyMap(selectedPFParticles, event.GetPFParticleDaughterMap(), collections.m_pfParticleDaughterMap);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-LArPandoraEvent LArPandoraEvent::FilterByPdgCode(const bool shouldProduceNeutrinos) const
+LArPandoraEvent LArPandoraEvent::FilterByPdgCode(const bool shouldProduceNeutrinos, const bool shouldDeferCopy) const
 {
     PFParticleVector primaryPFParticles;
     this->GetPrimaryPFParticles(primaryPFParticles);
@@ -81,14 +111,12 @@ LArPandoraEvent LArPandoraEvent::FilterByPdgCode(const bool shouldProduceNeutrin
     PFParticleVector selectedPFParticles;
     this->GetDownstreamPFParticles(filteredPFParticles, selectedPFParticles);
 
-    LArPandoraEvent filteredEvent(*this, selectedPFParticles);
-
-    return filteredEvent;
+    return this->GetFilteredEvent(selectedPFParticles, shouldDeferCopy);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-LArPandoraEvent LArPandoraEvent::FilterByCRTag(const bool shouldProduceNeutrinos, const std::string &tagProducerLabel) const
+LArPandoraEvent LArPandoraEvent::FilterByCRTag(const bool shouldProduceNeutrinos, const std::string &tagProducerLabel, const bool shouldDeferCopy) const
 {
     PFParticleVector primaryPFParticles;
     this->GetPrimaryPFParticles(primaryPFParticles);
@@ -99,130 +127,262 @@ LArPandoraEvent LArPandoraEvent::FilterByCRTag(const bool shouldProduceNeutrinos
     PFParticleVector selectedPFParticles;
     this->GetDownstreamPFParticles(filteredPFParticles, selectedPFParticles);
 
-    LArPandoraEvent filteredEvent(*this, selectedPFParticles);
-
-    return filteredEvent;
+    return this->GetFilteredEvent(selectedPFParticles, shouldDeferCopy);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void LArPandoraEvent::WriteToEvent() const
 {
-    this->WriteCollection(m_pfParticles);
-    this->WriteCollection(m_spacePoints);
-    this->WriteCollection(m_clusters);
-    this->WriteCollection(m_vertices);
-    this->WriteCollection(m_tracks);
-    this->WriteCollection(m_showers);
-    this->WriteCollection(m_pcAxes);
-    this->WriteCollection(m_metadata);
-
-    this->WriteAssociation(m_pfParticleSpacePointMap, m_pfParticles, m_spacePoints);
-    this->WriteAssociation(m_pfParticleClusterMap, m_pfParticles, m_clusters);
-    this->WriteAssociation(m_pfParticleVertexMap, m_pfParticles, m_vertices);
-    this->WriteAssociation(m_pfParticleTrackMap, m_pfParticles, m_tracks);
-    this->WriteAssociation(m_pfParticleShowerMap, m_pfParticles, m_showers);
-    this->WriteAssociation(m_pfParticlePCAxisMap, m_pfParticles, m_pcAxes);
-    this->WriteAssociation(m_pfParticleMetadataMap, m_pfParticles, m_metadata);
-    this->WriteAssociation(m_spacePointHitMap, m_spacePoints, m_hits, false);
-    this->WriteAssociation(m_clusterHitMap, m_clusters, m_hits, false);
-    this->WriteAssociation(m_trackHitMap, m_tracks, m_hits, false);
-    this->WriteAssociation(m_showerHitMap, m_showers, m_hits, false);
-    this->WriteAssociation(m_showerPCAxisMap, m_showers, m_pcAxes);
+    if (this->IsFilteredView())
+    {
+        this->GetResolvedEvent().WriteToEvent();
+        return;
+    }
+
+    // ATTN the position indices map each input object to its index in the written collection, so associations are written in linear time
+    PtrKeyToIndexMap pfParticleIndex, spacePointIndex, clusterIndex, vertexIndex, trackIndex, showerIndex, pcAxisIndex, metadataIndex;
+    const PtrKeyToIndexMap hitIndex;
+
+    this->WriteCollection(this->GetPFParticles(), pfParticleIndex);
+    this->WriteCollection(this->GetSpacePoints(), spacePointIndex);
+    this->WriteCollection(this->GetClusters(), clusterIndex);
+    this->WriteCollection(this->GetVertices(), vertexIndex);
+    this->WriteCollection(this->GetTracks(), trackIndex);
+    this->WriteCollection(this->GetShowers(), showerIndex);
+    this->WriteCollection(this->GetPCAxes(), pcAxisIndex);
+    this->WriteCollection(this->GetMetadata(), metadataIndex);
+
+    this->WriteAssociation(this->GetPFParticleSpacePointMap(), this->GetPFParticles(), spacePointIndex);
+    this->WriteAssociation(this->GetPFParticleClusterMap(), this->GetPFParticles(), clusterIndex);
+    this->WriteAssociation(this->GetPFParticleVertexMap(), this->GetPFParticles(), vertexIndex);
+    this->WriteAssociation(this->GetPFParticleTrackMap(), this->GetPFParticles(), trackIndex);
+    this->WriteAssociation(this->GetPFParticleShowerMap(), this->GetPFParticles(), showerIndex);
+    this->WriteAssociation(this->GetPFParticlePCAxisMap(), this->GetPFParticles(), pcAxisIndex);
+    this->WriteAssociation(this->GetPFParticleMetadataMap(), this->GetPFParticles(), metadataIndex);
+    this->WriteAssociation(this->GetSpacePointHitMap(), this->GetSpacePoints(), hitIndex, false);
+    this->WriteAssociation(this->GetClusterHitMap(), this->GetClusters(), hitIndex, false);
+    this->WriteAssociation(this->GetTrackHitMap(), this->GetTracks(), hitIndex, false);
+    this->WriteAssociation(this->GetShowerHitMap(), this->GetShowers(), hitIndex, false);
+    this->WriteAssociation(this->GetShowerPCAxisMap(), this->GetShowers(), pcAxisIndex);
 
     if (m_shouldProduceT0s)
     {
-        this->WriteCollection(m_t0s);
-        this->WriteAssociation(m_pfParticleT0Map, m_pfParticles, m_t0s);
+        PtrKeyToIndexMap t0Index;
+        this->WriteCollection(this->GetT0s(), t0Index);
+        this->WriteAssociation(this->GetPFParticleT0Map(), this->GetPFParticles(), t0Index);
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraEvent::WriteSelectionToEvent(const std::string &selectionLabel) const
+{
+    if (this->IsFilteredView())
+    {
+        this->GetResolvedEvent().WriteSelectionToEvent(selectionLabel);
+        return;
+    }
+
+    const PFParticleVector &pfParticles(this->GetPFParticles());
+    const std::map<art::Ptr<recob::PFParticle>, unsigned int> &pfParticleToOriginIdMap(this->GetPFParticleToOriginIdMap());
+
+    std::unique_ptr<std::vector<unsigned int> > pfParticleIdOffsets(new std::vector<unsigned int>);
+    pfParticleIdOffsets->reserve(pfParticles.size());
+
+    for (const art::Ptr<recob::PFParticle> &part : pfParticles)
+    {
+        if (part->Self() >= m_shift)
+            throw cet::exception("LArPandora") << " LArPandoraEvent::WriteSelectionToEvent -- PFParticle ID exceeds shift value of " << m_shift << ". Can't merge the collections!" << std::endl;
+
+        if (pfParticleToOriginIdMap.find(part) == pfParticleToOriginIdMap.end())
+            throw cet::exception("LArPandora") << " LArPandoraEvent::WriteSelectionToEvent -- Can't find supplied PFParticle in the PFParticle to origin ID map." << std::endl;
+
+        pfParticleIdOffsets->push_back(static_cast<unsigned int>(m_shift * pfParticleToOriginIdMap.at(part)));
+    }
+
+    this->WriteSelection(pfParticles, selectionLabel, LArPandoraEventSelection::kPFParticles);
+    this->WriteSelection(this->GetSpacePoints(), selectionLabel, LArPandoraEventSelection::kSpacePoints);
+    this->WriteSelection(this->GetClusters(), selectionLabel, LArPandoraEventSelection::kClusters);
+    this->WriteSelection(this->GetVertices(), selectionLabel, LArPandoraEventSelection::kVertices);
+    this->WriteSelection(this->GetTracks(), selectionLabel, LArPandoraEventSelection::kTracks);
+    this->WriteSelection(this->GetShowers(), selectionLabel, LArPandoraEventSelection::kShowers);
+    this->WriteSelection(this->GetPCAxes(), selectionLabel, LArPandoraEventSelection::kPCAxes);
+    this->WriteSelection(this->GetMetadata(), selectionLabel, LArPandoraEventSelection::kMetadata);
+    this->WriteSelection(this->GetT0s(), selectionLabel, LArPandoraEventSelection::kT0s);
+
+    m_pEvent->put(std::move(pfParticleIdOffsets), selectionLabel + LArPandoraEventSelection::kPFParticleIdOffsetSuffix);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 LArPandoraEvent LArPandoraEvent::Merge(const LArPandoraEvent &other) const
 {
-    if (m_shift != other.m_shift)
-        throw cet::exception("LArPandora") << " LArPandoraEvent::Merge - Can't merge LArPandoraEvents with differing shift values." << std::endl;
+    const std::vector<const LArPandoraEvent *> events = {&other, this};
+    return LArPandoraEvent::Merge(events);
+}
 
-    LArPandoraEvent outputEvent(other);
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-    this->MergePFParticleToOriginIdMap(outputEvent.m_pfParticleToOriginIdMap, m_pfParticleToOriginIdMap);
+LArPandoraEvent LArPandoraEvent::Merge(const std::vector<const LArPandoraEvent *> &events)
+{
+    if (events.empty())
+        throw cet::exception("LArPandora") << " LArPandoraEvent::Merge - No LArPandoraEvents supplied to merge." << std::endl;
 
-    this->MergeCollection(outputEvent.m_pfParticles, m_pfParticles);
-    this->MergeCollection(outputEvent.m_spacePoints, m_spacePoints);
-    this->MergeCollection(outputEvent.m_clusters, m_clusters);
-    this->MergeCollection(outputEvent.m_vertices, m_vertices);
-    this->MergeCollection(outputEvent.m_tracks, m_tracks);
-    this->MergeCollection(outputEvent.m_showers, m_showers);
-    this->MergeCollection(outputEvent.m_pcAxes, m_pcAxes);
-    this->MergeCollection(outputEvent.m_metadata, m_metadata);
-    this->MergeCollection(outputEvent.m_hits, m_hits);
+    // ATTN filtered views are resolved before merging, as merging concatenates the collections and renumbers the PFParticles
+    std::vector<LArPandoraEvent> resolvedEvents;
+    resolvedEvents.reserve(events.size());
 
-    if (m_shouldProduceT0s)
-        this->MergeCollection(outputEvent.m_t0s, m_t0s);
+    std::vector<const LArPandoraEvent *> inputEvents;
+    inputEvents.reserve(events.size());
 
-    this->MergeAssociation(outputEvent.m_pfParticleSpacePointMap, m_pfParticleSpacePointMap);
-    this->MergeAssociation(outputEvent.m_pfParticleClusterMap, m_pfParticleClusterMap);
-    this->MergeAssociation(outputEvent.m_pfParticleVertexMap, m_pfParticleVertexMap);
-    this->MergeAssociation(outputEvent.m_pfParticleTrackMap, m_pfParticleTrackMap);
-    this->MergeAssociation(outputEvent.m_pfParticleShowerMap, m_pfParticleShowerMap);
-    this->MergeAssociation(outputEvent.m_pfParticlePCAxisMap, m_pfParticlePCAxisMap);
-    this->MergeAssociation(outputEvent.m_pfParticleMetadataMap, m_pfParticleMetadataMap);
+    for (const LArPandoraEvent *const pEvent : events)
+    {
+        if (pEvent->m_shift != events.front()->m_shift)
+            throw cet::exception("LArPandora") << " LArPandoraEvent::Merge - Can't merge LArPandoraEvents with differing shift values." << std::endl;
 
-    if (m_shouldProduceT0s)
-        this->MergeAssociation(outputEvent.m_pfParticleT0Map, m_pfParticleT0Map);
+        if (pEvent->IsFilteredView())
+        {
+            resolvedEvents.push_back(pEvent->GetResolvedEvent());
+            inputEvents.push_back(&resolvedEvents.back());
+        }
+        else
+        {
+            inputEvents.push_back(pEvent);
+        }
+    }
+
+    const LArPandoraEvent &firstEvent(*inputEvents.front());
+    LArPandoraEvent outputEvent(firstEvent.m_pProducer, firstEvent.m_pEvent, firstEvent.m_labels, firstEvent.m_shouldProduceT0s, firstEvent.m_shift);
+
+    Collections &outputCollections(*outputEvent.m_pCollections);
+    outputCollections.SetFilled();
+
+    LArPandoraEvent::MergePFParticleToOriginIdMaps(inputEvents, outputCollections.m_pfParticleToOriginIdMap);
+
+    for (const LArPandoraEvent *const pEvent : inputEvents)
+    {
+        const PFParticlesToPFParticles &pfParticleDaughterMap(pEvent->GetPFParticleDaughterMap());
+        outputCollections.m_pfParticleDaughterMap.insert(pfParticleDaughterMap.begin(), pfParticleDaughterMap.end());
+    }
 
-    this->MergeAssociation(outputEvent.m_spacePointHitMap, m_spacePointHitMap);
-    this->MergeAssociation(outputEvent.m_clusterHitMap, m_clusterHitMap);
-    this->MergeAssociation(outputEvent.m_trackHitMap, m_trackHitMap);
-    this->MergeAssociation(outputEvent.m_showerHitMap, m_showerHitMap);
-    this->MergeAssociation(outputEvent.m_showerPCAxisMap, m_showerPCAxisMap);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetPFParticles, outputCollections.m_pfParticles.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetSpacePoints, outputCollections.m_spacePoints.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetClusters, outputCollections.m_clusters.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetVertices, outputCollections.m_vertices.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetTracks, outputCollections.m_tracks.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetShowers, outputCollections.m_showers.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetPCAxes, outputCollections.m_pcAxes.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetMetadata, outputCollections.m_metadata.m_collection);
+    LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetHits, outputCollections.m_hits.m_collection);
+
+    if (outputEvent.m_shouldProduceT0s)
+        LArPandoraEvent::MergeCollections(inputEvents, &LArPandoraEvent::GetT0s, outputCollections.m_t0s.m_collection);
+
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleSpacePointMap, outputCollections.m_pfParticleSpacePointMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleClusterMap, outputCollections.m_pfParticleClusterMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleVertexMap, outputCollections.m_pfParticleVertexMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleTrackMap, outputCollections.m_pfParticleTrackMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleShowerMap, outputCollections.m_pfParticleShowerMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticlePCAxisMap, outputCollections.m_pfParticlePCAxisMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleMetadataMap, outputCollections.m_pfParticleMetadataMap.m_association);
+
+    if (outputEvent.m_shouldProduceT0s)
+        LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetPFParticleT0Map, outputCollections.m_pfParticleT0Map.m_association);
+
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetSpacePointHitMap, outputCollections.m_spacePointHitMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetClusterHitMap, outputCollections.m_clusterHitMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetTrackHitMap, outputCollections.m_trackHitMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetShowerHitMap, outputCollections.m_showerHitMap.m_association);
+    LArPandoraEvent::MergeAssociations(inputEvents, &LArPandoraEvent::GetShowerPCAxisMap, outputCollections.m_showerPCAxisMap.m_association);
 
     return outputEvent;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEvent::GetCollections()
-{
-    art::Handle< std::vector< recob::PFParticle > > pfParticleHandle;
-    art::Handle< std::vector< recob::SpacePoint > > spacePointHandle;
-    art::Handle< std::vector< recob::Cluster > > clusterHandle;
-    art::Handle< std::vector< recob::Vertex > > vertexHandle;
-    art::Handle< std::vector< recob::Track > > trackHandle;
-    art::Handle< std::vector< recob::Shower > > showerHandle;
-    art::Handle< std::vector< recob::PCAxis > > pcAxisHandle;
-    art::Handle< std::vector< larpandoraobj::PFParticleMetadata > > metadataHandle;
-    art::Handle< std::vector< recob::Hit > > hitHandle;
-
-    this->GetCollection(Labels::PFParticleLabel, pfParticleHandle, m_pfParticles);
-    this->GetCollection(Labels::SpacePointLabel, spacePointHandle, m_spacePoints);
-    this->GetCollection(Labels::ClusterLabel, clusterHandle, m_clusters);
-    this->GetCollection(Labels::VertexLabel, vertexHandle, m_vertices);
-    this->GetCollection(Labels::TrackLabel, trackHandle, m_tracks);
-    this->GetCollection(Labels::ShowerLabel, showerHandle, m_showers);
-    this->GetCollection(Labels::PCAxisLabel, pcAxisHandle, m_pcAxes);
-    this->GetCollection(Labels::PFParticleMetadataLabel, metadataHandle, m_metadata);
-    this->GetCollection(Labels::HitLabel, hitHandle, m_hits);
-
-    this->GetAssociationMap(Labels::PFParticleToSpacePointLabel, pfParticleHandle, m_pfParticleSpacePointMap);
-    this->GetAssociationMap(Labels::PFParticleToClusterLabel, pfParticleHandle, m_pfParticleClusterMap);
-    this->GetAssociationMap(Labels::PFParticleToVertexLabel, pfParticleHandle, m_pfParticleVertexMap);
-    this->GetAssociationMap(Labels::PFParticleToTrackLabel, pfParticleHandle, m_pfParticleTrackMap);
-    this->GetAssociationMap(Labels::PFParticleToShowerLabel, pfParticleHandle, m_pfParticleShowerMap);
-    this->GetAssociationMap(Labels::PFParticleToPCAxisLabel, pfParticleHandle, m_pfParticlePCAxisMap);
-    this->GetAssociationMap(Labels::PFParticleToMetadataLabel, pfParticleHandle, m_pfParticleMetadataMap);
-    this->GetAssociationMap(Labels::SpacePointToHitLabel, spacePointHandle, m_spacePointHitMap);
-    this->GetAssociationMap(Labels::ClusterToHitLabel, clusterHandle, m_clusterHitMap);
-    this->GetAssociationMap(Labels::TrackToHitLabel, trackHandle, m_trackHitMap);
-    this->GetAssociationMap(Labels::ShowerToHitLabel, showerHandle, m_showerHitMap);
-    this->GetAssociationMap(Labels::ShowerToPCAxisLabel, showerHandle, m_showerPCAxisMap);
+LArPandoraEvent::LArPandoraEvent(const LArPandoraEvent &event, const std::vector<bool> &pfParticleMask) :
+    m_pProducer(event.m_pProducer),
+    m_pEvent(event.m_pEvent),
+    m_labels(event.m_labels),
+    m_shouldProduceT0s(event.m_shouldProduceT0s),
+    m_shift(event.m_shift),
+    m_pCollections(event.m_pCollections),
+    m_isFilteredView(true),
+    m_pfParticleMask(pfParticleMask)
+{
+    if (m_pfParticleMask.size() != this->GetPFParticles().size())
+        throw cet::exception("LArPandora") << " LArPandoraEvent::LArPandoraEvent -- PFParticle mask doesn't match the viewed event." << std::endl;
+}
 
-    if (m_shouldProduceT0s)
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraEvent::GetSelectedPFParticles(PFParticleVector &selectedPFParticles) const
+{
+    // ATTN a selection always holds whole hierarchies, so use the same traversal as the filters, giving the same order as an eager copy
+    PFParticleVector primaryPFParticles;
+    this->GetPrimaryPFParticles(primaryPFParticles);
+    this->GetDownstreamPFParticles(primaryPFParticles, selectedPFParticles);
+
+    if (this->IsFilteredView() && (selectedPFParticles.size() != static_cast<size_t>(std::count(m_pfParticleMask.begin(), m_pfParticleMask.end(), true))))
+        throw cet::exception("LArPandora") << " LArPandoraEvent::GetSelectedPFParticles -- PFParticle mask doesn't hold whole hierarchies." << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraEvent LArPandoraEvent::GetResolvedEvent() const
+{
+    if (!this->IsFilteredView())
+        throw cet::exception("LArPandora") << " LArPandoraEvent::GetResolvedEvent -- Only a filtered view can be resolved." << std::endl;
+
+    PFParticleVector selectedPFParticles;
+    this->GetSelectedPFParticles(selectedPFParticles);
+
+    return LArPandoraEvent(*this, selectedPFParticles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraEvent LArPandoraEvent::GetFilteredEvent(const PFParticleVector &selectedPFParticles, const bool shouldDeferCopy) const
+{
+    if (!shouldDeferCopy)
+        return LArPandoraEvent(*this, selectedPFParticles);
+
+    // ATTN a view shares the collections of this event with this event and all of its other views, so each collection is read once
+    const PFParticleVector &pfParticles(this->GetPFParticles());
+
+    PtrKeyToIndexMap pfParticleIndex;
+    this->GetPositionIndex(pfParticles, pfParticleIndex);
+
+    std::vector<bool> pfParticleMask(pfParticles.size(), false);
+
+    for (const art::Ptr<recob::PFParticle> &part : selectedPFParticles)
+    {
+        const PtrKeyToIndexMap::const_iterator iter(pfParticleIndex.find(GetPtrKey(part)));
+        if (iter == pfParticleIndex.end())
+            throw cet::exception("LArPandora") << " LArPandoraEvent::GetFilteredEvent -- Selected PFParticle is not in the viewed event." << std::endl;
+
+        pfParticleMask.at(iter->second) = true;
+    }
+
+    return LArPandoraEvent(*this, pfParticleMask);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraEvent::LoadPFParticles() const
+{
+    Collections &collections(*m_pCollections);
+
+    if (collections.m_pfParticles.m_isLoaded)
+        return;
+
+    const PFParticleVector &pfParticles(this->GetCollection(Labels::PFParticleLabel, collections.m_pfParticles));
+
+    for (const art::Ptr<recob::PFParticle> &part : pfParticles)
     {
-        art::Handle< std::vector< anab::T0 > > t0Handle;
-        this->GetCollection(Labels::T0Label, t0Handle, m_t0s);
-        this->GetAssociationMap(Labels::PFParticleToT0Label, pfParticleHandle, m_pfParticleT0Map);
+        if (!collections.m_pfParticleToOriginIdMap.insert(std::map< art::Ptr< recob::PFParticle >, unsigned int >::value_type(part, 0)).second)
+            throw cet::exception("LArPandora") << " LArPandoraEvent::LoadPFParticles -- Repeated input PFParticles!" << std::endl;
     }
 
     this->GetPFParticleHierarchy();
@@ -230,15 +390,195 @@ void LArPandoraEvent::GetCollections()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEvent::GetPFParticleHierarchy()
+const PFParticleVector &LArPandoraEvent::GetPFParticles() const
+{
+    this->LoadPFParticles();
+    return m_pCollections->m_pfParticles.m_collection;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const SpacePointVector &LArPandoraEvent::GetSpacePoints() const
+{
+    return this->GetCollection(Labels::SpacePointLabel, m_pCollections->m_spacePoints);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ClusterVector &LArPandoraEvent::GetClusters() const
+{
+    return this->GetCollection(Labels::ClusterLabel, m_pCollections->m_clusters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const VertexVector &LArPandoraEvent::GetVertices() const
+{
+    return this->GetCollection(Labels::VertexLabel, m_pCollections->m_vertices);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const TrackVector &LArPandoraEvent::GetTracks() const
 {
+    return this->GetCollection(Labels::TrackLabel, m_pCollections->m_tracks);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ShowerVector &LArPandoraEvent::GetShowers() const
+{
+    return this->GetCollection(Labels::ShowerLabel, m_pCollections->m_showers);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const T0Vector &LArPandoraEvent::GetT0s() const
+{
+    return this->GetCollection(Labels::T0Label, m_pCollections->m_t0s);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const MetadataVector &LArPandoraEvent::GetMetadata() const
+{
+    return this->GetCollection(Labels::PFParticleMetadataLabel, m_pCollections->m_metadata);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PCAxisVector &LArPandoraEvent::GetPCAxes() const
+{
+    return this->GetCollection(Labels::PCAxisLabel, m_pCollections->m_pcAxes);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const HitVector &LArPandoraEvent::GetHits() const
+{
+    return this->GetCollection(Labels::HitLabel, m_pCollections->m_hits);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToSpacePointAssociation &LArPandoraEvent::GetPFParticleSpacePointMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToSpacePointLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleSpacePointMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToClusterAssociation &LArPandoraEvent::GetPFParticleClusterMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToClusterLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleClusterMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToVertexAssociation &LArPandoraEvent::GetPFParticleVertexMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToVertexLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleVertexMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToTrackAssociation &LArPandoraEvent::GetPFParticleTrackMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToTrackLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleTrackMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToShowerAssociation &LArPandoraEvent::GetPFParticleShowerMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToShowerLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleShowerMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToT0Association &LArPandoraEvent::GetPFParticleT0Map() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToT0Label, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleT0Map);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToMetadataAssociation &LArPandoraEvent::GetPFParticleMetadataMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToMetadataLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticleMetadataMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleToPCAxisAssociation &LArPandoraEvent::GetPFParticlePCAxisMap() const
+{
+    return this->GetAssociationMap(Labels::PFParticleToPCAxisLabel, Labels::PFParticleLabel, m_pCollections->m_pfParticles, m_pCollections->m_pfParticlePCAxisMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const SpacePointToHitAssociation &LArPandoraEvent::GetSpacePointHitMap() const
+{
+    return this->GetAssociationMap(Labels::SpacePointToHitLabel, Labels::SpacePointLabel, m_pCollections->m_spacePoints, m_pCollections->m_spacePointHitMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ClusterToHitAssociation &LArPandoraEvent::GetClusterHitMap() const
+{
+    return this->GetAssociationMap(Labels::ClusterToHitLabel, Labels::ClusterLabel, m_pCollections->m_clusters, m_pCollections->m_clusterHitMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const TrackToHitAssociation &LArPandoraEvent::GetTrackHitMap() const
+{
+    return this->GetAssociationMap(Labels::TrackToHitLabel, Labels::TrackLabel, m_pCollections->m_tracks, m_pCollections->m_trackHitMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ShowerToHitAssociation &LArPandoraEvent::GetShowerHitMap() const
+{
+    return this->GetAssociationMap(Labels::ShowerToHitLabel, Labels::ShowerLabel, m_pCollections->m_showers, m_pCollections->m_showerHitMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ShowerToPCAxisAssociation &LArPandoraEvent::GetShowerPCAxisMap() const
+{
+    return this->GetAssociationMap(Labels::ShowerToPCAxisLabel, Labels::ShowerLabel, m_pCollections->m_showers, m_pCollections->m_showerPCAxisMap);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticlesToPFParticles &LArPandoraEvent::GetPFParticleDaughterMap() const
+{
+    this->LoadPFParticles();
+    return m_pCollections->m_pfParticleDaughterMap;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const std::map<art::Ptr<recob::PFParticle>, unsigned int> &LArPandoraEvent::GetPFParticleToOriginIdMap() const
+{
+    this->LoadPFParticles();
+    return m_pCollections->m_pfParticleToOriginIdMap;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraEvent::GetPFParticleHierarchy() const
+{
+    PFParticlesToPFParticles &pfParticleDaughterMap(m_pCollections->m_pfParticleDaughterMap);
+
     std::map< size_t, art::Ptr< recob::PFParticle > > idToPFParticleMap;
     this->GetIdToPFParticleMap(idToPFParticleMap);
 
-    for (const art::Ptr<recob::PFParticle> &part : m_pfParticles)
+    for (const art::Ptr<recob::PFParticle> &part : m_pCollections->m_pfParticles.m_collection)
     {
         PFParticleVector daughters;
-        if (!m_pfParticleDaughterMap.insert(PFParticlesToPFParticles::value_type(part, daughters)).second)
+        if (!pfParticleDaughterMap.insert(PFParticlesToPFParticles::value_type(part, daughters)).second)
             throw cet::exception("LArPandora") << " LArPandoraEvent::GetPFParticleHierarchy -- Repeated PFParticle in heirarchy map!" << std::endl;
 
         for (const size_t & daughterId : part->Daughters())
@@ -247,10 +587,10 @@ void LArPandoraEvent::GetPFParticleHierarchy()
                 throw cet::exception("LArPandora") << " LArPandoraEvent::GetPFParticleHierarchy -- Can't access map entry for daughter of PFParticle supplied." << std::endl;
 
             art::Ptr< recob::PFParticle > daughter = idToPFParticleMap.at(daughterId);
-            if (std::find(m_pfParticleDaughterMap[part].begin(), m_pfParticleDaughterMap[ part ].end(), daughter) != m_pfParticleDaughterMap[part].end())
+            if (std::find(pfParticleDaughterMap[part].begin(), pfParticleDaughterMap[ part ].end(), daughter) != pfParticleDaughterMap[part].end())
                 throw cet::exception("LArPandora") << " LArPandoraEvent::GetPFParticleHierarchy -- Can't have the same daughter twice!" << std::endl;
 
-            m_pfParticleDaughterMap[part].push_back(daughter);
+            pfParticleDaughterMap[part].push_back(daughter);
         }
     }
 }
@@ -259,8 +599,15 @@ void LArPandoraEvent::GetPFParticleHierarchy()
 
 void LArPandoraEvent::GetPrimaryPFParticles(PFParticleVector &primaryPFParticles) const
 {
-    for (art::Ptr< recob::PFParticle > part : m_pfParticles)
+    const PFParticleVector &pfParticles(this->GetPFParticles());
+
+    for (size_t index = 0; index < pfParticles.size(); ++index)
     {
+        if (this->IsFilteredView() && !m_pfParticleMask.at(index))
+            continue;
+
+        const art::Ptr< recob::PFParticle > &part(pfParticles.at(index));
+
         if (part->IsPrimary())
             primaryPFParticles.push_back(part);
     }
@@ -286,8 +633,7 @@ void LArPandoraEvent::GetFilteredParticlesByCRTag(const bool shouldProduceNeutri
     PFParticleVector &outputPFParticles) const
 {
 
-    art::Handle< std::vector< recob::PFParticle > > pfParticleHandle;
-    m_pEvent->getByLabel(m_labels.GetLabel(Labels::PFParticleLabel), pfParticleHandle);
+    const art::Handle< std::vector< recob::PFParticle > > &pfParticleHandle(this->GetHandle(Labels::PFParticleLabel, m_pCollections->m_pfParticles));
 
     art::FindManyP< anab::CosmicTag > pfParticleTagAssoc(pfParticleHandle, *m_pEvent, tagProducerLabel);
 
@@ -311,9 +657,12 @@ void LArPandoraEvent::GetFilteredParticlesByCRTag(const bool shouldProduceNeutri
 void LArPandoraEvent::GetFilteredHierarchyMap(const PFParticleVector &filteredParticles, const PFParticlesToPFParticles &unfilteredPFParticleDaughterMap,
     PFParticlesToPFParticles &outputPFParticleDaughterMap) const
 {
+    PtrKeySet filteredKeys;
+    GetPtrKeySet(filteredParticles, filteredKeys);
+
     for (PFParticlesToPFParticles::const_iterator it = unfilteredPFParticleDaughterMap.begin(); it != unfilteredPFParticleDaughterMap.end(); ++it)
     {
-        if (std::find(filteredParticles.begin(), filteredParticles.end(), it->first) == filteredParticles.end()) continue;
+        if (filteredKeys.find(GetPtrKey(it->first)) == filteredKeys.end()) continue;
 
         if (! outputPFParticleDaughterMap.insert(PFParticlesToPFParticles::value_type(it->first, it->second)).second)
             throw cet::exception("LArPandora") << " LArPandoraEvent::GetFilteredHierarchyMap -- Can't add multiple map entries for same PFParticle" << std::endl;
@@ -324,7 +673,7 @@ void LArPandoraEvent::GetFilteredHierarchyMap(const PFParticleVector &filteredPa
 
 void LArPandoraEvent::GetIdToPFParticleMap(std::map<size_t, art::Ptr<recob::PFParticle> > &idToPFParticleMap) const
 {
-    for (art::Ptr<recob::PFParticle> part : m_pfParticles)
+    for (art::Ptr<recob::PFParticle> part : m_pCollections->m_pfParticles.m_collection)
     {
         if (!idToPFParticleMap.insert(std::map<size_t, art::Ptr<recob::PFParticle> >::value_type(part->Self(), part)).second)
             throw cet::exception("LArPandora") << " LArPandoraEvent::GetIdToPFParticleMap -- Can't insert multiple entries with the same Id" << std::endl;
@@ -335,53 +684,64 @@ void LArPandoraEvent::GetIdToPFParticleMap(std::map<size_t, art::Ptr<recob::PFPa
 
 void LArPandoraEvent::GetDownstreamPFParticles(const PFParticleVector &inputPFParticles, PFParticleVector &downstreamPFParticles) const
 {
+    PtrKeySet downstreamKeys;
+    GetPtrKeySet(downstreamPFParticles, downstreamKeys);
+
     for (art::Ptr<recob::PFParticle> part : inputPFParticles)
-        this->GetDownstreamPFParticles(part, downstreamPFParticles);
+        this->GetDownstreamPFParticles(part, downstreamPFParticles, downstreamKeys);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEvent::GetDownstreamPFParticles(const art::Ptr<recob::PFParticle> &part, PFParticleVector &downstreamPFParticles) const
+void LArPandoraEvent::GetDownstreamPFParticles(const art::Ptr<recob::PFParticle> &part, PFParticleVector &downstreamPFParticles, PtrKeySet &downstreamKeys) const
 {
-    if (m_pfParticleDaughterMap.find(part) == m_pfParticleDaughterMap.end())
+    const PFParticlesToPFParticles &pfParticleDaughterMap(this->GetPFParticleDaughterMap());
+
+    if (pfParticleDaughterMap.find(part) == pfParticleDaughterMap.end())
         throw cet::exception("LArPandora") << " LArPandoraEvent::GetDownstreamPFParticles -- Could not find PFParticle in the hierarchy map" << std::endl;
 
-    if (std::find(downstreamPFParticles.begin(), downstreamPFParticles.end(), part) == downstreamPFParticles.end())
+    if (downstreamKeys.insert(GetPtrKey(part)).second)
         downstreamPFParticles.push_back(part);
 
-    for (const art::Ptr< recob::PFParticle > & daughter : m_pfParticleDaughterMap.at(part))
-        this->GetDownstreamPFParticles(daughter, downstreamPFParticles);
+    for (const art::Ptr< recob::PFParticle > & daughter : pfParticleDaughterMap.at(part))
+        this->GetDownstreamPFParticles(daughter, downstreamPFParticles, downstreamKeys);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void LArPandoraEvent::FillPFParticleToOriginIdMap(const std::map<art::Ptr<recob::PFParticle>, unsigned int> &existingMap)
 {
-    for (const art::Ptr< recob::PFParticle > & part : m_pfParticles)
+    for (const art::Ptr< recob::PFParticle > & part : m_pCollections->m_pfParticles.m_collection)
     {
         if (existingMap.find(part) == existingMap.end())
             throw cet::exception("LArPandora") << " LArPandoraEvent::FillPFParticleToOriginIdMap -- Can't access map entry for PFParticle supplied." << std::endl;
 
-        if (!m_pfParticleToOriginIdMap.insert(std::map< art::Ptr< recob::PFParticle >, unsigned int >::value_type(part, existingMap.at(part))).second)
+        if (!m_pCollections->m_pfParticleToOriginIdMap.insert(std::map< art::Ptr< recob::PFParticle >, unsigned int >::value_type(part, existingMap.at(part))).second)
             throw cet::exception("LArPandora") << " LArPandoraEvent::FillPFParticleToOriginIdMap -- Can't add multiple map entries for same PFParticle" << std::endl;
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEvent::MergePFParticleToOriginIdMap(std::map<art::Ptr<recob::PFParticle>, unsigned int> &mapToMerge,
-    const std::map<art::Ptr<recob::PFParticle>, unsigned int> &mapToAdd) const
+void LArPandoraEvent::MergePFParticleToOriginIdMaps(const std::vector<const LArPandoraEvent *> &events,
+    std::map<art::Ptr<recob::PFParticle>, unsigned int> &mergedMap)
 {
-    unsigned int maxID = 0;
-    if (mapToMerge.size() != 0)
-    {
-        maxID = std::max_element(mapToMerge.begin(), mapToMerge.end(), [](const std::pair<art::Ptr<recob::PFParticle>, unsigned int> &p1, const std::pair< art::Ptr<recob::PFParticle>, unsigned int> &p2) {return p1.second < p2.second;})->second;
-    }
+    // ATTN the origin IDs of each event are shifted past the largest origin ID merged so far, matching a chain of pairwise merges
+    unsigned int maxID(0);
 
-    for (std::map< art::Ptr< recob::PFParticle >, unsigned int >::const_iterator it=mapToAdd.begin(); it != mapToAdd.end(); ++it)
+    for (size_t eventIndex = 0; eventIndex < events.size(); ++eventIndex)
     {
-        if (!mapToMerge.insert(std::map< art::Ptr<recob::PFParticle>, unsigned int>::value_type(it->first, it->second + maxID + 1)).second)
-            throw cet::exception("LArPandora") << " LArPandoraEvent::MergePFParticleToOriginIdMap - Can't merge collections containing repeated PFParticles." << std::endl;
+        const unsigned int offset((eventIndex == 0) ? 0 : maxID + 1);
+
+        for (const std::map< art::Ptr< recob::PFParticle >, unsigned int >::value_type &entry : events.at(eventIndex)->GetPFParticleToOriginIdMap())
+        {
+            const unsigned int originId(entry.second + offset);
+
+            if (!mergedMap.insert(std::map< art::Ptr<recob::PFParticle>, unsigned int>::value_type(entry.first, originId)).second)
+                throw cet::exception("LArPandora") << " LArPandoraEvent::MergePFParticleToOriginIdMaps - Can't merge collections containing repeated PFParticles." << std::endl;
+
+            maxID = std::max(maxID, originId);
+        }
     }
 }
 
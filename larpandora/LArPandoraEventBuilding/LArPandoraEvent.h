@@ -24,11 +24,17 @@
 
 #include "lardataobj/AnalysisBase/T0.h"
 
+#include "larpandora/LArPandoraInterface/CompressedAssociation.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
+#include "larpandora/LArPandoraEventBuilding/LArPandoraEventSelection.h"
+
 #include <memory>
 #include <algorithm>
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace lar_pandora
 {
@@ -42,6 +48,51 @@ typedef std::map< art::Ptr<recob::PFParticle>, std::vector< art::Ptr<recob::PFPa
 typedef std::map< art::Ptr<recob::Shower>, std::vector< art::Ptr<recob::PCAxis> > >         ShowersToPCAxes;
 typedef std::map< art::Ptr<recob::SpacePoint>, std::vector< art::Ptr<recob::Hit> > >        SpacePointsToHitVector;
 
+typedef CompressedAssociation<recob::PFParticle, recob::SpacePoint>                 PFParticleToSpacePointAssociation;
+typedef CompressedAssociation<recob::PFParticle, recob::Cluster>                    PFParticleToClusterAssociation;
+typedef CompressedAssociation<recob::PFParticle, recob::Vertex>                     PFParticleToVertexAssociation;
+typedef CompressedAssociation<recob::PFParticle, recob::Track>                      PFParticleToTrackAssociation;
+typedef CompressedAssociation<recob::PFParticle, recob::Shower>                     PFParticleToShowerAssociation;
+typedef CompressedAssociation<recob::PFParticle, anab::T0>                          PFParticleToT0Association;
+typedef CompressedAssociation<recob::PFParticle, larpandoraobj::PFParticleMetadata> PFParticleToMetadataAssociation;
+typedef CompressedAssociation<recob::PFParticle, recob::PCAxis>                     PFParticleToPCAxisAssociation;
+typedef CompressedAssociation<recob::SpacePoint, recob::Hit>                        SpacePointToHitAssociation;
+typedef CompressedAssociation<recob::Cluster, recob::Hit>                           ClusterToHitAssociation;
+typedef CompressedAssociation<recob::Track, recob::Hit>                             TrackToHitAssociation;
+typedef CompressedAssociation<recob::Shower, recob::Hit>                            ShowerToHitAssociation;
+typedef CompressedAssociation<recob::Shower, recob::PCAxis>                         ShowerToPCAxisAssociation;
+
+typedef std::pair<art::ProductID, std::size_t> PtrKey;
+
+/**
+ *  @brief  Hash for the (product id, key) pair identifying an art::Ptr
+ */
+class PtrKeyHash
+{
+public:
+    std::size_t operator()(const PtrKey &ptrKey) const;
+};
+
+typedef std::unordered_map<PtrKey, size_t, PtrKeyHash> PtrKeyToIndexMap;
+typedef std::unordered_set<PtrKey, PtrKeyHash> PtrKeySet;
+
+/**
+ *  @brief  Get the (product id, key) pair identifying an art::Ptr
+ *
+ *  @param  ptr the input art::Ptr
+ */
+template <typename T>
+PtrKey GetPtrKey(const art::Ptr<T> &ptr);
+
+/**
+ *  @brief  Get the set of (product id, key) pairs identifying the objects in a collection
+ *
+ *  @param  collection the input collection
+ *  @param  ptrKeySet the output set of (product id, key) pairs
+ */
+template <typename T>
+void GetPtrKeySet(const std::vector<art::Ptr<T> > &collection, PtrKeySet &ptrKeySet);
+
 /**
  *  @brief LArPandoraEvent class
  */
@@ -142,7 +193,7 @@ public:
      *  @brief  Construct by copying an existing LArPandoraEvent, replacing the collections and associations
      *          by any objects associated with a PFParticle in the selection supplied.
      *
-     *  @param  event input event to copy and filter
+     *  @param  event input event to copy and filter, for a filtered view the selection is made from the collections of the viewed event
      *  @param  pfParticleVector input vector of selected particles
      */
     LArPandoraEvent(const LArPandoraEvent &event, const PFParticleVector &selectedPFParticles);
@@ -152,8 +203,9 @@ public:
      *          is a neutrino (non-neutrino) if shouldProduceNeutrinos is set to true (false)
      *
      *  @param  shouldProduceNeutrinos if the returned event should contain neutrinos (or non-neutrinos)
+     *  @param  shouldDeferCopy if the returned event should be a filtered view of this event, copied only when written or merged
      */
-    LArPandoraEvent FilterByPdgCode(const bool shouldProduceNeutrinos) const;
+    LArPandoraEvent FilterByPdgCode(const bool shouldProduceNeutrinos, const bool shouldDeferCopy = false) const;
 
     /**
      *  @brief  Produce a copy of the event keeping only the collections that are associated with a top-level particle that is not
@@ -161,8 +213,9 @@ public:
      *
      *  @param  shouldProduceNeutrinos if the returned event should contain neutrinos (or non-neutrinos)
      *  @param  tagProducerLabel label for the producer of the CRTags
+     *  @param  shouldDeferCopy if the returned event should be a filtered view of this event, copied only when written or merged
      */
-    LArPandoraEvent FilterByCRTag(const bool shouldProduceNeutrinos, const std::string &tagProducerLabel) const;
+    LArPandoraEvent FilterByCRTag(const bool shouldProduceNeutrinos, const std::string &tagProducerLabel, const bool shouldDeferCopy = false) const;
 
     /**
      *  @brief  Write (put) the collections in this LArPandoraEvent to the art::Event
@@ -170,10 +223,33 @@ public:
     void WriteToEvent() const;
 
     /**
-     *  @brief  Merge collections from two events into one
+     *  @brief  Write (put) only a reference to the selected objects to the art::Event, in place of copies of the collections, to be read
+     *          using LArPandoraEventSelection. The collections of the original producers must also be kept in the output.
+     *
+     *  @param  selectionLabel the instance name prefix of the selection products
+     */
+    void WriteSelectionToEvent(const std::string &selectionLabel) const;
+
+    /**
+     *  @brief  Merge collections from two events into one, the collections of the other event come first
+     *
+     *  @param  other the event to merge with this event
      */
     LArPandoraEvent Merge(const LArPandoraEvent &other) const;
 
+    /**
+     *  @brief  Merge collections from any number of events into one. The output sizes and PFParticle origin IDs are found in a single
+     *          pass over the events, and each output collection and association is then filled once, in the order of the input events
+     *
+     *  @param  events the events to merge
+     */
+    static LArPandoraEvent Merge(const std::vector<const LArPandoraEvent *> &events);
+
+    /**
+     *  @brief  Whether this event is a filtered view of another event, holding a PFParticle selection mask rather than its own collections
+     */
+    bool IsFilteredView() const;
+
 private:
     /**
      *  @brief pdg enumeration
@@ -186,35 +262,181 @@ private:
     };
 
     /**
-     *  @brief  Get the collections and associations from m_pEvent with the required labels
+     *  @brief  A collection read from the art::Event when first needed
      */
-    void GetCollections();
+    template <typename T>
+    class InputCollection
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        InputCollection();
+
+        bool                            m_isLoaded;         ///<  Whether the collection has been filled
+        art::Handle<std::vector<T> >    m_handle;           ///<  The handle to the collection in the art::Event, fetched when first needed
+        std::vector<art::Ptr<T> >       m_collection;       ///<  The collection
+    };
 
     /**
-     *  @brief  Gets a given collection from m_pEvent with the label supplied
+     *  @brief  An association read from the art::Event when first needed
+     */
+    template <typename T, typename U>
+    class InputAssociation
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        InputAssociation();
+
+        bool                            m_isLoaded;         ///<  Whether the association has been filled
+        CompressedAssociation<T, U>     m_association;      ///<  The association, row i holds the objects associated with the i-th object of the source collection
+    };
+
+    /**
+     *  @brief  The collections and associations of an event. They are shared by the event, its copies and its filtered views, so each is
+     *          read from the art::Event at most once however many views are taken, and only if a filter, merge or write uses it
+     */
+    class Collections
+    {
+    public:
+        /**
+         *  @brief  Mark all collections and associations as filled, for an event holding objects selected or merged in memory
+         */
+        void SetFilled();
+
+        std::map<art::Ptr<recob::PFParticle>, unsigned int>  m_pfParticleToOriginIdMap;  ///< Mapping between PFParticles, and an ID for the LArPandoraEvent from which they originated (to keep track of merges)
+
+        InputCollection<recob::PFParticle>                      m_pfParticles;  ///<  The input collection of PFParticles, loaded with the origin IDs and hierarchy
+        InputCollection<recob::SpacePoint>                      m_spacePoints;  ///<  The input collection of SpacePoints
+        InputCollection<recob::Cluster>                         m_clusters;     ///<  The input collection of Clusters
+        InputCollection<recob::Vertex>                          m_vertices;     ///<  The input collection of Vertices
+        InputCollection<recob::Track>                           m_tracks;       ///<  The input collection of Tracks
+        InputCollection<recob::Shower>                          m_showers;      ///<  The input collection of Showers
+        InputCollection<anab::T0>                               m_t0s;          ///<  The input collection of T0s
+        InputCollection<larpandoraobj::PFParticleMetadata>      m_metadata;     ///<  The input collection of PFParticle metadata
+        InputCollection<recob::PCAxis>                          m_pcAxes;       ///<  The input collection of PCAxes
+        InputCollection<recob::Hit>                             m_hits;         ///<  The input collection of Hits
+
+        InputAssociation<recob::PFParticle, recob::SpacePoint>                  m_pfParticleSpacePointMap;  ///<  The input associations: PFParticle -> SpacePoint
+        InputAssociation<recob::PFParticle, recob::Cluster>                     m_pfParticleClusterMap;     ///<  The input associations: PFParticle -> Cluster
+        InputAssociation<recob::PFParticle, recob::Vertex>                      m_pfParticleVertexMap;      ///<  The input associations: PFParticle -> Vertex
+        InputAssociation<recob::PFParticle, recob::Track>                       m_pfParticleTrackMap;       ///<  The input associations: PFParticle -> Track
+        InputAssociation<recob::PFParticle, recob::Shower>                      m_pfParticleShowerMap;      ///<  The input associations: PFParticle -> Shower
+        InputAssociation<recob::PFParticle, anab::T0>                           m_pfParticleT0Map;          ///<  The input associations: PFParticle -> T0
+        InputAssociation<recob::PFParticle, larpandoraobj::PFParticleMetadata>  m_pfParticleMetadataMap;    ///<  The input associations: PFParticle -> Metadata
+        InputAssociation<recob::PFParticle, recob::PCAxis>                      m_pfParticlePCAxisMap;      ///<  The input associations: PFParticle -> PCAxis
+
+        InputAssociation<recob::SpacePoint, recob::Hit>                         m_spacePointHitMap;         ///<  The input associations: SpacePoint -> Hit
+        InputAssociation<recob::Cluster, recob::Hit>                            m_clusterHitMap;            ///<  The input associations: Cluster -> Hit
+        InputAssociation<recob::Track, recob::Hit>                              m_trackHitMap;              ///<  The input associations: Track -> Hit
+        InputAssociation<recob::Shower, recob::Hit>                             m_showerHitMap;             ///<  The input associations: Shower -> Hit
+
+        InputAssociation<recob::Shower, recob::PCAxis>                          m_showerPCAxisMap;          ///<  The input associations: PCAxis -> Shower
+
+        PFParticlesToPFParticles                    m_pfParticleDaughterMap;      ///<  The mapping from parent to daughter PFParticles
+    };
+
+    /**
+     *  @brief  Construct a filtered view of an existing LArPandoraEvent, sharing its collections
+     *
+     *  @param  event the event to view, or another filtered view of the same event
+     *  @param  pfParticleMask whether each PFParticle of the viewed event is selected
+     */
+    LArPandoraEvent(const LArPandoraEvent &event, const std::vector<bool> &pfParticleMask);
+
+    /**
+     *  @brief  Get the collections and associations, each loaded from m_pEvent when first needed. For a filtered view these are the
+     *          collections of the viewed event
+     */
+    const PFParticleVector &GetPFParticles() const;
+    const SpacePointVector &GetSpacePoints() const;
+    const ClusterVector &GetClusters() const;
+    const VertexVector &GetVertices() const;
+    const TrackVector &GetTracks() const;
+    const ShowerVector &GetShowers() const;
+    const T0Vector &GetT0s() const;
+    const MetadataVector &GetMetadata() const;
+    const PCAxisVector &GetPCAxes() const;
+    const HitVector &GetHits() const;
+
+    const PFParticleToSpacePointAssociation &GetPFParticleSpacePointMap() const;
+    const PFParticleToClusterAssociation &GetPFParticleClusterMap() const;
+    const PFParticleToVertexAssociation &GetPFParticleVertexMap() const;
+    const PFParticleToTrackAssociation &GetPFParticleTrackMap() const;
+    const PFParticleToShowerAssociation &GetPFParticleShowerMap() const;
+    const PFParticleToT0Association &GetPFParticleT0Map() const;
+    const PFParticleToMetadataAssociation &GetPFParticleMetadataMap() const;
+    const PFParticleToPCAxisAssociation &GetPFParticlePCAxisMap() const;
+    const SpacePointToHitAssociation &GetSpacePointHitMap() const;
+    const ClusterToHitAssociation &GetClusterHitMap() const;
+    const TrackToHitAssociation &GetTrackHitMap() const;
+    const ShowerToHitAssociation &GetShowerHitMap() const;
+    const ShowerToPCAxisAssociation &GetShowerPCAxisMap() const;
+
+    const PFParticlesToPFParticles &GetPFParticleDaughterMap() const;
+    const std::map<art::Ptr<recob::PFParticle>, unsigned int> &GetPFParticleToOriginIdMap() const;
+
+    /**
+     *  @brief  Get the selected PFParticles of a filtered view, in the same depth-first hierarchy order as an eager copy
+     *
+     *  @param  selectedPFParticles output vector of selected PFParticles
+     */
+    void GetSelectedPFParticles(PFParticleVector &selectedPFParticles) const;
+
+    /**
+     *  @brief  Copy the selected objects of a filtered view into a new LArPandoraEvent
+     */
+    LArPandoraEvent GetResolvedEvent() const;
+
+    /**
+     *  @brief  Produce the event holding only the objects associated with the selected PFParticles
+     *
+     *  @param  selectedPFParticles the selected PFParticles, all held by this event, or by the viewed event for a filtered view
+     *  @param  shouldDeferCopy if a filtered view should be returned rather than a copy
+     */
+    LArPandoraEvent GetFilteredEvent(const PFParticleVector &selectedPFParticles, const bool shouldDeferCopy) const;
+
+    /**
+     *  @brief  Load the PFParticles and their hierarchy from m_pEvent, if not yet loaded
+     */
+    void LoadPFParticles() const;
+
+    /**
+     *  @brief  Get the handle to a collection in m_pEvent with the label supplied, fetching it if not yet fetched
      *
      *  @param  inputLabel a label for the producer of the collection required
-     *  @param  outputHandle the output art Handle to required collection
-     *  @param  outputCollection the required collection
+     *  @param  inputCollection the collection
      */
     template <typename T>
-    void GetCollection(const Labels::LabelType &inputLabel, art::Handle<std::vector<T> > &outputHandle, std::vector<art::Ptr<T> > &outputCollection) const;
+    const art::Handle<std::vector<T> > &GetHandle(const Labels::LabelType &inputLabel, InputCollection<T> &inputCollection) const;
 
     /**
-     *  @brief  Get the mapping between two collections using the specified label
+     *  @brief  Get a collection, reading it from m_pEvent with the label supplied if not yet loaded
+     *
+     *  @param  inputLabel a label for the producer of the collection required
+     *  @param  inputCollection the collection
+     */
+    template <typename T>
+    const std::vector<art::Ptr<T> > &GetCollection(const Labels::LabelType &inputLabel, InputCollection<T> &inputCollection) const;
+
+    /**
+     *  @brief  Get the mapping between two collections, reading it from m_pEvent with the label supplied if not yet loaded
      *
      *  @param  inputLabel a label for the producer of the association required
-     *  @param  inputHandleT the input art Handle to the first collection
-     *  @param  outputAssociationMap output mapping between the two data types supplied (T -> U)
+     *  @param  inputLabelT a label for the producer of the first collection
+     *  @param  inputCollectionT the first collection, whose handle is only fetched if the association is read
+     *  @param  inputAssociation the association between the two data types supplied (T -> U), with a row for each object in the first collection
      */
     template <typename T, typename U>
-    void GetAssociationMap(const Labels::LabelType &inputLabel, art::Handle<std::vector<T> > &inputHandleT,
-        std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &outputAssociationMap) const;
+    const CompressedAssociation<T, U> &GetAssociationMap(const Labels::LabelType &inputLabel, const Labels::LabelType &inputLabelT,
+        InputCollection<T> &inputCollectionT, InputAssociation<T, U> &inputAssociation) const;
 
     /**
      *  @brief  Get the mapping from PFParticles to their daughters
      */
-    void GetPFParticleHierarchy();
+    void GetPFParticleHierarchy() const;
 
     /**
      *  @brief  Filters primary PFParticles from the m_pfParticles
@@ -273,8 +495,9 @@ private:
      *
      *  @param  part input PFParticles
      *  @param  downstreamPFParticles output vector of PFParticles downstream of part
+     *  @param  downstreamKeys the set of (product id, key) pairs of the PFParticles in downstreamPFParticles
      */
-    void GetDownstreamPFParticles(const art::Ptr<recob::PFParticle> &part, PFParticleVector &downstreamPFParticles) const;
+    void GetDownstreamPFParticles(const art::Ptr<recob::PFParticle> &part, PFParticleVector &downstreamPFParticles, PtrKeySet &downstreamKeys) const;
 
     /**
      *  @brief  Fills the PFParticleToOriginIdMap using an existing map from another LArPandoraEvent
@@ -287,205 +510,315 @@ private:
      *  @brief  Collects all objects of type U associated to a given object of type T
      *
      *  @param  anObject an input object of type T with which we want to collect associated objects of type U
+     *  @param  positionIndexT the positions of the objects of type T in the source collection of associationTtoU
      *  @param  associationTtoU the general input association between objects of type U and T
      *  @param  associatedU output vector of objects of type U associated with anObject
      */
     template <typename T, typename U>
-    void CollectAssociated(const art::Ptr<T> &anObject, const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationTtoU,
+    void CollectAssociated(const art::Ptr<T> &anObject, const PtrKeyToIndexMap &positionIndexT, const CompressedAssociation<T, U> &associationTtoU,
         std::vector<art::Ptr<U> > &associatedU) const;
 
     /**
      *   @brief  Gets the mapping between two filtered collections
      *
      *   @param  collectionT a first filtered collection
-     *   @param  collectionU a second filtered collection
+     *   @param  keysU the set of (product id, key) pairs of the objects in a second filtered collection
+     *   @param  positionIndexT the positions of the objects of type T in the unfiltered collection
      *   @param  inputAssociationTtoU mapping between the two unfiltered collections
-     *   @param  outputAssociationTtoU mapping between the two filtered collections
-     *
-     *   @return mapping between the filtered collections
+     *   @param  outputAssociationTtoU mapping between the two filtered collections, with a row for each object in collectionT
      */
     template <typename T, typename U>
-    void GetFilteredAssociationMap(const std::vector<art::Ptr<T> > &collectionT, const std::vector<art::Ptr<U> > &collectionU,
-        const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &inputAssociationTtoU, std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &outputAssociationTtoU) const;
+    void GetFilteredAssociationMap(const std::vector<art::Ptr<T> > &collectionT, const PtrKeySet &keysU, const PtrKeyToIndexMap &positionIndexT,
+        const CompressedAssociation<T, U> &inputAssociationTtoU, CompressedAssociation<T, U> &outputAssociationTtoU) const;
 
     /**
      *  @brief  Write a given collection to the event
      *
      *  @param  collection the collection to write
+     *  @param  positionIndex output mapping from each input object to its position in the written collection
      */
     template <typename T>
-    void WriteCollection(const std::vector<art::Ptr<T> > &collection) const;
+    void WriteCollection(const std::vector<art::Ptr<T> > &collection, PtrKeyToIndexMap &positionIndex) const;
+
+    /**
+     *  @brief  Write Ptrs to the objects in a given collection to the event
+     *
+     *  @param  collection the collection to reference
+     *  @param  selectionLabel the instance name prefix of the selection products
+     *  @param  selectionCollection the collection type
+     */
+    template <typename T>
+    void WriteSelection(const std::vector<art::Ptr<T> > &collection, const std::string &selectionLabel,
+        const LArPandoraEventSelection::SelectionCollection selectionCollection) const;
+
+    /**
+     *  @brief  Fill the mapping from each object in a collection to its position in the written collection
+     *
+     *  @param  collection the collection to write
+     *  @param  positionIndex output mapping from each input object to its position in the written collection
+     */
+    template <typename T>
+    void GetPositionIndex(const std::vector<art::Ptr<T> > &collection, PtrKeyToIndexMap &positionIndex) const;
 
     /**
      *  @brief  Write a given association to the event
      *
-     *  @param  associationMap the association to write from objects of type T -> U
+     *  @param  association the association to write from objects of type T -> U
      *  @param  collectionT the collection of type T that has been written
-     *  @param  collectionU the collection of type U that has been written
+     *  @param  positionIndexU the positions of the objects of type U in the collection that has been written (unused if !thisProducesU)
      *  @param  thisProducesU will this producer produce collectionU of was it produced by a different module?
      */
     template <typename T, typename U>
-    void WriteAssociation(const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationMap, const std::vector<art::Ptr<T> > &collectionT,
-        const std::vector<art::Ptr<U> > &collectionU, const bool thisProducesU = true) const;
+    void WriteAssociation(const CompressedAssociation<T, U> &association, const std::vector<art::Ptr<T> > &collectionT,
+        const PtrKeyToIndexMap &positionIndexU, const bool thisProducesU = true) const;
 
     /**
-     *  @brief  Merge two PFParticle to origin ID maps ensuring no ID collisions
+     *  @brief  Fill a PFParticle to origin ID map for a merge, shifting the origin IDs of each event past those of the events before it
      *
-     *  @param  mapToMerge the map to accept the merge
-     *  @param  mapToAdd the map to append to the map to merge
+     *  @param  events the events to merge
+     *  @param  mergedMap the output merged map
      */
-    void MergePFParticleToOriginIdMap(std::map<art::Ptr<recob::PFParticle>, unsigned int> &mapToMerge, const std::map<art::Ptr<recob::PFParticle>,
-        unsigned int> &mapToAdd) const;
+    static void MergePFParticleToOriginIdMaps(const std::vector<const LArPandoraEvent *> &events, std::map<art::Ptr<recob::PFParticle>,
+        unsigned int> &mergedMap);
 
     /**
-     *  @brief  Append a collection onto an other collection
+     *  @brief  Fill a merged collection from the same collection of each event, reserving the total size up front
      *
-     *  @param  collectionToMerge the collection to accept
-     *  @param  collection the collection to append
+     *  @param  events the events to merge
+     *  @param  pGetCollection the accessor for the collection in each event
+     *  @param  mergedCollection the output merged collection
      */
     template <typename T>
-    void MergeCollection(std::vector<art::Ptr<T> > &collectionToMerge, const std::vector<art::Ptr<T> > &collection) const;
+    static void MergeCollections(const std::vector<const LArPandoraEvent *> &events,
+        const std::vector<art::Ptr<T> > &(LArPandoraEvent::*const pGetCollection)() const, std::vector<art::Ptr<T> > &mergedCollection);
 
     /**
-     *  @brief  Append an association to another association
+     *  @brief  Fill a merged association from the same association of each event, reserving the total size up front
      *
-     *  @param  associationToMerge the association to accept
-     *  @param  association the association to append
+     *  @param  events the events to merge
+     *  @param  pGetAssociation the accessor for the association in each event
+     *  @param  mergedAssociation the output merged association
      */
     template <typename T, typename U>
-    void MergeAssociation(std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationToMerge, const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &association) const;
+    static void MergeAssociations(const std::vector<const LArPandoraEvent *> &events,
+        const CompressedAssociation<T, U> &(LArPandoraEvent::*const pGetAssociation)() const, CompressedAssociation<T, U> &mergedAssociation);
 
     art::EDProducer            *m_pProducer;                    ///<  The producer which should write the output collections and associations
     art::Event                 *m_pEvent;                       ///<  The event to consider
     Labels                      m_labels;                       ///<  A set of labels describing the producers for each input collection
 
-    std::map<art::Ptr<recob::PFParticle>, unsigned int>  m_pfParticleToOriginIdMap;  ///< Mapping between PFParticles, and an ID for the LArPandoraEvent from which they originated (to keep track of merges)
-
     bool                        m_shouldProduceT0s;             ///<  If T0s should be produced (usually only true for use cases with multiple drift volumes)
     const size_t                m_shift;                        ///<  Amount by which to shift PFParticle IDs when merging two reconstructions of the same event
 
-    // Collections
-    PFParticleVector            m_pfParticles;                  ///<  The input collection of PFParticles
-    SpacePointVector            m_spacePoints;                  ///<  The input collection of SpacePoints
-    ClusterVector               m_clusters;                     ///<  The input collection of Clusters
-    VertexVector                m_vertices;                     ///<  The input collection of Vertices
-    TrackVector                 m_tracks;                       ///<  The input collection of Tracks
-    ShowerVector                m_showers;                      ///<  The input collection of Showers
-    T0Vector                    m_t0s;                          ///<  The input collection of T0s
-    MetadataVector              m_metadata;                     ///<  The input collection of PFParticle metadata
-    PCAxisVector                m_pcAxes;                       ///<  The input collection of PCAxes
-    HitVector                   m_hits;                         ///<  The input collection of Hits
-
-    // Association maps
-    PFParticlesToSpacePoints    m_pfParticleSpacePointMap;      ///<  The input associations: PFParticle -> SpacePoint
-    PFParticlesToClusters       m_pfParticleClusterMap;         ///<  The input associations: PFParticle -> Cluster
-    PFParticlesToVertices       m_pfParticleVertexMap;          ///<  The input associations: PFParticle -> Vertex
-    PFParticlesToTracks         m_pfParticleTrackMap;           ///<  The input associations: PFParticle -> Track
-    PFParticlesToShowers        m_pfParticleShowerMap;          ///<  The input associations: PFParticle -> Shower
-    PFParticlesToT0s            m_pfParticleT0Map;              ///<  The input associations: PFParticle -> T0
-    PFParticlesToMetadata       m_pfParticleMetadataMap;        ///<  The input associations: PFParticle -> Metadata
-    PFParticlesToPCAxes         m_pfParticlePCAxisMap;          ///<  The input associations: PFParticle -> PCAxis
-
-    SpacePointsToHitVector      m_spacePointHitMap;             ///<  The input associations: SpacePoint -> Hit
-    ClustersToHits              m_clusterHitMap;                ///<  The input associations: Cluster -> Hit
-    TracksToHits                m_trackHitMap;                  ///<  The input associations: Track -> Hit
-    ShowersToHits               m_showerHitMap;                 ///<  The input associations: Shower -> Hit
-
-    ShowersToPCAxes             m_showerPCAxisMap;              ///<  The input associations: PCAxis -> Shower
-
-    PFParticlesToPFParticles    m_pfParticleDaughterMap;        ///<  The mapping from parent to daughter PFParticles
+    std::shared_ptr<Collections>    m_pCollections;             ///<  The collections and associations, shared with any copies and filtered views of this event
+
+    // Filtered view
+    bool                        m_isFilteredView;               ///<  Whether this event is a filtered view of the event holding m_pCollections
+    std::vector<bool>           m_pfParticleMask;               ///<  Whether each PFParticle of m_pCollections is selected, if this is a filtered view
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+inline std::size_t PtrKeyHash::operator()(const PtrKey &ptrKey) const
+{
+    return std::hash<std::size_t>()((static_cast<std::size_t>(ptrKey.first.value()) << 32) ^ ptrKey.second);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline PtrKey GetPtrKey(const art::Ptr<T> &ptr)
+{
+    return PtrKey(ptr.id(), ptr.key());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void GetPtrKeySet(const std::vector<art::Ptr<T> > &collection, PtrKeySet &ptrKeySet)
+{
+    ptrKeySet.reserve(ptrKeySet.size() + collection.size());
+
+    for (const art::Ptr<T> &object : collection)
+        (void) ptrKeySet.insert(GetPtrKey(object));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArPandoraEvent::IsFilteredView() const
+{
+    return m_isFilteredView;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline LArPandoraEvent::InputCollection<T>::InputCollection() :
+    m_isLoaded(false)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline LArPandoraEvent::InputAssociation<T, U>::InputAssociation() :
+    m_isLoaded(false)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void LArPandoraEvent::Collections::SetFilled()
+{
+    m_pfParticles.m_isLoaded = true;
+    m_spacePoints.m_isLoaded = true;
+    m_clusters.m_isLoaded = true;
+    m_vertices.m_isLoaded = true;
+    m_tracks.m_isLoaded = true;
+    m_showers.m_isLoaded = true;
+    m_t0s.m_isLoaded = true;
+    m_metadata.m_isLoaded = true;
+    m_pcAxes.m_isLoaded = true;
+    m_hits.m_isLoaded = true;
+
+    m_pfParticleSpacePointMap.m_isLoaded = true;
+    m_pfParticleClusterMap.m_isLoaded = true;
+    m_pfParticleVertexMap.m_isLoaded = true;
+    m_pfParticleTrackMap.m_isLoaded = true;
+    m_pfParticleShowerMap.m_isLoaded = true;
+    m_pfParticleT0Map.m_isLoaded = true;
+    m_pfParticleMetadataMap.m_isLoaded = true;
+    m_pfParticlePCAxisMap.m_isLoaded = true;
+    m_spacePointHitMap.m_isLoaded = true;
+    m_clusterHitMap.m_isLoaded = true;
+    m_trackHitMap.m_isLoaded = true;
+    m_showerHitMap.m_isLoaded = true;
+    m_showerPCAxisMap.m_isLoaded = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline const art::Handle<std::vector<T> > &LArPandoraEvent::GetHandle(const Labels::LabelType &inputLabel, InputCollection<T> &inputCollection) const
+{
+    if (!inputCollection.m_handle.isValid())
+        m_pEvent->getByLabel(m_labels.GetLabel(inputLabel), inputCollection.m_handle);
+
+    return inputCollection.m_handle;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
-inline void LArPandoraEvent::GetCollection(const Labels::LabelType &inputLabel, art::Handle<std::vector<T> > &outputHandle, std::vector<art::Ptr<T> > &outputCollection) const
+inline const std::vector<art::Ptr<T> > &LArPandoraEvent::GetCollection(const Labels::LabelType &inputLabel, InputCollection<T> &inputCollection) const
 {
-    m_pEvent->getByLabel(m_labels.GetLabel(inputLabel), outputHandle);
+    if (inputCollection.m_isLoaded)
+        return inputCollection.m_collection;
+
+    const art::Handle<std::vector<T> > &outputHandle(this->GetHandle(inputLabel, inputCollection));
+    inputCollection.m_collection.reserve(outputHandle->size());
 
     for (unsigned int i = 0; i != outputHandle->size(); i++)
     {
         art::Ptr< T > object(outputHandle, i);
-        outputCollection.push_back(object);
+        inputCollection.m_collection.push_back(object);
     }
+
+    inputCollection.m_isLoaded = true;
+    return inputCollection.m_collection;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T, typename U>
-inline void LArPandoraEvent::GetAssociationMap(const Labels::LabelType &inputLabel, art::Handle<std::vector<T> > &inputHandleT,
-    std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &outputAssociationMap) const
+inline const CompressedAssociation<T, U> &LArPandoraEvent::GetAssociationMap(const Labels::LabelType &inputLabel, const Labels::LabelType &inputLabelT,
+    InputCollection<T> &inputCollectionT, InputAssociation<T, U> &inputAssociation) const
 {
+    if (inputAssociation.m_isLoaded)
+        return inputAssociation.m_association;
+
+    const art::Handle<std::vector<T> > &inputHandleT(this->GetHandle(inputLabelT, inputCollectionT));
     art::FindManyP< U > assoc(inputHandleT, (*m_pEvent), m_labels.GetLabel(inputLabel));
+    inputAssociation.m_association.Reserve(inputHandleT->size(), 0);
 
+    // ATTN the rows are added in the order of the handle, matching the collection filled by GetCollection
     for (unsigned int iT = 0; iT < inputHandleT->size(); iT++)
-    {
-        art::Ptr<T> objectT(inputHandleT, iT);
-
-        if (outputAssociationMap.find(objectT) == outputAssociationMap.end())
-        {
-            std::vector< art::Ptr< U > > emptyVect;
-            outputAssociationMap.insert(typename std::map< art::Ptr< T >, std::vector< art::Ptr< U > > >::value_type(objectT, emptyVect));
-        }
+        inputAssociation.m_association.AddRow(assoc.at(iT));
 
-        for (art::Ptr<U> objectU : assoc.at(objectT.key()))
-            outputAssociationMap[objectT].push_back(objectU);
-    }
+    inputAssociation.m_isLoaded = true;
+    return inputAssociation.m_association;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T, typename U>
-inline void LArPandoraEvent::CollectAssociated(const art::Ptr<T> &anObject, const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationTtoU,
+inline void LArPandoraEvent::CollectAssociated(const art::Ptr<T> &anObject, const PtrKeyToIndexMap &positionIndexT, const CompressedAssociation<T, U> &associationTtoU,
     std::vector<art::Ptr<U> > &associatedU) const
 {
-    if (associationTtoU.find(anObject) == associationTtoU.end())
+    const PtrKeyToIndexMap::const_iterator itT(positionIndexT.find(GetPtrKey(anObject)));
+    if ((itT == positionIndexT.end()) || (itT->second >= associationTtoU.GetNumberOfSources()))
         throw cet::exception("LArPandora") << " LArPandoraEvent::CollectAssociated -- Can not find association for object supplied." << std::endl;
 
-    std::vector<art::Ptr<U> > associatedObjects = associationTtoU.at(anObject);
+    const typename CompressedAssociation<T, U>::Row associatedObjects(associationTtoU.GetRow(itT->second));
     associatedU.insert(associatedU.end(), associatedObjects.begin(), associatedObjects.end());
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T, typename U>
-inline void LArPandoraEvent::GetFilteredAssociationMap(const std::vector<art::Ptr<T> > &collectionT, const std::vector<art::Ptr<U> > &collectionU,
-    const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &inputAssociationTtoU, std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &outputAssociationTtoU) const
+inline void LArPandoraEvent::GetFilteredAssociationMap(const std::vector<art::Ptr<T> > &collectionT, const PtrKeySet &keysU, const PtrKeyToIndexMap &positionIndexT,
+    const CompressedAssociation<T, U> &inputAssociationTtoU, CompressedAssociation<T, U> &outputAssociationTtoU) const
 {
+    PtrKeySet keysT;
+    std::vector<art::Ptr<U> > filteredObjectsU;
+    outputAssociationTtoU.Reserve(collectionT.size(), 0);
+
     for (art::Ptr< T > objectT : collectionT)
     {
-        std::vector<art::Ptr<U> > emptyVector;
-        if (!outputAssociationTtoU.insert(typename std::map<art::Ptr<T>, std::vector<art::Ptr<U> > >::value_type(objectT, emptyVector)).second)
+        if (!keysT.insert(GetPtrKey(objectT)).second)
             throw cet::exception("LArPandora") << " LArPandoraEvent::GetFilteredAssociationMap -- Can not have multiple association map entries for a single object." << std::endl;
 
-        for (art::Ptr< U > objectU : inputAssociationTtoU.at(objectT))
+        const PtrKeyToIndexMap::const_iterator itT(positionIndexT.find(GetPtrKey(objectT)));
+        if (itT == positionIndexT.end())
+            throw cet::exception("LArPandora") << " LArPandoraEvent::GetFilteredAssociationMap -- Can not find association for object supplied." << std::endl;
+
+        filteredObjectsU.clear();
+        for (art::Ptr< U > objectU : inputAssociationTtoU.GetRow(itT->second))
         {
-            typename std::vector<art::Ptr<U> >::const_iterator associatedObjectIter = std::find(collectionU.begin(), collectionU.end(), objectU);
-            if (associatedObjectIter == collectionU.end())
+            if (keysU.find(GetPtrKey(objectU)) == keysU.end())
                 continue;
 
-            outputAssociationTtoU[objectT].push_back(objectU);
+            filteredObjectsU.push_back(objectU);
         }
+
+        outputAssociationTtoU.AddRow(filteredObjectsU);
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T>
-inline void LArPandoraEvent::WriteCollection(const std::vector<art::Ptr<T> > &collection) const
+inline void LArPandoraEvent::WriteCollection(const std::vector<art::Ptr<T> > &collection, PtrKeyToIndexMap &positionIndex) const
 {
+    this->GetPositionIndex(collection, positionIndex);
+
     std::unique_ptr<std::vector<T> > output(new std::vector<T>);
+    output->reserve(collection.size());
 
-    for (art::Ptr<T> object : collection)
+    for (const art::Ptr<T> &object : collection)
         output->push_back(*object);
 
     m_pEvent->put(std::move(output));
 }
 
 template <>
-inline void LArPandoraEvent::WriteCollection(const std::vector<art::Ptr<recob::PFParticle> > &collection) const
+inline void LArPandoraEvent::WriteCollection(const std::vector<art::Ptr<recob::PFParticle> > &collection, PtrKeyToIndexMap &positionIndex) const
 {
+    this->GetPositionIndex(collection, positionIndex);
+    const std::map<art::Ptr<recob::PFParticle>, unsigned int> &pfParticleToOriginIdMap(this->GetPFParticleToOriginIdMap());
+
     std::unique_ptr<std::vector<recob::PFParticle> > output(new std::vector<recob::PFParticle>);
+    output->reserve(collection.size());
 
     for (art::Ptr<recob::PFParticle> part : collection)
     {
@@ -493,56 +826,68 @@ inline void LArPandoraEvent::WriteCollection(const std::vector<art::Ptr<recob::P
         if (part->Self() >= m_shift)
             throw cet::exception("LArPandora") << " LArPandoraEvent::WriteCollection -- PFParticle ID exceeds shift value of " << m_shift << ". Can't merge the collections!" << std::endl;
 
-        if (m_pfParticleToOriginIdMap.find(part) == m_pfParticleToOriginIdMap.end())
+        if (pfParticleToOriginIdMap.find(part) == pfParticleToOriginIdMap.end())
             throw cet::exception("LArPandora") << " LArPandoraEvent::WriteCollection -- Can't find supplied PFParticle in the PFParticle to origin ID map." << std::endl;
 
-        const size_t offset(m_shift * m_pfParticleToOriginIdMap.at(part));
-        const size_t adjustedSelf(part->Self() + offset);
+        const size_t offset(m_shift * pfParticleToOriginIdMap.at(part));
+        output->push_back(LArPandoraEventSelection::GetAdjustedPFParticle(*part, offset));
+    }
 
-        size_t adjustedParent = part->Parent();
-        if (part->Parent() != recob::PFParticle::kPFParticlePrimary)
-            adjustedParent += offset;
+    m_pEvent->put(std::move(output));
+}
 
-        const std::vector<size_t> &daughters(part->Daughters());
-        std::vector<size_t> adjustedDaughters;
-        for (unsigned int d = 0; d < daughters.size(); d++)
-            adjustedDaughters.push_back(daughters[d] + offset);
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-        recob::PFParticle adjustedPart(part->PdgCode(), adjustedSelf, adjustedParent, adjustedDaughters);
-        output->push_back(adjustedPart);
-    }
+template <typename T>
+inline void LArPandoraEvent::WriteSelection(const std::vector<art::Ptr<T> > &collection, const std::string &selectionLabel,
+    const LArPandoraEventSelection::SelectionCollection selectionCollection) const
+{
+    std::unique_ptr<std::vector<art::Ptr<T> > > output(new std::vector<art::Ptr<T> >(collection));
+    m_pEvent->put(std::move(output), LArPandoraEventSelection::GetInstanceName(selectionLabel, selectionCollection));
+}
 
-    m_pEvent->put(std::move(output));
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void LArPandoraEvent::GetPositionIndex(const std::vector<art::Ptr<T> > &collection, PtrKeyToIndexMap &positionIndex) const
+{
+    positionIndex.reserve(collection.size());
+
+    // ATTN if an object is repeated, the first position is used
+    for (size_t index = 0; index < collection.size(); ++index)
+        (void) positionIndex.insert(PtrKeyToIndexMap::value_type(GetPtrKey(collection.at(index)), index));
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T, typename U>
-inline void LArPandoraEvent::WriteAssociation(const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationMap, const std::vector<art::Ptr<T> > &collectionT,
-    const std::vector<art::Ptr<U> > &collectionU, const bool thisProducesU) const
+inline void LArPandoraEvent::WriteAssociation(const CompressedAssociation<T, U> &association, const std::vector<art::Ptr<T> > &collectionT,
+    const PtrKeyToIndexMap &positionIndexU, const bool thisProducesU) const
 {
+    if (association.GetNumberOfSources() != collectionT.size())
+        throw cet::exception("LArPandora") << " LArPandoraEvent::WriteAssociation -- association does not have a row for each object in collectionT." << std::endl;
+
     const art::PtrMaker<T> makePtrT(*m_pEvent);
     std::unique_ptr<art::Assns<T, U> > outputAssn(new art::Assns<T, U>);
 
-    for (typename std::map<art::Ptr<T>, std::vector<art::Ptr<U> > >::const_iterator it = associationMap.begin(); it != associationMap.end(); ++it)
-    {
-        typename std::vector<art::Ptr<T> >::const_iterator itT = std::find(collectionT.begin(), collectionT.end(), it-> first);
-        if (itT == collectionT.end())
-            throw cet::exception("LArPandora") << " LArPandoraEvent::WriteAssociation -- association map contains object not in collectionT." << std::endl;
+    // ATTN: A PtrMaker can only be made for a product declared by this module, otherwise the input Ptr is reused
+    std::optional<art::PtrMaker<U> > makePtrU;
+    if (thisProducesU)
+        makePtrU.emplace(*m_pEvent);
 
-        art::Ptr<T> newObjectT(makePtrT(std::distance(collectionT.begin(), itT)));
+    for (typename CompressedAssociation<T, U>::const_iterator it = association.begin(); it != association.end(); ++it)
+    {
+        art::Ptr<T> newObjectT(makePtrT(it.GetSourceIndex()));
 
-        for (const art::Ptr<U> &objectU : it->second)
+        for (const art::Ptr<U> &objectU : *it)
         {
             if (thisProducesU)
             {
-                const art::PtrMaker<U> makePtrU(*m_pEvent);
-
-                typename std::vector<art::Ptr<U> >::const_iterator itU = std::find(collectionU.begin(), collectionU.end(), objectU);
-                if (itU == collectionU.end())
+                const PtrKeyToIndexMap::const_iterator itU(positionIndexU.find(GetPtrKey(objectU)));
+                if (itU == positionIndexU.end())
                     throw cet::exception("LArPandora") << " LArPandoraEvent::WriteAssociation -- association map contains object not in collectionU." << std::endl;
 
-                art::Ptr<U> newObjectU(makePtrU(std::distance(collectionU.begin(), itU)));
+                art::Ptr<U> newObjectU((*makePtrU)(itU->second));
                 util::CreateAssn(*m_pProducer, *m_pEvent, newObjectU, newObjectT, *outputAssn);
             }
             else
@@ -558,18 +903,41 @@ inline void LArPandoraEvent::WriteAssociation(const std::map<art::Ptr<T>, std::v
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T>
-inline void LArPandoraEvent::MergeCollection(std::vector<art::Ptr<T> > &collectionToMerge, const std::vector<art::Ptr<T> > &collection) const
+inline void LArPandoraEvent::MergeCollections(const std::vector<const LArPandoraEvent *> &events,
+    const std::vector<art::Ptr<T> > &(LArPandoraEvent::*const pGetCollection)() const, std::vector<art::Ptr<T> > &mergedCollection)
 {
-    collectionToMerge.insert(collectionToMerge.end(), collection.begin(), collection.end());
+    size_t nObjects(0);
+
+    for (const LArPandoraEvent *const pEvent : events)
+        nObjects += (pEvent->*pGetCollection)().size();
+
+    mergedCollection.reserve(mergedCollection.size() + nObjects);
+
+    for (const LArPandoraEvent *const pEvent : events)
+    {
+        const std::vector<art::Ptr<T> > &collection((pEvent->*pGetCollection)());
+        mergedCollection.insert(mergedCollection.end(), collection.begin(), collection.end());
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <typename T, typename U>
-inline void LArPandoraEvent::MergeAssociation(std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &associationToMerge,
-    const std::map<art::Ptr<T>, std::vector<art::Ptr<U> > > &association) const
+inline void LArPandoraEvent::MergeAssociations(const std::vector<const LArPandoraEvent *> &events,
+    const CompressedAssociation<T, U> &(LArPandoraEvent::*const pGetAssociation)() const, CompressedAssociation<T, U> &mergedAssociation)
 {
-    associationToMerge.insert(association.begin(), association.end());
+    size_t nSources(mergedAssociation.GetNumberOfSources()), nTargets(mergedAssociation.GetNumberOfTargets());
+
+    for (const LArPandoraEvent *const pEvent : events)
+    {
+        nSources += (pEvent->*pGetAssociation)().GetNumberOfSources();
+        nTargets += (pEvent->*pGetAssociation)().GetNumberOfTargets();
+    }
+
+    mergedAssociation.Reserve(nSources, nTargets);
+
+    for (const LArPandoraEvent *const pEvent : events)
+        mergedAssociation.Append((pEvent->*pGetAssociation)());
 }
 
 } // namespace lar_pandora
@@ -0,0 +1,99 @@
+/**
+ *  @file   larpandora/LArPandoraEventBuilding/LArPandoraEventSelection.cxx
+ *
+ *  @brief  Reader for the selection-reference output written by LArPandoraEvent in place of deep-copied collections
+ */
+
+#include "larpandora/LArPandoraEventBuilding/LArPandoraEventSelection.h"
+
+namespace lar_pandora
+{
+
+const std::string LArPandoraEventSelection::kPFParticleIdOffsetSuffix("PFParticleIdOffsets");
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+std::string LArPandoraEventSelection::GetInstanceName(const std::string &selectionLabel, const SelectionCollection collection)
+{
+    switch (collection)
+    {
+        case kPFParticles: return selectionLabel + "PFParticles";
+        case kSpacePoints: return selectionLabel + "SpacePoints";
+        case kClusters: return selectionLabel + "Clusters";
+        case kVertices: return selectionLabel + "Vertices";
+        case kTracks: return selectionLabel + "Tracks";
+        case kShowers: return selectionLabel + "Showers";
+        case kPCAxes: return selectionLabel + "PCAxes";
+        case kMetadata: return selectionLabel + "Metadata";
+        case kT0s: return selectionLabel + "T0s";
+        default: break;
+    }
+
+    throw cet::exception("LArPandora") << " LArPandoraEventSelection::GetInstanceName --- unknown collection " << collection;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+recob::PFParticle LArPandoraEventSelection::GetAdjustedPFParticle(const recob::PFParticle &part, const size_t offset)
+{
+    const size_t adjustedSelf(part.Self() + offset);
+
+    size_t adjustedParent = part.Parent();
+    if (part.Parent() != recob::PFParticle::kPFParticlePrimary)
+        adjustedParent += offset;
+
+    const std::vector<size_t> &daughters(part.Daughters());
+    std::vector<size_t> adjustedDaughters;
+    for (unsigned int d = 0; d < daughters.size(); d++)
+        adjustedDaughters.push_back(daughters[d] + offset);
+
+    return recob::PFParticle(part.PdgCode(), adjustedSelf, adjustedParent, adjustedDaughters);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraEventSelection::LArPandoraEventSelection(const art::Event &evt, const std::string &label, const std::string &selectionLabel) :
+    m_event(evt),
+    m_label(label),
+    m_selectionLabel(selectionLabel),
+    m_pPFParticleIdOffsets(nullptr)
+{
+    art::Handle< std::vector< art::Ptr<recob::PFParticle> > > pfParticleHandle;
+    evt.getByLabel(label, LArPandoraEventSelection::GetInstanceName(selectionLabel, kPFParticles), pfParticleHandle);
+
+    if (!pfParticleHandle.isValid())
+        throw cet::exception("LArPandora") << " LArPandoraEventSelection::LArPandoraEventSelection --- couldn't find the selection with label: " << label << ", " << selectionLabel;
+
+    art::Handle< std::vector<unsigned int> > offsetHandle;
+    evt.getByLabel(label, selectionLabel + kPFParticleIdOffsetSuffix, offsetHandle);
+
+    if (!offsetHandle.isValid() || (offsetHandle->size() != pfParticleHandle->size()))
+        throw cet::exception("LArPandora") << " LArPandoraEventSelection::LArPandoraEventSelection --- couldn't find consistent PFParticle ID offsets with label: " << label << ", " << selectionLabel;
+
+    m_pPFParticleIdOffsets = offsetHandle.product();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraEventSelection::GetAdjustedPFParticles(std::vector<recob::PFParticle> &adjustedPFParticles) const
+{
+    std::vector< art::Ptr<recob::PFParticle> > pfParticles;
+    this->GetCollection(kPFParticles, pfParticles);
+
+    adjustedPFParticles.reserve(adjustedPFParticles.size() + pfParticles.size());
+
+    for (size_t index = 0; index < pfParticles.size(); ++index)
+        adjustedPFParticles.push_back(LArPandoraEventSelection::GetAdjustedPFParticle(*pfParticles.at(index), this->GetPFParticleIdOffset(index)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t LArPandoraEventSelection::GetPFParticleIdOffset(const size_t index) const
+{
+    if (index >= m_pPFParticleIdOffsets->size())
+        throw cet::exception("LArPandora") << " LArPandoraEventSelection::GetPFParticleIdOffset --- no selected PFParticle at position " << index;
+
+    return m_pPFParticleIdOffsets->at(index);
+}
+
+} // namespace lar_pandora
@@ -0,0 +1,135 @@
+/**
+ *  @file   larpandora/LArPandoraEventBuilding/LArPandoraEventSelection.h
+ *
+ *  @brief  Reader for the selection-reference output written by LArPandoraEvent in place of deep-copied collections
+ */
+
+#ifndef LAR_PANDORA_EVENT_SELECTION_H
+#define LAR_PANDORA_EVENT_SELECTION_H 1
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+
+#include "canvas/Persistency/Common/Ptr.h"
+
+#include "cetlib_except/exception.h"
+
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/PFParticleMetadata.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Cluster.h"
+#include "lardataobj/RecoBase/Vertex.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Shower.h"
+#include "lardataobj/RecoBase/PCAxis.h"
+
+#include "lardataobj/AnalysisBase/T0.h"
+
+#include <string>
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  LArPandoraEventSelection class
+ *
+ *  The selection is stored as one product of type std::vector<art::Ptr<T> > per collection, with instance name selectionLabel + suffix.
+ *  Each holds a Ptr to every selected object in the collections of the original producers, which must also be kept. The Ptrs may span
+ *  several producers after a merge. A further product holds, for each selected PFParticle, the offset added to its IDs.
+ */
+class LArPandoraEventSelection
+{
+public:
+    /**
+     *  @brief  The collections in a selection
+     */
+    enum SelectionCollection
+    {
+        kPFParticles = 0,           ///< The PFParticles
+        kSpacePoints,               ///< The space points
+        kClusters,                  ///< The clusters
+        kVertices,                  ///< The vertices
+        kTracks,                    ///< The tracks
+        kShowers,                   ///< The showers
+        kPCAxes,                    ///< The PCAxes
+        kMetadata,                  ///< The PFParticle metadata
+        kT0s,                       ///< The T0s
+        kNSelectionCollections      ///< The number of collections
+    };
+
+    static const std::string    kPFParticleIdOffsetSuffix;  ///< The instance name suffix of the PFParticle ID offsets
+
+    /**
+     *  @brief  Get the instance name of the product holding the selection of a collection
+     *
+     *  @param  selectionLabel the instance name prefix of the selection products
+     *  @param  collection the collection
+     */
+    static std::string GetInstanceName(const std::string &selectionLabel, const SelectionCollection collection);
+
+    /**
+     *  @brief  Get a copy of a PFParticle with its ID, parent ID and daughter IDs shifted by a given offset
+     *
+     *  @param  part the PFParticle
+     *  @param  offset the offset
+     */
+    static recob::PFParticle GetAdjustedPFParticle(const recob::PFParticle &part, const size_t offset);
+
+    /**
+     *  @brief  Constructor, reads the selection products from the event
+     *
+     *  @param  evt the art event
+     *  @param  label the label of the producer that wrote the selection
+     *  @param  selectionLabel the instance name prefix of the selection products
+     */
+    LArPandoraEventSelection(const art::Event &evt, const std::string &label, const std::string &selectionLabel = "selection");
+
+    /**
+     *  @brief  Get the selected objects of a collection, pointing into the collections of the original producers
+     *
+     *  @param  collection the collection
+     *  @param  selectedObjects the output vector of selected objects
+     */
+    template <typename T>
+    void GetCollection(const SelectionCollection collection, std::vector<art::Ptr<T> > &selectedObjects) const;
+
+    /**
+     *  @brief  Get the selected PFParticles, as written in place of the selection (with their IDs adjusted)
+     *
+     *  @param  adjustedPFParticles the output vector of PFParticles
+     */
+    void GetAdjustedPFParticles(std::vector<recob::PFParticle> &adjustedPFParticles) const;
+
+    /**
+     *  @brief  Get the offset added to the IDs of a selected PFParticle
+     *
+     *  @param  index the position of the PFParticle in the selection
+     */
+    size_t GetPFParticleIdOffset(const size_t index) const;
+
+private:
+    const art::Event                   &m_event;                    ///< The art event
+    const std::string                   m_label;                    ///< The label of the producer that wrote the selection
+    const std::string                   m_selectionLabel;           ///< The instance name prefix of the selection products
+    const std::vector<unsigned int>    *m_pPFParticleIdOffsets;     ///< The PFParticle ID offsets, owned by the event
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void LArPandoraEventSelection::GetCollection(const SelectionCollection collection, std::vector<art::Ptr<T> > &selectedObjects) const
+{
+    art::Handle<std::vector<art::Ptr<T> > > selectionHandle;
+    m_event.getByLabel(m_label, LArPandoraEventSelection::GetInstanceName(m_selectionLabel, collection), selectionHandle);
+
+    if (!selectionHandle.isValid())
+        throw cet::exception("LArPandora") << " LArPandoraEventSelection::GetCollection --- couldn't find the selection with label: " << m_label << ", " <<
+            LArPandoraEventSelection::GetInstanceName(m_selectionLabel, collection);
+
+    selectedObjects.insert(selectedObjects.end(), selectionHandle->begin(), selectionHandle->end());
+}
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_EVENT_SELECTION_H
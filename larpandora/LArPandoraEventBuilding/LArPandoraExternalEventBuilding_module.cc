@@ -9,8 +9,6 @@
 #include "art/Framework/Principal/Event.h"
 #include "art/Utilities/make_tool.h"
 
-#include "canvas/Utilities/InputTag.h"
-
 #include "fhiclcpp/ParameterSet.h"
 
 #include "lardata/Utilities/AssociationUtil.h"
@@ -18,11 +16,19 @@
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
 #include "larpandora/LArPandoraEventBuilding/Slice.h"
+#include "larpandora/LArPandoraEventBuilding/SliceFeatureMatrix.h"
 #include "larpandora/LArPandoraEventBuilding/NeutrinoIdBaseTool.h"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraEvent.h"
 
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/RecoBase/PFParticleMetadata.h"
+#include "lardataobj/RecoBase/Cluster.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Vertex.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace lar_pandora
 {
@@ -40,44 +46,41 @@ public:
     void produce(art::Event &evt) override;
 
 private:
-    typedef std::map<art::Ptr<recob::PFParticle>, art::Ptr<larpandoraobj::PFParticleMetadata> > PFParticleToMetadata;
-
     /**
-     *  @brief  Collect PFParticles from the ART event and their mapping to metadata objects
+     *  @brief  Collect the mapping from PFParticles to metadata objects
      *
-     *  @param  evt the ART event
+     *  @param  associations the input PFParticles and their associated objects
      *  @param  particlesToMetadata the output mapping from PFParticles to their metadata
-     *  @param  particles the output vector of particles
      */
-    void CollectPFParticles(const art::Event &evt, PFParticleToMetadata &particlesToMetadata, PFParticleVector &particles) const;
-
-    /**
-     *  @brief  Build mapping from ID to PFParticle for fast navigation through the hierarchy
-     *
-     *  @param  particlesToMetadata the input mapping from PFParticles to their metadata
-     *  @param  particleMap the output mapping from ID to PFParticle
-     */
-    void BuildPFParticleMap(const PFParticleToMetadata &particlesToMetadata, PFParticleMap &particleMap) const;
+    void CollectPFParticleMetadata(const PFParticleAssociations &associations, PFParticlesToMetadata &particlesToMetadata) const;
 
     /**
      *  @brief  Collect PFParticles that have been identified as clear cosmic ray muons by pandora
      *
      *  @param  allParticles input vector of all particles
-     *  @param  particlesToMetadata the input mapping from PFParticles to their metadata
-     *  @param  particleMap the input mapping from ID to PFParticle
+     *  @param  hierarchyIndex the input hierarchy index of all particles
      *  @param  clearCosmics the output vector of clear cosmic rays
      */
-    void CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, PFParticleVector &clearCosmics) const;
+    void CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleHierarchyIndex &hierarchyIndex, PFParticleVector &clearCosmics) const;
 
     /**
      *  @brief  Collect slices
      *
      *  @param  allParticles input vector of all particles
-     *  @param  particlesToMetadata the input mapping from PFParticles to their metadata
-     *  @param  particleMap the input mapping from ID to PFParticle
+     *  @param  hierarchyIndex the input hierarchy index of all particles
      *  @param  slices the output vector of slices
      */
-    void CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, SliceVector &slices) const;
+    void CollectSlices(const PFParticleVector &allParticles, const PFParticleHierarchyIndex &hierarchyIndex, SliceVector &slices) const;
+
+    /**
+     *  @brief  Compute the common features of each slice, from the slice as reconstructed under the neutrino hypothesis (or under the
+     *          cosmic-ray hypothesis if there is no neutrino hypothesis)
+     *
+     *  @param  associations the input PFParticles and their associated objects
+     *  @param  slices the input vector of slices
+     *  @param  features the output features of the slices, only kNuScore unless a neutrino id tool needs the other features
+     */
+    void CollectSliceFeatures(const PFParticleAssociations &associations, const SliceVector &slices, SliceFeatureMatrix &features) const;
 
     /**
      *  @brief  Get the consolidated collection of particles based on the slice ids
@@ -89,23 +92,15 @@ private:
      */
     void CollectConsolidatedParticles(const PFParticleVector &allParticles, const PFParticleVector &clearCosmics, const SliceVector &slices, PFParticleVector &consolidatedParticles) const;
 
-    /**
-     *  @brief  Query a metadata object for a given key and return the corresponding value
-     *
-     *  @param  metadata the metadata object to query
-     *  @param  key the key to search for
-     *
-     *  @return the value in the metadata corresponding to the input key
-     */
-    float GetMetadataValue(const art::Ptr<larpandoraobj::PFParticleMetadata> &metadata, const std::string &key) const;
-
     std::string                         m_inputProducerLabel;  ///< Label for the Pandora instance that produced the collections we want to consolidated
     std::string                         m_trackProducerLabel;  ///< Label for the track producer using the Pandora instance that produced the collections we want to consolidate
     std::string                         m_showerProducerLabel; ///< Label for the shower producer using the Pandora instance that produced the collections we want to consolidate
     std::string                         m_hitProducerLabel;    ///< Label for the hit producer that was used as input to the Pandora instance specified
     bool                                m_shouldProduceT0s;    ///< If we should produce T0s (relevant when stitching over multiple drift volumes)
-    art::InputTag                       m_pandoraTag;          ///< The input tag for the pandora producer
-    std::unique_ptr<NeutrinoIdBaseTool> m_neutrinoIdTool;      ///< The neutrino id tool
+    bool                                m_shouldWriteSelection; ///< If we should write only a reference to the selected objects, rather than copies
+    std::string                         m_selectionLabel;      ///< The instance name prefix of the selection products
+    std::vector<std::unique_ptr<NeutrinoIdBaseTool> > m_neutrinoIdTools; ///< The neutrino id tools, applied in turn to the same slices
+    bool                                m_shouldCollectSliceFeatures; ///< If any neutrino id tool needs the slice features other than kNuScore
 };
 
 DEFINE_ART_MODULE(LArPandoraExternalEventBuilding)
@@ -127,35 +122,67 @@ LArPandoraExternalEventBuilding::LArPandoraExternalEventBuilding(fhicl::Paramete
     m_showerProducerLabel(pset.get<std::string>("ShowerProducerLabel")),
     m_hitProducerLabel(pset.get<std::string>("HitProducerLabel")),
     m_shouldProduceT0s(pset.get<bool>("ShouldProduceT0s")),
-    m_pandoraTag(art::InputTag(m_inputProducerLabel)),
-    m_neutrinoIdTool(art::make_tool<NeutrinoIdBaseTool>(pset.get<fhicl::ParameterSet>("NeutrinoIdTool")))
+    m_shouldWriteSelection(pset.get<bool>("ShouldWriteSelection", false)),
+    m_selectionLabel(pset.get<std::string>("SelectionLabel", "selection")),
+    m_shouldCollectSliceFeatures(false)
 {
-    produces< std::vector<recob::PFParticle> >();
-    produces< std::vector<recob::SpacePoint> >();
-    produces< std::vector<recob::Cluster> >();
-    produces< std::vector<recob::Vertex> >();
-    produces< std::vector<recob::Track> >();
-    produces< std::vector<recob::Shower> >();
-    produces< std::vector<recob::PCAxis> >();
-    produces< std::vector<larpandoraobj::PFParticleMetadata> >();
-
-    produces< art::Assns<recob::PFParticle, recob::SpacePoint> >();
-    produces< art::Assns<recob::PFParticle, recob::Cluster> >();
-    produces< art::Assns<recob::PFParticle, recob::Vertex> >();
-    produces< art::Assns<recob::PFParticle, recob::Track> >();
-    produces< art::Assns<recob::PFParticle, recob::Shower> >();
-    produces< art::Assns<recob::PFParticle, recob::PCAxis> >();
-    produces< art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata> >();
-    produces< art::Assns<recob::Track, recob::Hit> >();
-    produces< art::Assns<recob::Shower, recob::Hit> >();
-    produces< art::Assns<recob::Shower, recob::PCAxis> >();
-    produces< art::Assns<recob::SpacePoint, recob::Hit> >();
-    produces< art::Assns<recob::Cluster, recob::Hit> >();
-
-    if (m_shouldProduceT0s)
+    // ATTN a chain of neutrino id tools may be given in place of a single tool, all share the slice features computed once per event
+    if (pset.has_key("NeutrinoIdTools"))
+    {
+        for (const fhicl::ParameterSet &toolPset : pset.get<std::vector<fhicl::ParameterSet> >("NeutrinoIdTools"))
+            m_neutrinoIdTools.push_back(art::make_tool<NeutrinoIdBaseTool>(toolPset));
+    }
+    else
+    {
+        m_neutrinoIdTools.push_back(art::make_tool<NeutrinoIdBaseTool>(pset.get<fhicl::ParameterSet>("NeutrinoIdTool")));
+    }
+
+    for (const std::unique_ptr<NeutrinoIdBaseTool> &neutrinoIdTool : m_neutrinoIdTools)
+        m_shouldCollectSliceFeatures = m_shouldCollectSliceFeatures || neutrinoIdTool->NeedsSliceFeatures();
+
+    if (m_shouldWriteSelection)
     {
-        produces< std::vector<anab::T0> >();
-        produces< art::Assns<recob::PFParticle, anab::T0> >();
+        produces< std::vector< art::Ptr<recob::PFParticle> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kPFParticles));
+        produces< std::vector< art::Ptr<recob::SpacePoint> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kSpacePoints));
+        produces< std::vector< art::Ptr<recob::Cluster> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kClusters));
+        produces< std::vector< art::Ptr<recob::Vertex> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kVertices));
+        produces< std::vector< art::Ptr<recob::Track> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kTracks));
+        produces< std::vector< art::Ptr<recob::Shower> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kShowers));
+        produces< std::vector< art::Ptr<recob::PCAxis> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kPCAxes));
+        produces< std::vector< art::Ptr<larpandoraobj::PFParticleMetadata> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kMetadata));
+        produces< std::vector< art::Ptr<anab::T0> > >(LArPandoraEventSelection::GetInstanceName(m_selectionLabel, LArPandoraEventSelection::kT0s));
+
+        produces< std::vector<unsigned int> >(m_selectionLabel + LArPandoraEventSelection::kPFParticleIdOffsetSuffix);
+    }
+    else
+    {
+        produces< std::vector<recob::PFParticle> >();
+        produces< std::vector<recob::SpacePoint> >();
+        produces< std::vector<recob::Cluster> >();
+        produces< std::vector<recob::Vertex> >();
+        produces< std::vector<recob::Track> >();
+        produces< std::vector<recob::Shower> >();
+        produces< std::vector<recob::PCAxis> >();
+        produces< std::vector<larpandoraobj::PFParticleMetadata> >();
+
+        produces< art::Assns<recob::PFParticle, recob::SpacePoint> >();
+        produces< art::Assns<recob::PFParticle, recob::Cluster> >();
+        produces< art::Assns<recob::PFParticle, recob::Vertex> >();
+        produces< art::Assns<recob::PFParticle, recob::Track> >();
+        produces< art::Assns<recob::PFParticle, recob::Shower> >();
+        produces< art::Assns<recob::PFParticle, recob::PCAxis> >();
+        produces< art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata> >();
+        produces< art::Assns<recob::Track, recob::Hit> >();
+        produces< art::Assns<recob::Shower, recob::Hit> >();
+        produces< art::Assns<recob::Shower, recob::PCAxis> >();
+        produces< art::Assns<recob::SpacePoint, recob::Hit> >();
+        produces< art::Assns<recob::Cluster, recob::Hit> >();
+
+        if (m_shouldProduceT0s)
+        {
+            produces< std::vector<anab::T0> >();
+            produces< art::Assns<recob::PFParticle, anab::T0> >();
+        }
     }
 }
 
@@ -163,20 +190,30 @@ LArPandoraExternalEventBuilding::LArPandoraExternalEventBuilding(fhicl::Paramete
 
 void LArPandoraExternalEventBuilding::produce(art::Event &evt)
 {
-    PFParticleVector particles;
-    PFParticleToMetadata particlesToMetadata;
-    this->CollectPFParticles(evt, particlesToMetadata, particles);
+    // ATTN the particles are read once, together with every association needed to build the hierarchy and any slice features the tools need
+    const unsigned int featureAssociationKinds(m_shouldCollectSliceFeatures ? (LArPandoraHelper::kClusterHitAssociations |
+        LArPandoraHelper::kSpacePointAssociations | LArPandoraHelper::kVertexAssociations) : 0);
 
-    PFParticleMap particleMap;
-    this->BuildPFParticleMap(particlesToMetadata, particleMap);
+    PFParticleAssociations associations;
+    LArPandoraHelper::CollectPFParticleAssociations(evt, m_inputProducerLabel, LArPandoraHelper::kMetadataAssociations | featureAssociationKinds, associations);
+
+    const PFParticleVector &particles(associations.GetParticles());
+    PFParticlesToMetadata particlesToMetadata;
+    this->CollectPFParticleMetadata(associations, particlesToMetadata);
+
+    const PFParticleHierarchyIndex hierarchyIndex(particles, particlesToMetadata);
 
     PFParticleVector clearCosmics;
-    this->CollectClearCosmicRays(particles, particlesToMetadata, particleMap, clearCosmics);
+    this->CollectClearCosmicRays(particles, hierarchyIndex, clearCosmics);
 
     SliceVector slices;
-    this->CollectSlices(particles, particlesToMetadata, particleMap, slices);
+    this->CollectSlices(particles, hierarchyIndex, slices);
+
+    SliceFeatureMatrix features(slices.size());
+    this->CollectSliceFeatures(associations, slices, features);
 
-    m_neutrinoIdTool->ClassifySlices(slices, evt);
+    for (const std::unique_ptr<NeutrinoIdBaseTool> &neutrinoIdTool : m_neutrinoIdTools)
+        neutrinoIdTool->ClassifySliceBatch(slices, features, evt);
 
     PFParticleVector consolidatedParticles;
     this->CollectConsolidatedParticles(particles, clearCosmics, slices, consolidatedParticles);
@@ -184,70 +221,50 @@ void LArPandoraExternalEventBuilding::produce(art::Event &evt)
     const LArPandoraEvent::Labels labels(m_inputProducerLabel, m_trackProducerLabel, m_showerProducerLabel, m_hitProducerLabel);
     const LArPandoraEvent consolidatedEvent(LArPandoraEvent(this, &evt, labels, m_shouldProduceT0s), consolidatedParticles);
 
-    consolidatedEvent.WriteToEvent();
+    if (m_shouldWriteSelection)
+    {
+        consolidatedEvent.WriteSelectionToEvent(m_selectionLabel);
+    }
+    else
+    {
+        consolidatedEvent.WriteToEvent();
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraExternalEventBuilding::CollectPFParticles(const art::Event &evt, PFParticleToMetadata &particlesToMetadata, PFParticleVector &particles) const
+void LArPandoraExternalEventBuilding::CollectPFParticleMetadata(const PFParticleAssociations &associations, PFParticlesToMetadata &particlesToMetadata) const
 {
-    art::Handle<std::vector<recob::PFParticle> > pfParticleHandle;
-    evt.getByLabel(m_pandoraTag, pfParticleHandle);
-
-    art::FindManyP<larpandoraobj::PFParticleMetadata> pfParticleMetadataAssoc(pfParticleHandle, evt, m_pandoraTag);
-
-    for (unsigned int i = 0; i < pfParticleHandle->size(); ++i)
+    for (const art::Ptr<recob::PFParticle> &part : associations.GetParticles())
     {
-        const art::Ptr<recob::PFParticle> part(pfParticleHandle, i);
-        const auto &metadata(pfParticleMetadataAssoc.at(part.key()));
-
-        particles.push_back(part);
+        const MetadataVector &metadata(associations.GetMetadata(part));
 
         if (metadata.size() != 1)
-            throw cet::exception("LArPandora") << " LArPandoraExternalEventBuilding::CollectPFParticles -- Found a PFParticle without exactly 1 metadata associated." << std::endl;
-
-        if (!particlesToMetadata.insert(PFParticleToMetadata::value_type(part, metadata.front())).second)
-            throw cet::exception("LArPandoraExternalEventBuilding") << "Repeated PFParticles" << std::endl;
-    }
-}
+            throw cet::exception("LArPandora") << " LArPandoraExternalEventBuilding::CollectPFParticleMetadata -- Found a PFParticle without exactly 1 metadata associated." << std::endl;
 
-//------------------------------------------------------------------------------------------------------------------------------------------
-
-void LArPandoraExternalEventBuilding::BuildPFParticleMap(const PFParticleToMetadata &particlesToMetadata, PFParticleMap &particleMap) const
-{
-    for (const auto &entry : particlesToMetadata)
-    {
-        if (!particleMap.insert(PFParticleMap::value_type(entry.first->Self(), entry.first)).second)
+        if (!particlesToMetadata.insert(PFParticlesToMetadata::value_type(part, metadata)).second)
             throw cet::exception("LArPandoraExternalEventBuilding") << "Repeated PFParticles" << std::endl;
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraExternalEventBuilding::CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, PFParticleVector &clearCosmics) const
+void LArPandoraExternalEventBuilding::CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleHierarchyIndex &hierarchyIndex, PFParticleVector &clearCosmics) const
 {
     for (const auto &part : allParticles)
     {
-        // Get the parent of the particle
-        const auto parentIt(particlesToMetadata.find(LArPandoraHelper::GetParentPFParticle(particleMap, part)));
-        if (parentIt == particlesToMetadata.end())
-            throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without metadata" << std::endl;
+        if (!hierarchyIndex.IsIndexed(part))
+            throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without a top-level parent" << std::endl;
 
-        // ATTN particles without the "IsClearCosmic" parameter are not clear cosmics
-        try
-        {
-            if (static_cast<bool>(std::round(this->GetMetadataValue(parentIt->second, "IsClearCosmic"))))
-                clearCosmics.push_back(part);
-        }
-        catch (const cet::exception &)
-        {
-        }
+        // ATTN particles whose parent lacks the "IsClearCosmic" parameter are not clear cosmics
+        if (hierarchyIndex.IsClearCosmic(part))
+            clearCosmics.push_back(part);
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, SliceVector &slices) const
+void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allParticles, const PFParticleHierarchyIndex &hierarchyIndex, SliceVector &slices) const
 {
     std::map<unsigned int, float> nuScores;
     std::map<unsigned int, PFParticleVector> crHypotheses;
@@ -256,27 +273,26 @@ void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allP
     // Collect the slice information
     for (const auto &part : allParticles)
     {
-        // Find the parent PFParticle
-        const auto parentIt(particlesToMetadata.find(LArPandoraHelper::GetParentPFParticle(particleMap, part)));
-        if (parentIt == particlesToMetadata.end())
-            throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without metadata" << std::endl;
-
         // Skip PFParticles that are clear cosmics
-        try
-        {
-            if (static_cast<bool>(std::round(this->GetMetadataValue(parentIt->second, "IsClearCosmic"))))
-                continue;
-        }
-        catch (const cet::exception &)
-        {
-        }
+        if (hierarchyIndex.IsClearCosmic(part))
+            continue;
+
+        art::Ptr<recob::PFParticle> parent;
+        if (!hierarchyIndex.GetRoot(part, parent))
+            throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without a top-level parent" << std::endl;
+
+        unsigned int sliceId(0);
+        if (!hierarchyIndex.GetSliceIndex(part, sliceId))
+            throw cet::exception("LArPandoraExternalEventBuilding") << "No key \"SliceIndex\" found in metadata properties map" << std::endl;
+
+        float nuScore(0.f);
+        if (!hierarchyIndex.GetRootMetadataValue(part, "NuScore", nuScore))
+            throw cet::exception("LArPandoraExternalEventBuilding") << "No key \"NuScore\" found in metadata properties map" << std::endl;
 
-        const unsigned int sliceId(static_cast<unsigned int>(std::round(this->GetMetadataValue(parentIt->second, "SliceIndex"))));
-        const float nuScore(this->GetMetadataValue(parentIt->second, "NuScore"));
         // ATTN all PFParticles in the same slice will have the same nuScore
         nuScores[sliceId] = nuScore;
 
-        if (LArPandoraHelper::IsNeutrino(parentIt->first))
+        if (LArPandoraHelper::IsNeutrino(parent))
         {
             nuHypotheses[sliceId].push_back(part);
         }
@@ -314,35 +330,99 @@ void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allP
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-float LArPandoraExternalEventBuilding::GetMetadataValue(const art::Ptr<larpandoraobj::PFParticleMetadata> &metadata, const std::string &key) const
+void LArPandoraExternalEventBuilding::CollectSliceFeatures(const PFParticleAssociations &associations, const SliceVector &slices, SliceFeatureMatrix &features) const
 {
-    const auto &propertiesMap(metadata->GetPropertiesMap());
-    const auto &it(propertiesMap.find(key));
+    for (size_t sliceIndex = 0; sliceIndex < slices.size(); ++sliceIndex)
+    {
+        const Slice &slice(slices.at(sliceIndex));
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kNuScore, slice.GetNeutrinoScore());
 
-    if (it == propertiesMap.end())
-        throw cet::exception("LArPandoraExternalEventBuilding") << "No key \"" << key << "\" found in metadata properties map" << std::endl;
+        if (!m_shouldCollectSliceFeatures)
+            continue;
 
-    return it->second;
+        const PFParticleVector &particles(slice.GetNeutrinoHypothesis().empty() ? slice.GetCosmicRayHypothesis() : slice.GetNeutrinoHypothesis());
+
+        unsigned int nHitsU(0), nHitsV(0), nHitsW(0), nSpacePoints(0);
+        float minX(std::numeric_limits<float>::max()), minY(std::numeric_limits<float>::max()), minZ(std::numeric_limits<float>::max());
+        float maxX(-std::numeric_limits<float>::max()), maxY(-std::numeric_limits<float>::max()), maxZ(-std::numeric_limits<float>::max());
+
+        for (const art::Ptr<recob::PFParticle> &part : particles)
+        {
+            for (const art::Ptr<recob::Hit> &hit : associations.GetClusterHits(part))
+            {
+                if (geo::kU == hit->View())
+                    ++nHitsU;
+                else if (geo::kV == hit->View())
+                    ++nHitsV;
+                else if (geo::kW == hit->View())
+                    ++nHitsW;
+            }
+
+            for (const art::Ptr<recob::SpacePoint> &spacePoint : associations.GetSpacePoints(part))
+            {
+                const Double32_t *const xyz(spacePoint->XYZ());
+                minX = std::min(minX, static_cast<float>(xyz[0]));
+                maxX = std::max(maxX, static_cast<float>(xyz[0]));
+                minY = std::min(minY, static_cast<float>(xyz[1]));
+                maxY = std::max(maxY, static_cast<float>(xyz[1]));
+                minZ = std::min(minZ, static_cast<float>(xyz[2]));
+                maxZ = std::max(maxZ, static_cast<float>(xyz[2]));
+                ++nSpacePoints;
+            }
+
+            if (!LArPandoraHelper::IsNeutrino(part) || features.GetValue(sliceIndex, SliceFeatureMatrix::kHasVertex) > 0.f)
+                continue;
+
+            const VertexVector &vertices(associations.GetVertices(part));
+
+            if (vertices.size() != 1)
+                continue;
+
+            double xyz[3] = {0.0, 0.0, 0.0};
+            vertices.front()->XYZ(xyz);
+            features.SetValue(sliceIndex, SliceFeatureMatrix::kHasVertex, 1.f);
+            features.SetValue(sliceIndex, SliceFeatureMatrix::kVertexX, static_cast<float>(xyz[0]));
+            features.SetValue(sliceIndex, SliceFeatureMatrix::kVertexY, static_cast<float>(xyz[1]));
+            features.SetValue(sliceIndex, SliceFeatureMatrix::kVertexZ, static_cast<float>(xyz[2]));
+        }
+
+        // ATTN slices without space points have zero extents
+        if (0 == nSpacePoints)
+            minX = maxX = minY = maxY = minZ = maxZ = 0.f;
+
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kNHitsU, static_cast<float>(nHitsU));
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kNHitsV, static_cast<float>(nHitsV));
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kNHitsW, static_cast<float>(nHitsW));
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kNSpacePoints, static_cast<float>(nSpacePoints));
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMinX, minX);
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMaxX, maxX);
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMinY, minY);
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMaxY, maxY);
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMinZ, minZ);
+        features.SetValue(sliceIndex, SliceFeatureMatrix::kMaxZ, maxZ);
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void LArPandoraExternalEventBuilding::CollectConsolidatedParticles(const PFParticleVector &allParticles, const PFParticleVector &clearCosmics, const SliceVector &slices, PFParticleVector &consolidatedParticles) const
 {
-    PFParticleVector collectedParticles;
-    collectedParticles.insert(collectedParticles.end(), clearCosmics.begin(), clearCosmics.end());
+    PtrKeySet collectedKeys;
+    GetPtrKeySet(clearCosmics, collectedKeys);
 
     for (const auto &slice : slices)
     {
         const PFParticleVector &particles(slice.IsTaggedAsNeutrino() ? slice.GetNeutrinoHypothesis() : slice.GetCosmicRayHypothesis());
-        collectedParticles.insert(collectedParticles.end(), particles.begin(), particles.end());
+        GetPtrKeySet(particles, collectedKeys);
     }
 
     // ATTN the collected particles are the ones we want to output, but here we loop over all particles to ensure that the consolidated
     // particles have the same ordering.
+    consolidatedParticles.reserve(consolidatedParticles.size() + collectedKeys.size());
+
     for (const auto &part : allParticles)
     {
-        if (std::find(collectedParticles.begin(), collectedParticles.end(), part) != collectedParticles.end())
+        if (collectedKeys.count(GetPtrKey(part)))
             consolidatedParticles.push_back(part);
     }
 }
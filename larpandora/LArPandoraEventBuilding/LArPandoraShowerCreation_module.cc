@@ -19,6 +19,8 @@
 
 #include "larpandoracontent/LArObjects/LArPfoObjects.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraShowerPCA.h"
+
 #include <memory>
 
 namespace lar_pandora
@@ -38,23 +40,20 @@ public:
 
 private:
     /**
-     *  @brief  Build a recob::Shower object
-     *
-     *  @param  id the id code for the shower
-     *  @param  larShowerPCA the lar shower pca parameters extracted from pandora
-     *  @param  vertexPosition the shower vertex position
-     */
-    recob::Shower BuildShower(const int id, const lar_content::LArShowerPCA &larShowerPCA, const pandora::CartesianVector &vertexPosition) const;
-
-    /**
-     *  @brief  Build a recob::PCAxis object
+     *  @brief  Recompute the principal components with the implementation not in use, and report any difference
      *
-     *  @param  larShowerPCA the lar shower pca parameters extracted from pandora
+     *  @param  spacePointVector the space points
+     *  @param  vertexPosition the vertex position
+     *  @param  larShowerPCA the principal components from the implementation in use
      */
-    recob::PCAxis BuildPCAxis(const lar_content::LArShowerPCA &larShowerPCA) const;
+    void CheckPrincipalComponents(const SpacePointVector &spacePointVector, const pandora::CartesianVector &vertexPosition,
+        const lar_content::LArShowerPCA &larShowerPCA);
 
-    std::string     m_pfParticleLabel;              ///< The pf particle label
-    bool            m_useAllParticles;              ///< Build a recob::Track for every recob::PFParticle
+    std::string         m_pfParticleLabel;          ///< The pf particle label
+    bool                m_useAllParticles;          ///< Build a recob::Track for every recob::PFParticle
+    bool                m_useSinglePassPCA;         ///< Whether to use the single-pass pca in place of the pandora pca
+    bool                m_checkSinglePassPCA;       ///< Whether to run both pca implementations and report any difference
+    LArPandoraShowerPCA m_showerPCA;                ///< The single-pass pca, kept to reuse its coordinate arrays
 
     // TODO When implementation lived in LArPandoraOutput, it contained key building blocks for calculation of shower energies per plane.
     // Now functionality has moved to separate module, will require reimplementation (was deeply embedded in LArPandoraOutput structure).
@@ -90,8 +89,12 @@ DEFINE_ART_MODULE(LArPandoraShowerCreation)
 
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationCache.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace lar_pandora
@@ -100,7 +103,9 @@ namespace lar_pandora
 LArPandoraShowerCreation::LArPandoraShowerCreation(fhicl::ParameterSet const &pset) :
     EDProducer{pset},
     m_pfParticleLabel(pset.get<std::string>("PFParticleLabel")),
-    m_useAllParticles(pset.get<bool>("UseAllParticles", false))
+    m_useAllParticles(pset.get<bool>("UseAllParticles", false)),
+    m_useSinglePassPCA(pset.get<bool>("UseSinglePassPCA", false)),
+    m_checkSinglePassPCA(pset.get<bool>("CheckSinglePassPCA", false))
 {
     produces< std::vector<recob::Shower> >();
     produces< std::vector<recob::PCAxis> >();
@@ -127,15 +132,12 @@ void LArPandoraShowerCreation::produce(art::Event &evt)
     int showerCounter(0);
 
     // Organise inputs
-    PFParticleVector pfParticleVector, extraPfParticleVector;
-    PFParticlesToSpacePoints pfParticlesToSpacePoints;
-    PFParticlesToClusters pfParticlesToClusters;
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
+    PFParticleAssociations pfParticleAssociations;
+    LArPandoraHelper::CollectPFParticleAssociations(evt, m_pfParticleLabel, LArPandoraHelper::kSpacePointAssociations |
+        LArPandoraHelper::kClusterAssociations | LArPandoraHelper::kVertexAssociations, pfParticleAssociations);
+    const PFParticleVector &pfParticleVector(pfParticleAssociations.GetParticles());
 
-    VertexVector vertexVector;
-    PFParticlesToVertices pfParticlesToVertices;
-    LArPandoraHelper::CollectVertices(evt, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
+    LArPandoraAssociationCache associationCache(evt);
 
     for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector)
     {
@@ -144,64 +146,51 @@ void LArPandoraShowerCreation::produce(art::Event &evt)
             continue;
 
         // Obtain associated spacepoints
-        PFParticlesToSpacePoints::const_iterator particleToSpacePointIter(pfParticlesToSpacePoints.find(pPFParticle));
+        const SpacePointVector &spacePointVector(pfParticleAssociations.GetSpacePoints(pPFParticle));
 
-        if (pfParticlesToSpacePoints.end() == particleToSpacePointIter)
+        if (spacePointVector.empty())
         {
             mf::LogDebug("LArPandoraShowerCreation") << "No spacepoints associated to particle ";
             continue;
         }
 
         // Obtain associated clusters
-        PFParticlesToClusters::const_iterator particleToClustersIter(pfParticlesToClusters.find(pPFParticle));
+        const ClusterVector &clusterVector(pfParticleAssociations.GetClusters(pPFParticle));
 
-        if (pfParticlesToClusters.end() == particleToClustersIter)
+        if (clusterVector.empty())
         {
             mf::LogDebug("LArPandoraShowerCreation") << "No clusters associated to particle ";
             continue;
         }
 
         // Obtain associated vertex
-        PFParticlesToVertices::const_iterator particleToVertexIter(pfParticlesToVertices.find(pPFParticle));
+        const VertexVector &vertexVector(pfParticleAssociations.GetVertices(pPFParticle));
 
-        if ((pfParticlesToVertices.end() == particleToVertexIter) || (1 != particleToVertexIter->second.size()))
+        if (1 != vertexVector.size())
         {
             mf::LogDebug("LArPandoraShowerCreation") << "Unexpected number of vertices for particle ";
             continue;
         }
 
-        // Copy information into expected pandora form
-        pandora::CartesianPointVector cartesianPointVector;
-        for (const art::Ptr<recob::SpacePoint> spacePoint : particleToSpacePointIter->second)
-            cartesianPointVector.emplace_back(pandora::CartesianVector(spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
-
         double vertexXYZ[3] = {0., 0., 0.};
-        particleToVertexIter->second.front()->XYZ(vertexXYZ);
+        vertexVector.front()->XYZ(vertexXYZ);
         const pandora::CartesianVector vertexPosition(vertexXYZ[0], vertexXYZ[1], vertexXYZ[2]);
 
         // Call pandora "fast" shower fitter
         try
         {
             // Access centroid of shower via this method
-            const lar_content::LArShowerPCA initialLArShowerPCA(lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition));
+            const lar_content::LArShowerPCA initialLArShowerPCA(m_useSinglePassPCA ? m_showerPCA.GetPrincipalComponents(spacePointVector, vertexPosition) :
+                LArPandoraShowerPCA::GetPandoraPrincipalComponents(spacePointVector, vertexPosition));
+
+            if (m_checkSinglePassPCA)
+                this->CheckPrincipalComponents(spacePointVector, vertexPosition, initialLArShowerPCA);
 
             // Ensure successful creation of all structures before placing results in output containers, remaking LArShowerPCA with updated vertex
-            const pandora::CartesianVector &centroid(initialLArShowerPCA.GetCentroid());
-            const pandora::CartesianVector &primaryAxis(initialLArShowerPCA.GetPrimaryAxis());
-            const pandora::CartesianVector &secondaryAxis(initialLArShowerPCA.GetSecondaryAxis());
-            const pandora::CartesianVector &tertiaryAxis(initialLArShowerPCA.GetTertiaryAxis());
-            const pandora::CartesianVector &eigenvalues(initialLArShowerPCA.GetEigenValues());
-
-            // Project the PFParticle vertex onto the PCA axis
-            const pandora::CartesianVector projectedVertexPosition(centroid - primaryAxis.GetUnitVector() * (centroid - vertexPosition).GetDotProduct(primaryAxis));
-
-            // By convention, principal axis should always point away from vertex
-            const float testProjection(primaryAxis.GetDotProduct(projectedVertexPosition - centroid));
-            const float directionScaleFactor((testProjection > std::numeric_limits<float>::epsilon()) ? -1.f : 1.f);
-
-            const lar_content::LArShowerPCA larShowerPCA(centroid, primaryAxis * directionScaleFactor, secondaryAxis * directionScaleFactor, tertiaryAxis * directionScaleFactor, eigenvalues);
-            const recob::Shower shower(LArPandoraShowerCreation::BuildShower(showerCounter++, larShowerPCA, projectedVertexPosition));
-            const recob::PCAxis pcAxis(LArPandoraShowerCreation::BuildPCAxis(larShowerPCA));
+            pandora::CartesianVector projectedVertexPosition(0.f, 0.f, 0.f);
+            const lar_content::LArShowerPCA larShowerPCA(LArPandoraOutput::OrientShowerPCA(initialLArShowerPCA, vertexPosition, projectedVertexPosition));
+            const recob::Shower shower(LArPandoraOutput::BuildShower(showerCounter++, larShowerPCA, projectedVertexPosition));
+            const recob::PCAxis pcAxis(LArPandoraOutput::BuildPCAxis(larShowerPCA));
             outputShowers->emplace_back(shower);
             outputPCAxes->emplace_back(pcAxis);
         }
@@ -216,7 +205,7 @@ void LArPandoraShowerCreation::produce(art::Event &evt)
         art::Ptr<recob::PCAxis> pPCAxis(makePCAxisPtr(outputPCAxes->size() - 1));
 
         HitVector hitsInParticle;
-        LArPandoraHelper::GetAssociatedHits(evt, m_pfParticleLabel, particleToClustersIter->second, hitsInParticle);
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, clusterVector, hitsInParticle);
 
         // Output associations, after output objects are in place
         util::CreateAssn(*this, evt, pShower, pPFParticle, *(outputParticlesToShowers.get()));
@@ -238,54 +227,38 @@ void LArPandoraShowerCreation::produce(art::Event &evt)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-recob::Shower LArPandoraShowerCreation::BuildShower(const int id, const lar_content::LArShowerPCA &larShowerPCA, const pandora::CartesianVector &vertexPosition) const
+void LArPandoraShowerCreation::CheckPrincipalComponents(const SpacePointVector &spacePointVector, const pandora::CartesianVector &vertexPosition,
+    const lar_content::LArShowerPCA &larShowerPCA)
 {
-    const pandora::CartesianVector &showerLength(larShowerPCA.GetAxisLengths());
-    const pandora::CartesianVector &showerDirection(larShowerPCA.GetPrimaryAxis());
-
-    const float length(showerLength.GetX());
-    const float openingAngle(larShowerPCA.GetPrimaryLength() > 0.f ? std::atan(larShowerPCA.GetSecondaryLength() / larShowerPCA.GetPrimaryLength()) : 0.f);
-    const TVector3 direction(showerDirection.GetX(), showerDirection.GetY(), showerDirection.GetZ());
-    const TVector3 vertex(vertexPosition.GetX(), vertexPosition.GetY(), vertexPosition.GetZ());
-
-    // TODO
-    const TVector3 directionErr;
-    const TVector3 vertexErr;
-    const std::vector<double> totalEnergyErr;
-    const std::vector<double> dEdx;
-    const std::vector<double> dEdxErr;
-    const std::vector<double> totalEnergy;
-    const int bestplane(0);
-
-    return recob::Shower(direction, directionErr, vertex, vertexErr, totalEnergy, totalEnergyErr, dEdx, dEdxErr, bestplane, id, length, openingAngle);
-}
+    // ATTN the tolerance allows for the pandora pca accumulating in single precision
+    const float tolerance(1.e-3f);
 
-//------------------------------------------------------------------------------------------------------------------------------------------
+    try
+    {
+        const lar_content::LArShowerPCA otherLArShowerPCA(m_useSinglePassPCA ? LArPandoraShowerPCA::GetPandoraPrincipalComponents(spacePointVector, vertexPosition) :
+            m_showerPCA.GetPrincipalComponents(spacePointVector, vertexPosition));
 
-recob::PCAxis LArPandoraShowerCreation::BuildPCAxis(const lar_content::LArShowerPCA &larShowerPCA) const
-{
-    const pandora::CartesianVector &showerCentroid(larShowerPCA.GetCentroid());
-    const pandora::CartesianVector &showerDirection(larShowerPCA.GetPrimaryAxis());
-    const pandora::CartesianVector &showerSecondaryVector(larShowerPCA.GetSecondaryAxis());
-    const pandora::CartesianVector &showerTertiaryVector(larShowerPCA.GetTertiaryAxis());
-    const pandora::CartesianVector &showerEigenValues(larShowerPCA.GetEigenValues());
-
-    const bool svdOK(true); ///< SVD Decomposition was successful
-    const double eigenValues[3] = {showerEigenValues.GetX(), showerEigenValues.GetY(), showerEigenValues.GetZ()}; ///< Eigen values from SVD decomposition
-    const double avePosition[3] = {showerCentroid.GetX(), showerCentroid.GetY(), showerCentroid.GetZ()}; ///< Average position of hits fed to PCA
-
-    std::vector< std::vector<double> > eigenVecs = { /// The three principle axes
-        { showerDirection.GetX(), showerDirection.GetY(), showerDirection.GetZ() },
-        { showerSecondaryVector.GetX(), showerSecondaryVector.GetY(), showerSecondaryVector.GetZ() },
-        { showerTertiaryVector.GetX(), showerTertiaryVector.GetY(), showerTertiaryVector.GetZ() }
-    };
-
-    // TODO
-    const int numHitsUsed(100); ///< Number of hits in the decomposition, not yet ready
-    const double aveHitDoca(0.); ///< Average doca of hits used in PCA, not ready yet
-    const size_t iD(util::kBogusI); ///< Axis ID, not ready yet
-
-    return recob::PCAxis(svdOK, numHitsUsed, eigenValues, eigenVecs, avePosition, aveHitDoca, iD);
+        const pandora::CartesianVector &eigenValues(larShowerPCA.GetEigenValues());
+        const pandora::CartesianVector &otherEigenValues(otherLArShowerPCA.GetEigenValues());
+        const float scale(std::max(1.f, eigenValues.GetX()));
+
+        // ATTN only the primary axis direction is fixed by convention, the other axes may differ in sign between implementations
+        const bool isConsistent(((larShowerPCA.GetCentroid() - otherLArShowerPCA.GetCentroid()).GetMagnitude() < tolerance * std::sqrt(scale)) &&
+            ((eigenValues - otherEigenValues).GetMagnitude() < tolerance * scale) &&
+            (larShowerPCA.GetPrimaryAxis().GetDotProduct(otherLArShowerPCA.GetPrimaryAxis()) > 1.f - tolerance));
+
+        if (!isConsistent)
+        {
+            mf::LogWarning("LArPandoraShowerCreation") << "Inconsistent shower pca for " << spacePointVector.size() << " spacepoints: centroid "
+                << larShowerPCA.GetCentroid() << " vs " << otherLArShowerPCA.GetCentroid() << ", eigenvalues " << eigenValues << " vs "
+                << otherEigenValues << ", primary axis " << larShowerPCA.GetPrimaryAxis() << " vs " << otherLArShowerPCA.GetPrimaryAxis();
+        }
+    }
+    catch (const pandora::StatusCodeException &)
+    {
+        mf::LogWarning("LArPandoraShowerCreation") << "Shower pca only succeeded with the " << (m_useSinglePassPCA ? "single-pass" : "pandora")
+            << " implementation, for " << spacePointVector.size() << " spacepoints";
+    }
 }
 
 } // namespace lar_pandora
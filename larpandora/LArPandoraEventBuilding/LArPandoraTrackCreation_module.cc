@@ -17,6 +17,8 @@
 
 #include "larpandoracontent/LArObjects/LArPfoObjects.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
 #include <memory>
 
 namespace lar_pandora
@@ -32,21 +34,53 @@ public:
     LArPandoraTrackCreation & operator = (LArPandoraTrackCreation const &) = delete;
     LArPandoraTrackCreation & operator = (LArPandoraTrackCreation &&) = delete;
 
+    void beginRun(art::Run &run) override;
     void produce(art::Event &evt) override;
 
 private:
     /**
-     *  @brief Build a recob::Track object
+     *  @brief TrackFit class, holding the inputs and results of the sliding fit for a single particle
+     */
+    class TrackFit
+    {
+    public:
+        /**
+         *  @brief Constructor, copying the space point positions so that the fit doesn't access art products
+         *
+         *  @param pPFParticle the particle
+         *  @param pSpacePoints the space points associated with the particle
+         *  @param pClusters the clusters associated with the particle
+         *  @param vertexPosition the position of the vertex associated with the particle
+         */
+        TrackFit(const art::Ptr<recob::PFParticle> &pPFParticle, const SpacePointVector *const pSpacePoints, const ClusterVector *const pClusters,
+            const pandora::CartesianVector &vertexPosition);
+
+        art::Ptr<recob::PFParticle>         m_pPFParticle;              ///< The particle
+        const SpacePointVector             *m_pSpacePoints;             ///< The space points associated with the particle
+        const ClusterVector                *m_pClusters;                ///< The clusters associated with the particle
+        pandora::CartesianPointVector       m_cartesianPointVector;     ///< The space point positions
+        pandora::CartesianVector            m_vertexPosition;           ///< The vertex position
+        lar_content::LArTrackStateVector    m_trackStateVector;         ///< The fitted trajectory points
+        pandora::IntVector                  m_indexVector;              ///< The space point indices in trajectory point order
+        bool                                m_isFitted;                 ///< Whether the sliding fit succeeded
+    };
+
+    typedef std::vector<TrackFit> TrackFitVector;
+
+    /**
+     *  @brief Run the sliding fit of a single particle
      *
-     *  @param id the id code for the track
-     *  @param trackStateVector the vector of trajectory points for this track
+     *  @param trackFit the track fit to run
+     *  @param wirePitchW the length scale used by the sliding fit
      */
-    recob::Track BuildTrack(const int id, const lar_content::LArTrackStateVector &trackStateVector) const;
+    void RunFit(TrackFit &trackFit, const float wirePitchW) const;
 
     std::string     m_pfParticleLabel;              ///< The pf particle label
     unsigned int    m_minTrajectoryPoints;          ///< The minimum number of trajectory points
     unsigned int    m_slidingFitHalfWindow;         ///< The sliding fit half window
     bool            m_useAllParticles;              ///< Build a recob::Track for every recob::PFParticle
+    unsigned int    m_nFitThreads;                  ///< The number of threads used to run the sliding fits
+    float           m_wirePitchW;                   ///< The length scale of the sliding fits, from the geometry constants of the current run
 };
 
 DEFINE_ART_MODULE(LArPandoraTrackCreation)
@@ -64,8 +98,6 @@ DEFINE_ART_MODULE(LArPandoraTrackCreation)
 
 #include "canvas/Utilities/InputTag.h"
 
-#include "larcore/Geometry/Geometry.h"
-
 #include "lardata/Utilities/AssociationUtil.h"
 
 #include "lardataobj/RecoBase/PFParticle.h"
@@ -77,8 +109,11 @@ DEFINE_ART_MODULE(LArPandoraTrackCreation)
 
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
-#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationCache.h"
+#include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+#include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace lar_pandora
@@ -89,7 +124,9 @@ LArPandoraTrackCreation::LArPandoraTrackCreation(fhicl::ParameterSet const &pset
     m_pfParticleLabel(pset.get<std::string>("PFParticleLabel")),
     m_minTrajectoryPoints(pset.get<unsigned int>("MinTrajectoryPoints", 2)),
     m_slidingFitHalfWindow(pset.get<unsigned int>("SlidingFitHalfWindow", 20)),
-    m_useAllParticles(pset.get<bool>("UseAllParticles", false))
+    m_useAllParticles(pset.get<bool>("UseAllParticles", false)),
+    m_nFitThreads(pset.get<unsigned int>("NumberOfFitThreads", 1)),
+    m_wirePitchW(0.f)
 {
     produces< std::vector<recob::Track> >();
     produces< art::Assns<recob::PFParticle, recob::Track> >();
@@ -98,6 +135,17 @@ LArPandoraTrackCreation::LArPandoraTrackCreation(fhicl::ParameterSet const &pset
 
     if (m_minTrajectoryPoints<2) throw cet::exception("LArPandoraTrackCreation") << "MinTrajectoryPoints should not be smaller than 2!";
 
+    if (m_nFitThreads<1) throw cet::exception("LArPandoraTrackCreation") << "NumberOfFitThreads should not be smaller than 1!";
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraTrackCreation::beginRun(art::Run &/*run*/)
+{
+    // 'wirePitchW` is here used only to provide length scale for binning hits and performing sliding/local linear fits.
+    // Fits should be robust against the precise choice, provided length scale is comparable to the granularity of the images.
+    m_wirePitchW = LArPandoraGeometry::LoadGeometryConstants().GetWirePitchW();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -109,56 +157,18 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
     std::unique_ptr< art::Assns<recob::Track, recob::Hit> > outputTracksToHits( new art::Assns<recob::Track, recob::Hit> );
     std::unique_ptr< art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> > outputTracksToHitsWithMeta( new art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> );
 
-    // 'wirePitchW` is here used only to provide length scale for binning hits and performing sliding/local linear fits.
-    // Fits should be robust against the precise choice, provided length scale is comparable to the granularity of the images.
-    art::ServiceHandle<geo::Geometry const> theGeometry;
-    const unsigned int nWirePlanes(theGeometry->MaxPlanes());
-
-    if (nWirePlanes > 3)
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraTrackCreation::produce --- More than three wire planes present ";
-
-    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraTrackCreation::produce --- unable to access first tpc in first cryostat ";
-
-    std::unordered_set<geo::_plane_proj> planeSet;
-    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
-        (void) planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
-
-    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
-    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
-    const bool isDualPhase(theGeometry->MaxPlanes() == 2);
-
-    if (nWirePlanes != planeSet.size())
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- geometry description for wire plane(s) missing ";
-
-    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- dual phase scenario; expect to find w and y views ";
-
-    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) || (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- single phase scenatio; expect to find u and v views; if there is one further view, it must be w or y ";
-
-    const bool useYPlane((nWirePlanes > 2) && planeSet.count(geo::kY));
-
-    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
-    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
-    const float wirePitchU(theGeometry->WirePitch((isDualPhase ? geo::kW : geo::kU)));
-    const float wirePitchV(theGeometry->WirePitch((isDualPhase ? geo::kY : geo::kV)));
-    const float wirePitchW((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) : (useYPlane) ? theGeometry->WirePitch(geo::kY) :
-        theGeometry->WirePitch(geo::kW));
-
     int trackCounter(0);
     const art::PtrMaker<recob::Track> makeTrackPtr(evt);
 
     // Organise inputs
-    PFParticleVector pfParticleVector, extraPfParticleVector;
-    PFParticlesToSpacePoints pfParticlesToSpacePoints;
-    PFParticlesToClusters pfParticlesToClusters;
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
+    PFParticleAssociations pfParticleAssociations;
+    LArPandoraHelper::CollectPFParticleAssociations(evt, m_pfParticleLabel, LArPandoraHelper::kSpacePointAssociations |
+        LArPandoraHelper::kClusterAssociations | LArPandoraHelper::kVertexAssociations, pfParticleAssociations);
+    const PFParticleVector &pfParticleVector(pfParticleAssociations.GetParticles());
 
-    VertexVector vertexVector;
-    PFParticlesToVertices pfParticlesToVertices;
-    LArPandoraHelper::CollectVertices(evt, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
+    // Collect the inputs of each fit, in particle order
+    TrackFitVector trackFits;
+    trackFits.reserve(pfParticleVector.size());
 
     for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector)
     {
@@ -167,49 +177,52 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
             continue;
 
         // Obtain associated spacepoints
-        PFParticlesToSpacePoints::const_iterator particleToSpacePointIter(pfParticlesToSpacePoints.find(pPFParticle));
+        const SpacePointVector &spacePointVector(pfParticleAssociations.GetSpacePoints(pPFParticle));
 
-        if (pfParticlesToSpacePoints.end() == particleToSpacePointIter)
+        if (spacePointVector.empty())
         {
             mf::LogDebug("LArPandoraTrackCreation") << "No spacepoints associated to particle ";
             continue;
         }
 
         // Obtain associated clusters
-        PFParticlesToClusters::const_iterator particleToClustersIter(pfParticlesToClusters.find(pPFParticle));
+        const ClusterVector &clusterVector(pfParticleAssociations.GetClusters(pPFParticle));
 
-        if (pfParticlesToClusters.end() == particleToClustersIter)
+        if (clusterVector.empty())
         {
             mf::LogDebug("LArPandoraShowerCreation") << "No clusters associated to particle ";
             continue;
         }
 
         // Obtain associated vertex
-        PFParticlesToVertices::const_iterator particleToVertexIter(pfParticlesToVertices.find(pPFParticle));
+        const VertexVector &vertexVector(pfParticleAssociations.GetVertices(pPFParticle));
 
-        if ((pfParticlesToVertices.end() == particleToVertexIter) || (1 != particleToVertexIter->second.size()))
+        if (1 != vertexVector.size())
         {
             mf::LogDebug("LArPandoraTrackCreation") << "Unexpected number of vertices for particle ";
             continue;
         }
 
-        // Copy information into expected pandora form
-        pandora::CartesianPointVector cartesianPointVector;
-        for (const art::Ptr<recob::SpacePoint> spacePoint : particleToSpacePointIter->second)
-            cartesianPointVector.emplace_back(pandora::CartesianVector(spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
-
         double vertexXYZ[3] = {0., 0., 0.};
-        particleToVertexIter->second.front()->XYZ(vertexXYZ);
+        vertexVector.front()->XYZ(vertexXYZ);
         const pandora::CartesianVector vertexPosition(vertexXYZ[0], vertexXYZ[1], vertexXYZ[2]);
 
-        // Call pandora "fast" track fitter
-        lar_content::LArTrackStateVector trackStateVector;
-        pandora::IntVector indexVector;
-        try
-        {
-            lar_content::LArPfoHelper::GetSlidingFitTrajectory(cartesianPointVector, vertexPosition, m_slidingFitHalfWindow, wirePitchW, trackStateVector, &indexVector);
-        }
-        catch (const pandora::StatusCodeException &)
+        trackFits.emplace_back(pPFParticle, &spacePointVector, &clusterVector, vertexPosition);
+    }
+
+    // Call pandora "fast" track fitter for every particle
+    LArPandoraOutput::RunFits(trackFits, m_nFitThreads, [this](TrackFit &trackFit) {this->RunFit(trackFit, m_wirePitchW);});
+
+    // ATTN the products and associations are written serially, in particle order, so the output doesn't depend on the number of threads
+    LArPandoraAssociationCache associationCache(evt);
+
+    for (TrackFit &trackFit : trackFits)
+    {
+        const art::Ptr<recob::PFParticle> pPFParticle(trackFit.m_pPFParticle);
+        lar_content::LArTrackStateVector &trackStateVector(trackFit.m_trackStateVector);
+        const pandora::IntVector &indexVector(trackFit.m_indexVector);
+
+        if (!trackFit.m_isFitted)
         {
             mf::LogDebug("LArPandoraTrackCreation") << "Unable to extract sliding fit trajectory";
             continue;
@@ -222,50 +235,18 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
         }
 
         HitVector hitsFromSpacePoints, hitsFromClusters, hitsInParticle;
-        HitSet hitsInParticleSet;
-
-        LArPandoraHelper::GetAssociatedHits(evt, m_pfParticleLabel, particleToSpacePointIter->second, hitsFromSpacePoints, &indexVector);
-        LArPandoraHelper::GetAssociatedHits(evt, m_pfParticleLabel, particleToClustersIter->second, hitsFromClusters);
-        //ATTN: hits ordered from space points if available, rest added at the end
-        for (unsigned int hitIndex = 0; hitIndex < hitsFromSpacePoints.size(); hitIndex++)
-        {
-	    hitsInParticle.push_back(hitsFromSpacePoints.at(hitIndex));
-            (void) hitsInParticleSet.insert(hitsFromSpacePoints.at(hitIndex));
-        }
-
-        for (unsigned int hitIndex = 0; hitIndex < hitsFromClusters.size(); hitIndex++)
-        {
-            if (hitsInParticleSet.count(hitsFromClusters.at(hitIndex)) == 0)
-                hitsInParticle.push_back(hitsFromClusters.at(hitIndex));
-        }
-
-        // Add invalid points at the end of the vector, so that the number of the trajectory points is the same as the number of hits
-        if (trackStateVector.size()>hitsFromSpacePoints.size())
-        {
-            throw cet::exception("LArPandoraTrackCreation") << "trackStateVector.size() is greater than hitsFromSpacePoints.size()";
-        }
-        const unsigned int nInvalidPoints = hitsInParticle.size()-trackStateVector.size();
-        for (unsigned int i=0;i<nInvalidPoints;++i) {
-            trackStateVector.push_back(lar_content::LArTrackState(pandora::CartesianVector(util::kBogusF,util::kBogusF,util::kBogusF),
-                                                                  pandora::CartesianVector(util::kBogusF,util::kBogusF,util::kBogusF), nullptr));
-        }
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, *trackFit.m_pSpacePoints, hitsFromSpacePoints, &indexVector);
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, *trackFit.m_pClusters, hitsFromClusters);
+        LArPandoraOutput::GetTrackHits(hitsFromSpacePoints, hitsFromClusters, trackStateVector, hitsInParticle);
 
         // Output objects
-        outputTracks->emplace_back(LArPandoraTrackCreation::BuildTrack(trackCounter++, trackStateVector));
+        outputTracks->emplace_back(LArPandoraOutput::BuildTrack(trackCounter++, trackStateVector));
         art::Ptr<recob::Track> pTrack(makeTrackPtr(outputTracks->size() - 1));
 
         // Output associations, after output objects are in place
         util::CreateAssn(*this, evt, pTrack, pPFParticle, *(outputParticlesToTracks.get()));
         util::CreateAssn(*this, evt, *(outputTracks.get()), hitsInParticle, *(outputTracksToHits.get()));
-
-	//ATTN: metadata added with index from space points if available, null for others
-        for (unsigned int hitIndex = 0; hitIndex < hitsInParticle.size(); hitIndex++)
-        {
-            const art::Ptr<recob::Hit> pHit(hitsInParticle.at(hitIndex));
-            const int index((hitIndex < hitsFromSpacePoints.size()) ? hitIndex : std::numeric_limits<int>::max());
-            recob::TrackHitMeta metadata(index, -std::numeric_limits<double>::max());
-            outputTracksToHitsWithMeta->addSingle(pTrack, pHit, metadata);
-        }
+        LArPandoraOutput::AddTrackHitMetadata(pTrack, hitsInParticle, hitsFromSpacePoints.size(), outputTracksToHitsWithMeta);
     }
 
     mf::LogDebug("LArPandoraTrackCreation") << "Number of new tracks: " << outputTracks->size() << std::endl;
@@ -278,33 +259,28 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-recob::Track LArPandoraTrackCreation::BuildTrack(const int id, const lar_content::LArTrackStateVector &trackStateVector) const
+void LArPandoraTrackCreation::RunFit(TrackFit &trackFit, const float wirePitchW) const
 {
-    if (trackStateVector.empty())
-        throw cet::exception("LArPandoraTrackCreation") << "BuildTrack - No input trajectory points provided ";
+    trackFit.m_isFitted = LArPandoraOutput::GetSlidingFitTrajectory(trackFit.m_cartesianPointVector, trackFit.m_vertexPosition, m_slidingFitHalfWindow,
+        wirePitchW, trackFit.m_trackStateVector, trackFit.m_indexVector);
+}
 
-    recob::tracking::Positions_t xyz;
-    recob::tracking::Momenta_t pxpypz;
-    recob::TrackTrajectory::Flags_t flags;
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-    for (const lar_content::LArTrackState &trackState : trackStateVector)
-    {
-        xyz.emplace_back(recob::tracking::Point_t(trackState.GetPosition().GetX(), trackState.GetPosition().GetY(), trackState.GetPosition().GetZ()));
-        pxpypz.emplace_back(recob::tracking::Vector_t(trackState.GetDirection().GetX(), trackState.GetDirection().GetY(), trackState.GetDirection().GetZ()));
-        // Set flag NoPoint if point has bogus coordinates, otherwise use clean flag set
-        if (std::fabs(trackState.GetPosition().GetX()-util::kBogusF)<std::numeric_limits<float>::epsilon() &&
-            std::fabs(trackState.GetPosition().GetY()-util::kBogusF)<std::numeric_limits<float>::epsilon() &&
-            std::fabs(trackState.GetPosition().GetZ()-util::kBogusF)<std::numeric_limits<float>::epsilon())
-        {
-            flags.emplace_back(recob::TrajectoryPointFlags(recob::TrajectoryPointFlags::InvalidHitIndex, recob::TrajectoryPointFlagTraits::NoPoint));
-        } else {
-            flags.emplace_back(recob::TrajectoryPointFlags());
-        }
-    }
+LArPandoraTrackCreation::TrackFit::TrackFit(const art::Ptr<recob::PFParticle> &pPFParticle, const SpacePointVector *const pSpacePoints,
+        const ClusterVector *const pClusters, const pandora::CartesianVector &vertexPosition) :
+    m_pPFParticle(pPFParticle),
+    m_pSpacePoints(pSpacePoints),
+    m_pClusters(pClusters),
+    m_vertexPosition(vertexPosition),
+    m_isFitted(false)
+{
+    // Copy information into expected pandora form
+    m_cartesianPointVector.reserve(pSpacePoints->size());
 
-    // note from gc: eventually we should produce a TrackTrajectory, not a Track with empty covariance matrix and bogus chi2, etc.
-    return recob::Track(recob::TrackTrajectory(std::move(xyz), std::move(pxpypz), std::move(flags), false),
-                        util::kBogusI, util::kBogusF, util::kBogusI, recob::tracking::SMatrixSym55(), recob::tracking::SMatrixSym55(), id);
+    for (const art::Ptr<recob::SpacePoint> &spacePoint : *pSpacePoints)
+        m_cartesianPointVector.emplace_back(pandora::CartesianVector(spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
 }
 
 } // namespace lar_pandora
@@ -0,0 +1,361 @@
+/**
+ *  @file   larpandora/LArPandoraEventBuilding/LArPandoraTrackShowerCreation_module.cc
+ *
+ *  @brief  module for lar pandora track and shower creation in a single pass over the inputs
+ */
+
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+
+#include "fhiclcpp/ParameterSet.h"
+
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/PCAxis.h"
+#include "lardataobj/RecoBase/Shower.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
+
+#include "larpandoracontent/LArObjects/LArPfoObjects.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraShowerPCA.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <memory>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  Producer writing the products of both LArPandoraTrackCreation and LArPandoraShowerCreation, from a single collection of the
+ *          PFParticles and their associations. The track fits and shower pcas are run together, in parallel if more than one thread is
+ *          requested. As for those modules, UseAllParticles fits every particle both as a track and as a shower.
+ */
+class LArPandoraTrackShowerCreation : public art::EDProducer
+{
+public:
+    explicit LArPandoraTrackShowerCreation(fhicl::ParameterSet const &pset);
+
+    LArPandoraTrackShowerCreation(LArPandoraTrackShowerCreation const &) = delete;
+    LArPandoraTrackShowerCreation(LArPandoraTrackShowerCreation &&) = delete;
+    LArPandoraTrackShowerCreation & operator = (LArPandoraTrackShowerCreation const &) = delete;
+    LArPandoraTrackShowerCreation & operator = (LArPandoraTrackShowerCreation &&) = delete;
+
+    void beginRun(art::Run &run) override;
+    void produce(art::Event &evt) override;
+
+private:
+    /**
+     *  @brief ParticleFit class, holding the inputs and results of the track fit or shower pca for a single particle
+     */
+    class ParticleFit
+    {
+    public:
+        /**
+         *  @brief Constructor, copying the space point positions so that the fit doesn't access art products
+         *
+         *  @param pPFParticle the particle
+         *  @param isTrack whether to fit the particle as a track, rather than a shower
+         *  @param pSpacePoints the space points associated with the particle
+         *  @param pClusters the clusters associated with the particle
+         *  @param vertexPosition the position of the vertex associated with the particle
+         */
+        ParticleFit(const art::Ptr<recob::PFParticle> &pPFParticle, const bool isTrack, const SpacePointVector *const pSpacePoints,
+            const ClusterVector *const pClusters, const pandora::CartesianVector &vertexPosition);
+
+        art::Ptr<recob::PFParticle>                 m_pPFParticle;              ///< The particle
+        bool                                        m_isTrack;                  ///< Whether the particle is fitted as a track, rather than a shower
+        const SpacePointVector                     *m_pSpacePoints;             ///< The space points associated with the particle
+        const ClusterVector                        *m_pClusters;                ///< The clusters associated with the particle
+        pandora::CartesianPointVector               m_cartesianPointVector;     ///< The space point positions
+        pandora::CartesianVector                    m_vertexPosition;           ///< The vertex position, projected onto the primary axis for showers
+        lar_content::LArTrackStateVector            m_trackStateVector;         ///< The fitted trajectory points, for tracks
+        pandora::IntVector                          m_indexVector;              ///< The space point indices in trajectory point order, for tracks
+        std::unique_ptr<lar_content::LArShowerPCA>  m_pLArShowerPCA;            ///< The oriented shower pca, for showers
+        bool                                        m_isFitted;                 ///< Whether the track fit or shower pca succeeded
+    };
+
+    typedef std::vector<ParticleFit> ParticleFitVector;
+
+    /**
+     *  @brief Run the track fit or shower pca of a single particle
+     *
+     *  @param particleFit the fit to run
+     *  @param wirePitchW the length scale used by the sliding fit
+     */
+    void RunFit(ParticleFit &particleFit, const float wirePitchW);
+
+    std::string                         m_pfParticleLabel;              ///< The pf particle label
+    unsigned int                        m_minTrajectoryPoints;          ///< The minimum number of trajectory points
+    unsigned int                        m_slidingFitHalfWindow;         ///< The sliding fit half window
+    bool                                m_useAllParticles;              ///< Build a recob::Track and a recob::Shower for every recob::PFParticle
+    bool                                m_useSinglePassPCA;             ///< Whether to use the single-pass pca in place of the pandora pca
+    unsigned int                        m_nFitThreads;                  ///< The number of threads used to run the fits
+    float                               m_wirePitchW;                   ///< The length scale of the sliding fits, from the geometry constants of the current run
+    tbb::enumerable_thread_specific<LArPandoraShowerPCA> m_showerPCAs;  ///< The single-pass pca of each thread, kept to reuse their arrays
+};
+
+DEFINE_ART_MODULE(LArPandoraTrackShowerCreation)
+
+} // namespace lar_pandora
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+// implementation follows
+
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Run.h"
+
+#include "art/Persistency/Common/PtrMaker.h"
+
+#include "lardata/Utilities/AssociationUtil.h"
+
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/Vertex.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "larpandoracontent/LArHelpers/LArPfoHelper.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationCache.h"
+#include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+#include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
+
+#include <algorithm>
+
+namespace lar_pandora
+{
+
+LArPandoraTrackShowerCreation::LArPandoraTrackShowerCreation(fhicl::ParameterSet const &pset) :
+    EDProducer{pset},
+    m_pfParticleLabel(pset.get<std::string>("PFParticleLabel")),
+    m_minTrajectoryPoints(pset.get<unsigned int>("MinTrajectoryPoints", 2)),
+    m_slidingFitHalfWindow(pset.get<unsigned int>("SlidingFitHalfWindow", 20)),
+    m_useAllParticles(pset.get<bool>("UseAllParticles", false)),
+    m_useSinglePassPCA(pset.get<bool>("UseSinglePassPCA", false)),
+    m_nFitThreads(pset.get<unsigned int>("NumberOfFitThreads", 1)),
+    m_wirePitchW(0.f)
+{
+    produces< std::vector<recob::Track> >();
+    produces< art::Assns<recob::PFParticle, recob::Track> >();
+    produces< art::Assns<recob::Track, recob::Hit> >();
+    produces< art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> >();
+
+    produces< std::vector<recob::Shower> >();
+    produces< std::vector<recob::PCAxis> >();
+    produces< art::Assns<recob::PFParticle, recob::Shower> >();
+    produces< art::Assns<recob::PFParticle, recob::PCAxis> >();
+    produces< art::Assns<recob::Shower, recob::Hit> >();
+    produces< art::Assns<recob::Shower, recob::PCAxis> >();
+
+    if (m_minTrajectoryPoints < 2)
+        throw cet::exception("LArPandora") << " LArPandoraTrackShowerCreation --- MinTrajectoryPoints should not be smaller than 2 ";
+
+    if (m_nFitThreads < 1)
+        throw cet::exception("LArPandora") << " LArPandoraTrackShowerCreation --- NumberOfFitThreads should not be smaller than 1 ";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraTrackShowerCreation::beginRun(art::Run &/*run*/)
+{
+    // 'wirePitchW` is here used only to provide length scale for binning hits and performing sliding/local linear fits.
+    // Fits should be robust against the precise choice, provided length scale is comparable to the granularity of the images.
+    m_wirePitchW = LArPandoraGeometry::LoadGeometryConstants().GetWirePitchW();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraTrackShowerCreation::produce(art::Event &evt)
+{
+    std::unique_ptr< std::vector<recob::Track> > outputTracks( new std::vector<recob::Track> );
+    std::unique_ptr< art::Assns<recob::PFParticle, recob::Track> > outputParticlesToTracks( new art::Assns<recob::PFParticle, recob::Track> );
+    std::unique_ptr< art::Assns<recob::Track, recob::Hit> > outputTracksToHits( new art::Assns<recob::Track, recob::Hit> );
+    std::unique_ptr< art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> > outputTracksToHitsWithMeta( new art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> );
+
+    std::unique_ptr< std::vector<recob::Shower> > outputShowers( new std::vector<recob::Shower> );
+    std::unique_ptr< std::vector<recob::PCAxis> > outputPCAxes( new std::vector<recob::PCAxis> );
+    std::unique_ptr< art::Assns<recob::PFParticle, recob::Shower> > outputParticlesToShowers( new art::Assns<recob::PFParticle, recob::Shower> );
+    std::unique_ptr< art::Assns<recob::PFParticle, recob::PCAxis> > outputParticlesToPCAxes( new art::Assns<recob::PFParticle, recob::PCAxis> );
+    std::unique_ptr< art::Assns<recob::Shower, recob::Hit> > outputShowersToHits( new art::Assns<recob::Shower, recob::Hit> );
+    std::unique_ptr< art::Assns<recob::Shower, recob::PCAxis> > outputShowersToPCAxes( new art::Assns<recob::Shower, recob::PCAxis> );
+
+    const art::PtrMaker<recob::Track> makeTrackPtr(evt);
+    const art::PtrMaker<recob::Shower> makeShowerPtr(evt);
+    const art::PtrMaker<recob::PCAxis> makePCAxisPtr(evt);
+
+    // Organise inputs, reading the particles and their associations once for both tracks and showers
+    PFParticleAssociations pfParticleAssociations;
+    LArPandoraHelper::CollectPFParticleAssociations(evt, m_pfParticleLabel, LArPandoraHelper::kSpacePointAssociations |
+        LArPandoraHelper::kClusterAssociations | LArPandoraHelper::kVertexAssociations, pfParticleAssociations);
+    const PFParticleVector &pfParticleVector(pfParticleAssociations.GetParticles());
+
+    // Collect the inputs of each fit, in particle order
+    ParticleFitVector particleFits;
+    particleFits.reserve(m_useAllParticles ? 2 * pfParticleVector.size() : pfParticleVector.size());
+
+    for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector)
+    {
+        const bool isTrack(LArPandoraHelper::IsTrack(pPFParticle));
+
+        if (!m_useAllParticles && !isTrack && !LArPandoraHelper::IsShower(pPFParticle))
+            continue;
+
+        const SpacePointVector &spacePointVector(pfParticleAssociations.GetSpacePoints(pPFParticle));
+
+        if (spacePointVector.empty())
+        {
+            mf::LogDebug("LArPandoraTrackShowerCreation") << "No spacepoints associated to particle ";
+            continue;
+        }
+
+        const ClusterVector &clusterVector(pfParticleAssociations.GetClusters(pPFParticle));
+
+        if (clusterVector.empty())
+        {
+            mf::LogDebug("LArPandoraTrackShowerCreation") << "No clusters associated to particle ";
+            continue;
+        }
+
+        const VertexVector &vertexVector(pfParticleAssociations.GetVertices(pPFParticle));
+
+        if (1 != vertexVector.size())
+        {
+            mf::LogDebug("LArPandoraTrackShowerCreation") << "Unexpected number of vertices for particle ";
+            continue;
+        }
+
+        double vertexXYZ[3] = {0., 0., 0.};
+        vertexVector.front()->XYZ(vertexXYZ);
+        const pandora::CartesianVector vertexPosition(vertexXYZ[0], vertexXYZ[1], vertexXYZ[2]);
+
+        // ATTN with UseAllParticles a particle gets both a track fit and a shower pca, as if both separate modules had run
+        if (m_useAllParticles || isTrack)
+            particleFits.emplace_back(pPFParticle, true, &spacePointVector, &clusterVector, vertexPosition);
+
+        if (m_useAllParticles || !isTrack)
+            particleFits.emplace_back(pPFParticle, false, &spacePointVector, &clusterVector, vertexPosition);
+    }
+
+    // Call pandora "fast" track and shower fitters for every particle
+    LArPandoraOutput::RunFits(particleFits, m_nFitThreads, [this](ParticleFit &particleFit) {this->RunFit(particleFit, m_wirePitchW);});
+
+    // ATTN the products and associations are written serially, in particle order, so the output doesn't depend on the number of threads
+    LArPandoraAssociationCache associationCache(evt);
+    int trackCounter(0), showerCounter(0);
+
+    for (ParticleFit &particleFit : particleFits)
+    {
+        const art::Ptr<recob::PFParticle> pPFParticle(particleFit.m_pPFParticle);
+
+        if (!particleFit.m_isFitted)
+        {
+            mf::LogDebug("LArPandoraTrackShowerCreation") << (particleFit.m_isTrack ? "Unable to extract sliding fit trajectory" : "Unable to extract shower pca");
+            continue;
+        }
+
+        if (!particleFit.m_isTrack)
+        {
+            outputShowers->emplace_back(LArPandoraOutput::BuildShower(showerCounter++, *particleFit.m_pLArShowerPCA, particleFit.m_vertexPosition));
+            outputPCAxes->emplace_back(LArPandoraOutput::BuildPCAxis(*particleFit.m_pLArShowerPCA));
+
+            art::Ptr<recob::Shower> pShower(makeShowerPtr(outputShowers->size() - 1));
+            art::Ptr<recob::PCAxis> pPCAxis(makePCAxisPtr(outputPCAxes->size() - 1));
+
+            HitVector hitsInParticle;
+            LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, *particleFit.m_pClusters, hitsInParticle);
+
+            util::CreateAssn(*this, evt, pShower, pPFParticle, *(outputParticlesToShowers.get()));
+            util::CreateAssn(*this, evt, pPCAxis, pPFParticle, *(outputParticlesToPCAxes.get()));
+            util::CreateAssn(*this, evt, *(outputShowers.get()), hitsInParticle, *(outputShowersToHits.get()));
+            util::CreateAssn(*this, evt, pPCAxis, pShower, *(outputShowersToPCAxes.get()));
+            continue;
+        }
+
+        lar_content::LArTrackStateVector &trackStateVector(particleFit.m_trackStateVector);
+
+        if (trackStateVector.size() < m_minTrajectoryPoints)
+        {
+            mf::LogDebug("LArPandoraTrackShowerCreation") << "Insufficient input trajectory points to build track: " << trackStateVector.size();
+            continue;
+        }
+
+        HitVector hitsFromSpacePoints, hitsFromClusters, hitsInParticle;
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, *particleFit.m_pSpacePoints, hitsFromSpacePoints, &particleFit.m_indexVector);
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, *particleFit.m_pClusters, hitsFromClusters);
+        LArPandoraOutput::GetTrackHits(hitsFromSpacePoints, hitsFromClusters, trackStateVector, hitsInParticle);
+
+        outputTracks->emplace_back(LArPandoraOutput::BuildTrack(trackCounter++, trackStateVector));
+        art::Ptr<recob::Track> pTrack(makeTrackPtr(outputTracks->size() - 1));
+
+        util::CreateAssn(*this, evt, pTrack, pPFParticle, *(outputParticlesToTracks.get()));
+        util::CreateAssn(*this, evt, *(outputTracks.get()), hitsInParticle, *(outputTracksToHits.get()));
+        LArPandoraOutput::AddTrackHitMetadata(pTrack, hitsInParticle, hitsFromSpacePoints.size(), outputTracksToHitsWithMeta);
+    }
+
+    mf::LogDebug("LArPandoraTrackShowerCreation") << "Number of new tracks: " << outputTracks->size() << ", showers: " << outputShowers->size();
+
+    evt.put(std::move(outputTracks));
+    evt.put(std::move(outputTracksToHits));
+    evt.put(std::move(outputTracksToHitsWithMeta));
+    evt.put(std::move(outputParticlesToTracks));
+
+    evt.put(std::move(outputShowers));
+    evt.put(std::move(outputPCAxes));
+    evt.put(std::move(outputParticlesToShowers));
+    evt.put(std::move(outputParticlesToPCAxes));
+    evt.put(std::move(outputShowersToHits));
+    evt.put(std::move(outputShowersToPCAxes));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraTrackShowerCreation::RunFit(ParticleFit &particleFit, const float wirePitchW)
+{
+    if (particleFit.m_isTrack)
+    {
+        particleFit.m_isFitted = LArPandoraOutput::GetSlidingFitTrajectory(particleFit.m_cartesianPointVector, particleFit.m_vertexPosition,
+            m_slidingFitHalfWindow, wirePitchW, particleFit.m_trackStateVector, particleFit.m_indexVector);
+        return;
+    }
+
+    try
+    {
+        // ATTN each thread has its own single-pass pca, which tbb creates the first time the thread asks for it
+        const lar_content::LArShowerPCA initialLArShowerPCA(m_useSinglePassPCA ?
+            m_showerPCAs.local().GetPrincipalComponents(particleFit.m_cartesianPointVector, particleFit.m_vertexPosition) :
+            lar_content::LArPfoHelper::GetPrincipalComponents(particleFit.m_cartesianPointVector, particleFit.m_vertexPosition));
+
+        const pandora::CartesianVector vertexPosition(particleFit.m_vertexPosition);
+        particleFit.m_pLArShowerPCA.reset(new lar_content::LArShowerPCA(LArPandoraOutput::OrientShowerPCA(initialLArShowerPCA, vertexPosition,
+            particleFit.m_vertexPosition)));
+        particleFit.m_isFitted = true;
+    }
+    catch (const pandora::StatusCodeException &)
+    {
+        particleFit.m_isFitted = false;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraTrackShowerCreation::ParticleFit::ParticleFit(const art::Ptr<recob::PFParticle> &pPFParticle, const bool isTrack,
+        const SpacePointVector *const pSpacePoints, const ClusterVector *const pClusters, const pandora::CartesianVector &vertexPosition) :
+    m_pPFParticle(pPFParticle),
+    m_isTrack(isTrack),
+    m_pSpacePoints(pSpacePoints),
+    m_pClusters(pClusters),
+    m_vertexPosition(vertexPosition),
+    m_isFitted(false)
+{
+    // Copy information into expected pandora form
+    m_cartesianPointVector.reserve(pSpacePoints->size());
+
+    for (const art::Ptr<recob::SpacePoint> &spacePoint : *pSpacePoints)
+        m_cartesianPointVector.emplace_back(pandora::CartesianVector(spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
+}
+
+} // namespace lar_pandora
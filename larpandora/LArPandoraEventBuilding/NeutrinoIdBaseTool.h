@@ -10,6 +10,7 @@
 #include "art/Framework/Principal/Event.h"
 
 #include "larpandora/LArPandoraEventBuilding/Slice.h"
+#include "larpandora/LArPandoraEventBuilding/SliceFeatureMatrix.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
 namespace lar_pandora
@@ -30,8 +31,38 @@ public:
      *  @param  evt the art event
      */
     virtual void ClassifySlices(SliceVector &slices, const art::Event &evt) = 0;
+
+    /**
+     *  @brief  The batched interface function, receiving the features of all slices as computed once by the calling module. Tools that
+     *          can score from the features alone should override this to avoid revisiting the event. By default it calls ClassifySlices
+     *
+     *  @param  slices the input vector of slices to classify
+     *  @param  features the features of the input slices, in slice order
+     *  @param  evt the art event
+     */
+    virtual void ClassifySliceBatch(SliceVector &slices, const SliceFeatureMatrix &features, const art::Event &evt);
+
+    /**
+     *  @brief  Whether the tool reads slice features other than kNuScore, which is always filled. The calling module only reads the
+     *          associations needed for the other features if a tool asks for them. By default false
+     */
+    virtual bool NeedsSliceFeatures() const;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void NeutrinoIdBaseTool::ClassifySliceBatch(SliceVector &slices, const SliceFeatureMatrix &/*features*/, const art::Event &evt)
+{
+    this->ClassifySlices(slices, evt);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool NeutrinoIdBaseTool::NeedsSliceFeatures() const
+{
+    return false;
+}
+
 } // namespace lar_pandora
 
 #endif // #ifndef LAR_PANDORA_NEUTRINO_ID_BASE_TOOL_H
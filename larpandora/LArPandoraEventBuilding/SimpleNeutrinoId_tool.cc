@@ -6,10 +6,13 @@
 
 #include "art/Utilities/ToolMacros.h"
 #include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "larpandora/LArPandoraEventBuilding/NeutrinoIdBaseTool.h"
 #include "larpandora/LArPandoraEventBuilding/Slice.h"
 
+#include <limits>
+
 namespace lar_pandora
 {
 
@@ -33,6 +36,24 @@ public:
      *  @param  evt the art event
      */
     void ClassifySlices(SliceVector &slices, const art::Event &evt) override;
+
+    /**
+     *  @brief  Classify slices as neutrino or cosmic, using the precomputed slice features
+     *
+     *  @param  slices the input vector of slices to classify
+     *  @param  features the features of the input slices
+     *  @param  evt the art event
+     */
+    void ClassifySliceBatch(SliceVector &slices, const SliceFeatureMatrix &features, const art::Event &evt) override;
+
+private:
+    /**
+     *  @brief  Tag the slice with the highest neutrino score as a neutrino
+     *
+     *  @param  slices the input vector of slices to classify
+     *  @param  nuScores the neutrino score of each slice
+     */
+    void TagMostProbableSlice(SliceVector &slices, const float *const nuScores) const;
 };
 
 DEFINE_ART_CLASS_TOOL(SimpleNeutrinoId)
@@ -52,6 +73,29 @@ SimpleNeutrinoId::SimpleNeutrinoId(fhicl::ParameterSet const &/*pset*/)
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void SimpleNeutrinoId::ClassifySlices(SliceVector &slices, const art::Event &/*evt*/)
+{
+    std::vector<float> nuScores;
+    nuScores.reserve(slices.size());
+
+    for (const Slice &slice : slices)
+        nuScores.push_back(slice.GetNeutrinoScore());
+
+    this->TagMostProbableSlice(slices, nuScores.data());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void SimpleNeutrinoId::ClassifySliceBatch(SliceVector &slices, const SliceFeatureMatrix &features, const art::Event &/*evt*/)
+{
+    if (features.GetNumberOfSlices() != slices.size())
+        throw cet::exception("LArPandora") << " SimpleNeutrinoId::ClassifySliceBatch --- the slice features don't match the slices ";
+
+    this->TagMostProbableSlice(slices, features.GetFeature(SliceFeatureMatrix::kNuScore));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void SimpleNeutrinoId::TagMostProbableSlice(SliceVector &slices, const float *const nuScores) const
 {
     if (slices.empty()) return;
 
@@ -61,8 +105,9 @@ void SimpleNeutrinoId::ClassifySlices(SliceVector &slices, const art::Event &/*e
 
     for (unsigned int sliceIndex = 0; sliceIndex < slices.size(); ++sliceIndex)
     {
-        const float nuScore(slices.at(sliceIndex).GetNeutrinoScore());
-        std::cout << "Slice " << sliceIndex << " - " << nuScore << std::endl;
+        const float nuScore(nuScores[sliceIndex]);
+        mf::LogDebug("SimpleNeutrinoId") << "Slice " << sliceIndex << " - " << nuScore;
+
         if (nuScore > highestNuScore)
         {
             highestNuScore = nuScore;
@@ -70,7 +115,7 @@ void SimpleNeutrinoId::ClassifySlices(SliceVector &slices, const art::Event &/*e
         }
     }
 
-    std::cout << "Tagging slice " << mostProbableSliceIndex << std::endl;
+    mf::LogDebug("SimpleNeutrinoId") << "Tagging slice " << mostProbableSliceIndex;
 
     // Tag the most probable slice as a neutrino
     slices.at(mostProbableSliceIndex).TagAsNeutrino();
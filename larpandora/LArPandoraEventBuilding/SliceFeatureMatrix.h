@@ -0,0 +1,149 @@
+/**
+ *  @file   larpandora/LArPandoraEventBuilding/SliceFeatureMatrix.h
+ *
+ *  @brief  header for the lar pandora slice feature matrix class
+ */
+
+#ifndef LAR_PANDORA_SLICE_FEATURE_MATRIX_H
+#define LAR_PANDORA_SLICE_FEATURE_MATRIX_H 1
+
+#include "cetlib_except/exception.h"
+
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  SliceFeatureMatrix class
+ *
+ *  Holds the common features of each slice, computed once per event and shared by the neutrino id tools. The features are stored by
+ *  column, so the values of a single feature for all slices are contiguous and can be scored in a single loop.
+ */
+class SliceFeatureMatrix
+{
+public:
+    /**
+     *  @brief  The features of a slice
+     */
+    enum SliceFeature
+    {
+        kNuScore = 0,           ///< The neutrino score from Pandora
+        kNHitsU,                ///< The number of hits in the U view
+        kNHitsV,                ///< The number of hits in the V view
+        kNHitsW,                ///< The number of hits in the W view
+        kNSpacePoints,          ///< The number of space points
+        kMinX,                  ///< The minimum space point x coordinate
+        kMaxX,                  ///< The maximum space point x coordinate
+        kMinY,                  ///< The minimum space point y coordinate
+        kMaxY,                  ///< The maximum space point y coordinate
+        kMinZ,                  ///< The minimum space point z coordinate
+        kMaxZ,                  ///< The maximum space point z coordinate
+        kHasVertex,             ///< Whether the neutrino has a vertex (1) or not (0)
+        kVertexX,               ///< The neutrino vertex x coordinate
+        kVertexY,               ///< The neutrino vertex y coordinate
+        kVertexZ,               ///< The neutrino vertex z coordinate
+        kNSliceFeatures         ///< The number of features
+    };
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  nSlices the number of slices
+     */
+    SliceFeatureMatrix(const size_t nSlices = 0);
+
+    /**
+     *  @brief  Get the number of slices
+     */
+    size_t GetNumberOfSlices() const;
+
+    /**
+     *  @brief  Get the value of a feature for a slice
+     *
+     *  @param  sliceIndex the index of the slice
+     *  @param  feature the feature
+     */
+    float GetValue(const size_t sliceIndex, const SliceFeature feature) const;
+
+    /**
+     *  @brief  Set the value of a feature for a slice
+     *
+     *  @param  sliceIndex the index of the slice
+     *  @param  feature the feature
+     *  @param  value the value
+     */
+    void SetValue(const size_t sliceIndex, const SliceFeature feature, const float value);
+
+    /**
+     *  @brief  Get the values of a feature for all slices, in slice order
+     *
+     *  @param  feature the feature
+     */
+    const float *GetFeature(const SliceFeature feature) const;
+
+private:
+    /**
+     *  @brief  Get the position of a value in the matrix
+     *
+     *  @param  sliceIndex the index of the slice
+     *  @param  feature the feature
+     */
+    size_t GetPosition(const size_t sliceIndex, const SliceFeature feature) const;
+
+    size_t              m_nSlices;      ///< The number of slices
+    std::vector<float>  m_values;       ///< The feature values, stored by column
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline SliceFeatureMatrix::SliceFeatureMatrix(const size_t nSlices) :
+    m_nSlices(nSlices),
+    m_values(nSlices * kNSliceFeatures, 0.f)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline size_t SliceFeatureMatrix::GetNumberOfSlices() const
+{
+    return m_nSlices;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float SliceFeatureMatrix::GetValue(const size_t sliceIndex, const SliceFeature feature) const
+{
+    return m_values[this->GetPosition(sliceIndex, feature)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline void SliceFeatureMatrix::SetValue(const size_t sliceIndex, const SliceFeature feature, const float value)
+{
+    m_values[this->GetPosition(sliceIndex, feature)] = value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const float *SliceFeatureMatrix::GetFeature(const SliceFeature feature) const
+{
+    if (feature >= kNSliceFeatures)
+        throw cet::exception("LArPandora") << " SliceFeatureMatrix::GetFeature --- unknown feature " << feature;
+
+    return m_values.data() + feature * m_nSlices;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline size_t SliceFeatureMatrix::GetPosition(const size_t sliceIndex, const SliceFeature feature) const
+{
+    if ((sliceIndex >= m_nSlices) || (feature >= kNSliceFeatures))
+        throw cet::exception("LArPandora") << " SliceFeatureMatrix::GetPosition --- no feature " << feature << " for slice " << sliceIndex;
+
+    return feature * m_nSlices + sliceIndex;
+}
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_SLICE_FEATURE_MATRIX_H
@@ -0,0 +1,20 @@
+/**
+ *  @file   larpandora/LArPandoraEventBuilding/classes.h
+ *
+ *  @brief  Dictionary headers for the selection-reference products written by LArPandoraEvent
+ */
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+
+#include "lardataobj/AnalysisBase/T0.h"
+#include "lardataobj/RecoBase/Cluster.h"
+#include "lardataobj/RecoBase/PCAxis.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/PFParticleMetadata.h"
+#include "lardataobj/RecoBase/Shower.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Vertex.h"
+
+#include <vector>
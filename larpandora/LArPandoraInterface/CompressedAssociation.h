@@ -0,0 +1,374 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/CompressedAssociation.h
+ *
+ *  @brief  header for the compressed sparse row association class
+ */
+
+#ifndef LAR_PANDORA_COMPRESSED_ASSOCIATION_H
+#define LAR_PANDORA_COMPRESSED_ASSOCIATION_H 1
+
+#include "canvas/Persistency/Common/Ptr.h"
+
+#include "cetlib_except/exception.h"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  CompressedAssociation class
+ *
+ *  Stores an association from objects of type T to objects of type U in compressed sparse row form. Row i holds the objects of type U
+ *  associated with the i-th object of the source collection, so the source collection must be kept in step with the rows.
+ */
+template <typename T, typename U>
+class CompressedAssociation
+{
+public:
+    typedef typename std::vector<art::Ptr<U> >::const_iterator TargetIterator;
+
+    /**
+     *  @brief  Row class, the range of objects of type U associated with a single source object
+     */
+    class Row
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  begin the first associated object
+         *  @param  end one past the last associated object
+         */
+        Row(const TargetIterator begin, const TargetIterator end);
+
+        /**
+         *  @brief  Get the first associated object
+         */
+        TargetIterator begin() const;
+
+        /**
+         *  @brief  Get one past the last associated object
+         */
+        TargetIterator end() const;
+
+        /**
+         *  @brief  Get the number of associated objects
+         */
+        size_t size() const;
+
+        /**
+         *  @brief  Whether there are no associated objects
+         */
+        bool empty() const;
+
+    private:
+        TargetIterator  m_begin;        ///< The first associated object
+        TargetIterator  m_end;          ///< One past the last associated object
+    };
+
+    /**
+     *  @brief  const_iterator class, iterates over the rows in source collection order
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef Row                         value_type;
+        typedef std::ptrdiff_t              difference_type;
+        typedef const Row                  *pointer;
+        typedef Row                         reference;
+
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pAssociation the association over which to iterate
+         *  @param  sourceIndex the position of the current row
+         */
+        const_iterator(const CompressedAssociation *const pAssociation, const size_t sourceIndex);
+
+        /**
+         *  @brief  Get the position, in the source collection, of the current row
+         */
+        size_t GetSourceIndex() const;
+
+        Row operator*() const;
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator &other) const;
+        bool operator!=(const const_iterator &other) const;
+
+    private:
+        const CompressedAssociation    *m_pAssociation;     ///< The association over which to iterate
+        size_t                          m_sourceIndex;      ///< The position of the current row
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    CompressedAssociation();
+
+    /**
+     *  @brief  Reserve space for the rows
+     *
+     *  @param  nSources the expected number of source objects
+     *  @param  nTargets the expected total number of associated objects
+     */
+    void Reserve(const size_t nSources, const size_t nTargets);
+
+    /**
+     *  @brief  Add the row for the next source object
+     *
+     *  @param  begin the first associated object
+     *  @param  end one past the last associated object
+     */
+    template <typename InputIterator>
+    void AddRow(const InputIterator begin, const InputIterator end);
+
+    /**
+     *  @brief  Add the row for the next source object
+     *
+     *  @param  targets the associated objects
+     */
+    void AddRow(const std::vector<art::Ptr<U> > &targets);
+
+    /**
+     *  @brief  Append the rows of another association, whose source collection is appended to this source collection
+     *
+     *  @param  other the association to append
+     */
+    void Append(const CompressedAssociation &other);
+
+    /**
+     *  @brief  Get the number of rows, equal to the size of the source collection
+     */
+    size_t GetNumberOfSources() const;
+
+    /**
+     *  @brief  Get the total number of associated objects
+     */
+    size_t GetNumberOfTargets() const;
+
+    /**
+     *  @brief  Get the objects associated with a source object
+     *
+     *  @param  sourceIndex the position of the source object in the source collection
+     */
+    Row GetRow(const size_t sourceIndex) const;
+
+    /**
+     *  @brief  Get an iterator to the first row
+     */
+    const_iterator begin() const;
+
+    /**
+     *  @brief  Get an iterator to one past the last row
+     */
+    const_iterator end() const;
+
+private:
+    std::vector<size_t>             m_offsets;          ///< The offset of the first associated object of each row, plus the total
+    std::vector<art::Ptr<U> >       m_targets;          ///< The associated objects, grouped by row
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline CompressedAssociation<T, U>::Row::Row(const TargetIterator begin, const TargetIterator end) :
+    m_begin(begin),
+    m_end(end)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::TargetIterator CompressedAssociation<T, U>::Row::begin() const
+{
+    return m_begin;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::TargetIterator CompressedAssociation<T, U>::Row::end() const
+{
+    return m_end;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline size_t CompressedAssociation<T, U>::Row::size() const
+{
+    return static_cast<size_t>(std::distance(m_begin, m_end));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline bool CompressedAssociation<T, U>::Row::empty() const
+{
+    return (m_begin == m_end);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline CompressedAssociation<T, U>::const_iterator::const_iterator(const CompressedAssociation *const pAssociation, const size_t sourceIndex) :
+    m_pAssociation(pAssociation),
+    m_sourceIndex(sourceIndex)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline size_t CompressedAssociation<T, U>::const_iterator::GetSourceIndex() const
+{
+    return m_sourceIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::Row CompressedAssociation<T, U>::const_iterator::operator*() const
+{
+    return m_pAssociation->GetRow(m_sourceIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::const_iterator &CompressedAssociation<T, U>::const_iterator::operator++()
+{
+    ++m_sourceIndex;
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::const_iterator CompressedAssociation<T, U>::const_iterator::operator++(int)
+{
+    const const_iterator current(*this);
+    ++m_sourceIndex;
+    return current;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline bool CompressedAssociation<T, U>::const_iterator::operator==(const const_iterator &other) const
+{
+    return ((m_pAssociation == other.m_pAssociation) && (m_sourceIndex == other.m_sourceIndex));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline bool CompressedAssociation<T, U>::const_iterator::operator!=(const const_iterator &other) const
+{
+    return !(*this == other);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline CompressedAssociation<T, U>::CompressedAssociation() :
+    m_offsets(1, 0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline void CompressedAssociation<T, U>::Reserve(const size_t nSources, const size_t nTargets)
+{
+    m_offsets.reserve(nSources + 1);
+    m_targets.reserve(nTargets);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+template <typename InputIterator>
+inline void CompressedAssociation<T, U>::AddRow(const InputIterator begin, const InputIterator end)
+{
+    m_targets.insert(m_targets.end(), begin, end);
+    m_offsets.push_back(m_targets.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline void CompressedAssociation<T, U>::AddRow(const std::vector<art::Ptr<U> > &targets)
+{
+    this->AddRow(targets.begin(), targets.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline void CompressedAssociation<T, U>::Append(const CompressedAssociation &other)
+{
+    const size_t shift(m_targets.size());
+
+    m_offsets.reserve(m_offsets.size() + other.GetNumberOfSources());
+    m_targets.insert(m_targets.end(), other.m_targets.begin(), other.m_targets.end());
+
+    for (size_t sourceIndex = 1; sourceIndex < other.m_offsets.size(); ++sourceIndex)
+        m_offsets.push_back(other.m_offsets.at(sourceIndex) + shift);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline size_t CompressedAssociation<T, U>::GetNumberOfSources() const
+{
+    return m_offsets.size() - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline size_t CompressedAssociation<T, U>::GetNumberOfTargets() const
+{
+    return m_targets.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::Row CompressedAssociation<T, U>::GetRow(const size_t sourceIndex) const
+{
+    if (sourceIndex >= this->GetNumberOfSources())
+        throw cet::exception("LArPandora") << " CompressedAssociation::GetRow -- No row for source object at position " << sourceIndex << std::endl;
+
+    return Row(m_targets.begin() + m_offsets[sourceIndex], m_targets.begin() + m_offsets[sourceIndex + 1]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::const_iterator CompressedAssociation<T, U>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline typename CompressedAssociation<T, U>::const_iterator CompressedAssociation<T, U>::end() const
+{
+    return const_iterator(this, this->GetNumberOfSources());
+}
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_COMPRESSED_ASSOCIATION_H
@@ -22,6 +22,7 @@
 #include "lardataobj/RecoBase/Shower.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
 #include "lardataobj/RecoBase/Vertex.h"
 
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -35,6 +36,7 @@
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 #include "larpandora/LArPandoraInterface/LArPandoraInput.h"
 #include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
+#include "larpandora/LArPandoraInterface/LArPandoraSummary.h"
 
 #include <iostream>
 #include <limits>
@@ -84,6 +86,16 @@ LArPandora::LArPandora(fhicl::ParameterSet const &pset) :
     m_outputSettings.m_testBeamInteractionVerticesInstanceLabel = pset.get<std::string>("TestBeamInteractionVerticesInstanceLabel", "testBeamInteractionVertices");
     m_outputSettings.m_isNeutrinoRecoOnlyNoSlicing = (!m_shouldRunSlicing && m_shouldRunNeutrinoRecoOption && !m_shouldRunCosmicRecoOption);
     m_outputSettings.m_hitfinderModuleLabel = m_hitfinderModuleLabel;
+    m_outputSettings.m_shouldProducePfoSummary = pset.get<bool>("ShouldProducePfoSummary", false);
+    m_outputSettings.m_pfoSummaryInstanceLabel = pset.get<std::string>("PfoSummaryInstanceLabel", "pfoSummary");
+    m_outputSettings.m_clearCosmicOutputTier = LArPandoraOutput::GetOutputTier(pset.get<std::string>("ClearCosmicOutputTier", "Full"));
+    m_outputSettings.m_sliceCosmicOutputTier = LArPandoraOutput::GetOutputTier(pset.get<std::string>("SliceCosmicOutputTier", "Full"));
+    m_outputSettings.m_neutrinoOutputTier = LArPandoraOutput::GetOutputTier(pset.get<std::string>("NeutrinoOutputTier", "Full"));
+    m_outputSettings.m_spacePointDecimation = pset.get<unsigned int>("SpacePointDecimation", 10);
+    m_outputSettings.m_fastClusterParamsInstanceLabels = pset.get<std::vector<std::string>>("FastClusterParamsInstanceLabels", {});
+    m_outputSettings.m_shouldProduceTracksAndShowers = pset.get<bool>("ShouldProduceTracksAndShowers", false);
+    m_outputSettings.m_minTrajectoryPoints = pset.get<unsigned int>("MinTrajectoryPoints", 2);
+    m_outputSettings.m_slidingFitHalfWindow = pset.get<unsigned int>("SlidingFitHalfWindow", 20);
 
     if (m_enableProduction)
     {
@@ -126,6 +138,30 @@ LArPandora::LArPandora(fhicl::ParameterSet const &pset) :
                 produces< art::Assns<recob::Slice, recob::Hit> >(instanceName);
                 produces< art::Assns<recob::PFParticle, recob::Slice> >(instanceName);
             }
+
+            if (m_outputSettings.m_shouldProduceTracksAndShowers)
+            {
+                produces< std::vector<recob::Track> >(instanceName);
+                produces< std::vector<recob::Shower> >(instanceName);
+                produces< std::vector<recob::PCAxis> >(instanceName);
+                produces< art::Assns<recob::PFParticle, recob::Track> >(instanceName);
+                produces< art::Assns<recob::PFParticle, recob::Shower> >(instanceName);
+                produces< art::Assns<recob::PFParticle, recob::PCAxis> >(instanceName);
+                produces< art::Assns<recob::Track, recob::Hit> >(instanceName);
+                produces< art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> >(instanceName);
+                produces< art::Assns<recob::Shower, recob::Hit> >(instanceName);
+                produces< art::Assns<recob::Shower, recob::PCAxis> >(instanceName);
+            }
+
+            if (m_outputSettings.m_shouldProducePfoSummary)
+            {
+                // ATTN: Pfo summary instance label appended to current instance name, each column is written as a separate product
+                const std::string pfoSummaryInstanceName(instanceName + m_outputSettings.m_pfoSummaryInstanceLabel);
+                produces< std::vector<int> >(pfoSummaryInstanceName + LArPandoraSummary::kPfoSuffix);
+                produces< std::vector<float> >(pfoSummaryInstanceName + LArPandoraSummary::kSpacePointSuffix);
+                produces< std::vector<int> >(pfoSummaryInstanceName + LArPandoraSummary::kHitSuffix);
+                produces< std::string >(pfoSummaryInstanceName + LArPandoraSummary::kHitTagSuffix);
+            }
         }
     }
 }
@@ -145,6 +181,9 @@ void LArPandora::beginJob()
     m_inputSettings.m_pPrimaryPandora = m_pPrimaryPandora;
     m_outputSettings.m_pPrimaryPandora = m_pPrimaryPandora;
 
+    // ATTN the geometry is fixed for the job, as for the drift volumes, so the sliding fit length scale comes from the constants loaded with them
+    m_outputSettings.m_wirePitchW = LArPandoraGeometry::GetGeometryConstants().GetWirePitchW();
+
     // Pass basic LArTPC information to pandora instances
     LArPandoraInput::CreatePandoraLArTPCs(m_inputSettings, driftVolumeList);
 
@@ -0,0 +1,185 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraAssociationCache.h
+ *
+ *  @brief  Event-scoped cache of associations, so each association is read from the event once however many lookups follow
+ */
+
+#ifndef LAR_PANDORA_ASSOCIATION_CACHE_H
+#define LAR_PANDORA_ASSOCIATION_CACHE_H 1
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+
+#include "canvas/Persistency/Common/FindManyP.h"
+
+#include "cetlib_except/exception.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  LArPandoraAssociationCache class
+ *
+ *  Holds one art::FindManyP per (label, source type, target type), built on first use. The cache refers to the event, so it must not
+ *  outlive the event it was constructed with.
+ */
+class LArPandoraAssociationCache
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  evt the art event
+     */
+    LArPandoraAssociationCache(const art::Event &evt);
+
+    LArPandoraAssociationCache(const LArPandoraAssociationCache &) = delete;
+    LArPandoraAssociationCache &operator=(const LArPandoraAssociationCache &) = delete;
+
+    /**
+     *  @brief  Get the art event
+     */
+    const art::Event &GetEvent() const;
+
+    /**
+     *  @brief  Get the association from the collection of objects of type T with a given label, to objects of type U
+     *
+     *  @param  label the label of the producer of the collection and association
+     */
+    template <typename T, typename U>
+    const art::FindManyP<U> &GetAssociation(const std::string &label);
+
+    /**
+     *  @brief  Get the objects of type U associated with an object of type T, none for a null object. Throws if the object is not from
+     *          the collection with the given label
+     *
+     *  @param  label the label of the producer of the collection and association
+     *  @param  object the object of type T
+     */
+    template <typename T, typename U>
+    const std::vector<art::Ptr<U> > &GetAssociated(const std::string &label, const art::Ptr<T> &object);
+
+private:
+    /**
+     *  @brief  Base class for the cached associations, allowing associations of different types to be held together
+     */
+    class BaseEntry
+    {
+    public:
+        virtual ~BaseEntry() = default;
+    };
+
+    /**
+     *  @brief  A cached association
+     */
+    template <typename T, typename U>
+    class Entry : public BaseEntry
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  handle the handle to the collection of objects of type T
+         *  @param  evt the art event
+         *  @param  label the label of the producer of the association
+         */
+        Entry(const art::Handle<std::vector<T> > &handle, const art::Event &evt, const std::string &label);
+
+        art::ProductID          m_productId;            ///< The product id of the collection of objects of type T
+        art::FindManyP<U>       m_association;          ///< The association
+    };
+
+    typedef std::pair<std::string, std::pair<std::type_index, std::type_index> > EntryKey;
+    typedef std::map<EntryKey, std::unique_ptr<BaseEntry> > EntryMap;
+
+    /**
+     *  @brief  Get the cached association, building it if needed
+     *
+     *  @param  label the label of the producer of the collection and association
+     */
+    template <typename T, typename U>
+    const Entry<T, U> &GetEntry(const std::string &label);
+
+    const art::Event       &m_event;            ///< The art event
+    EntryMap                m_entries;          ///< The cached associations
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline LArPandoraAssociationCache::LArPandoraAssociationCache(const art::Event &evt) :
+    m_event(evt)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const art::Event &LArPandoraAssociationCache::GetEvent() const
+{
+    return m_event;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline const art::FindManyP<U> &LArPandoraAssociationCache::GetAssociation(const std::string &label)
+{
+    return this->GetEntry<T, U>(label).m_association;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline const std::vector<art::Ptr<U> > &LArPandoraAssociationCache::GetAssociated(const std::string &label, const art::Ptr<T> &object)
+{
+    static const std::vector<art::Ptr<U> > emptyVector;
+
+    if (object.isNull())
+        return emptyVector;
+
+    const Entry<T, U> &entry(this->GetEntry<T, U>(label));
+
+    // ATTN the association is indexed by key, so objects from any other collection would silently get the wrong associated objects
+    if (object.id() != entry.m_productId)
+        throw cet::exception("LArPandora") << " LArPandoraAssociationCache::GetAssociated --- object " << object.key() << " is not from the collection with label " << label;
+
+    return entry.m_association.at(object.key());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline const LArPandoraAssociationCache::Entry<T, U> &LArPandoraAssociationCache::GetEntry(const std::string &label)
+{
+    const EntryKey key(label, std::make_pair(std::type_index(typeid(T)), std::type_index(typeid(U))));
+    EntryMap::const_iterator iter(m_entries.find(key));
+
+    if (m_entries.end() == iter)
+    {
+        art::Handle<std::vector<T> > handle;
+        m_event.getByLabel(label, handle);
+
+        iter = m_entries.insert(EntryMap::value_type(key, std::unique_ptr<BaseEntry>(new Entry<T, U>(handle, m_event, label)))).first;
+    }
+
+    return static_cast<const Entry<T, U> &>(*iter->second);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline LArPandoraAssociationCache::Entry<T, U>::Entry(const art::Handle<std::vector<T> > &handle, const art::Event &evt, const std::string &label) :
+    m_productId(handle.id()),
+    m_association(handle, evt, label)
+{
+}
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_ASSOCIATION_CACHE_H
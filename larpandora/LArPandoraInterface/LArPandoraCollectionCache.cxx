@@ -0,0 +1,44 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraCollectionCache.cxx
+ *
+ *  @brief  Service holding the objects collected by LArPandoraHelper for the current event
+ */
+
+#include "larpandora/LArPandoraInterface/LArPandoraCollectionCache.h"
+
+namespace lar_pandora
+{
+
+LArPandoraCollectionCache::LArPandoraCollectionCache(const fhicl::ParameterSet &pset, art::ActivityRegistry &registry) :
+    m_enable(pset.get<bool>("Enable", true))
+{
+    registry.sPostProcessEvent.watch(this, &LArPandoraCollectionCache::PostProcessEvent);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraCollectionCache::Clear()
+{
+    m_entries.clear();
+    m_eventId = art::EventID();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraCollectionCache::PostProcessEvent(const art::Event &, const art::ScheduleContext)
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraCollectionCache::CheckEvent(const art::Event &evt)
+{
+    if (evt.id() == m_eventId)
+        return;
+
+    m_entries.clear();
+    m_eventId = evt.id();
+}
+
+} // namespace lar_pandora
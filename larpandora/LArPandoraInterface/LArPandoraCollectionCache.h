@@ -0,0 +1,248 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraCollectionCache.h
+ *
+ *  @brief  Service holding the objects collected by LArPandoraHelper for the current event, so modules asking for the same
+ *          collections and associations share a single read of the event
+ */
+
+#ifndef LAR_PANDORA_COLLECTION_CACHE_H
+#define LAR_PANDORA_COLLECTION_CACHE_H 1
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include "cetlib_except/exception.h"
+
+#include "fhiclcpp/ParameterSet.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  LArPandoraCollectionCache class
+ *
+ *  Holds the outputs of the LArPandoraHelper Collect* and event-based Build* functions. Each entry is keyed by a label naming the inputs
+ *  and options of the function, by the product id of the collection the label resolved to, and by the types of the outputs. A collection
+ *  put in the event later with the same label, e.g. by a module of the current process, therefore gets its own entry. Entries hold the
+ *  objects once; callers receive copies of them (art::Ptr copies, not copies of the event data). All entries are cleared at the end of
+ *  each event, and whenever an entry is requested for a different event.
+ *
+ *  An entry that exists but is not yet filled is being filled by an outer call for the same inputs: a caller finding such an entry must
+ *  do the work itself rather than wait for, or add, the entry.
+ */
+class LArPandoraCollectionCache
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pset the parameter set
+     *  @param  registry the activity registry
+     */
+    LArPandoraCollectionCache(const fhicl::ParameterSet &pset, art::ActivityRegistry &registry);
+
+    LArPandoraCollectionCache(const LArPandoraCollectionCache &) = delete;
+    LArPandoraCollectionCache &operator=(const LArPandoraCollectionCache &) = delete;
+
+    /**
+     *  @brief  Whether the helper functions should use the cache
+     */
+    bool IsEnabled() const;
+
+    /**
+     *  @brief  Get the entry of type T with a given label and input product id, nullptr if there is no such entry
+     *
+     *  @param  evt the art event
+     *  @param  label the label of the entry
+     *  @param  productId the product id of the input collection
+     *  @param  isFilled to receive whether the entry has been filled, false while it is being filled
+     */
+    template <typename T>
+    T *GetEntry(const art::Event &evt, const std::string &label, const art::ProductID &productId, bool &isFilled);
+
+    /**
+     *  @brief  Add an empty entry of type T with a given label and input product id, to be filled and then marked with SetFilled
+     *
+     *  @param  evt the art event
+     *  @param  label the label of the entry
+     *  @param  productId the product id of the input collection
+     */
+    template <typename T>
+    T &AddEntry(const art::Event &evt, const std::string &label, const art::ProductID &productId);
+
+    /**
+     *  @brief  Mark the entry of type T with a given label and input product id as filled
+     *
+     *  @param  label the label of the entry
+     *  @param  productId the product id of the input collection
+     */
+    template <typename T>
+    void SetFilled(const std::string &label, const art::ProductID &productId);
+
+    /**
+     *  @brief  Remove the entry of type T with a given label and input product id, if present
+     *
+     *  @param  label the label of the entry
+     *  @param  productId the product id of the input collection
+     */
+    template <typename T>
+    void RemoveEntry(const std::string &label, const art::ProductID &productId);
+
+    /**
+     *  @brief  Remove all entries
+     */
+    void Clear();
+
+private:
+    /**
+     *  @brief  Base class for the entries, allowing entries of different types to be held together
+     */
+    class BaseEntry
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        BaseEntry();
+
+        virtual ~BaseEntry() = default;
+
+        bool    m_isFilled;         ///< Whether the entry has been filled
+    };
+
+    /**
+     *  @brief  An entry of type T
+     */
+    template <typename T>
+    class Entry : public BaseEntry
+    {
+    public:
+        T       m_value;            ///< The cached objects
+    };
+
+    typedef std::tuple<std::string, art::ProductID, std::type_index> EntryKey;
+    typedef std::map<EntryKey, std::unique_ptr<BaseEntry> > EntryMap;
+
+    /**
+     *  @brief  Clear the entries at the end of an event
+     *
+     *  @param  evt the art event
+     *  @param  scheduleContext the schedule context
+     */
+    void PostProcessEvent(const art::Event &evt, const art::ScheduleContext scheduleContext);
+
+    /**
+     *  @brief  Clear the entries if they were filled for a different event
+     *
+     *  @param  evt the art event
+     */
+    void CheckEvent(const art::Event &evt);
+
+    /**
+     *  @brief  Get the key of the entry of type T with a given label and input product id
+     *
+     *  @param  label the label of the entry
+     *  @param  productId the product id of the input collection
+     */
+    template <typename T>
+    static EntryKey GetKey(const std::string &label, const art::ProductID &productId);
+
+    bool            m_enable;           ///< Whether the helper functions should use the cache
+    art::EventID    m_eventId;          ///< The event the entries belong to
+    EntryMap        m_entries;          ///< The cached entries
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArPandoraCollectionCache::IsEnabled() const
+{
+    return m_enable;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline T *LArPandoraCollectionCache::GetEntry(const art::Event &evt, const std::string &label, const art::ProductID &productId, bool &isFilled)
+{
+    this->CheckEvent(evt);
+
+    EntryMap::const_iterator iter(m_entries.find(LArPandoraCollectionCache::GetKey<T>(label, productId)));
+
+    if (m_entries.end() == iter)
+        return nullptr;
+
+    Entry<T> &entry(static_cast<Entry<T> &>(*iter->second));
+    isFilled = entry.m_isFilled;
+
+    return &entry.m_value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline T &LArPandoraCollectionCache::AddEntry(const art::Event &evt, const std::string &label, const art::ProductID &productId)
+{
+    this->CheckEvent(evt);
+
+    std::unique_ptr<BaseEntry> &pEntry(m_entries[LArPandoraCollectionCache::GetKey<T>(label, productId)]);
+
+    if (pEntry)
+        throw cet::exception("LArPandora") << " LArPandoraCollectionCache::AddEntry --- entry with label " << label << " already exists ";
+
+    pEntry.reset(new Entry<T>);
+
+    return static_cast<Entry<T> &>(*pEntry).m_value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void LArPandoraCollectionCache::SetFilled(const std::string &label, const art::ProductID &productId)
+{
+    EntryMap::const_iterator iter(m_entries.find(LArPandoraCollectionCache::GetKey<T>(label, productId)));
+
+    if (m_entries.end() == iter)
+        throw cet::exception("LArPandora") << " LArPandoraCollectionCache::SetFilled --- no entry with label " << label;
+
+    iter->second->m_isFilled = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void LArPandoraCollectionCache::RemoveEntry(const std::string &label, const art::ProductID &productId)
+{
+    m_entries.erase(LArPandoraCollectionCache::GetKey<T>(label, productId));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline LArPandoraCollectionCache::EntryKey LArPandoraCollectionCache::GetKey(const std::string &label, const art::ProductID &productId)
+{
+    return EntryKey(label, productId, std::type_index(typeid(T)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline LArPandoraCollectionCache::BaseEntry::BaseEntry() :
+    m_isFilled(false)
+{
+}
+
+} // namespace lar_pandora
+
+DECLARE_ART_SERVICE(lar_pandora::LArPandoraCollectionCache, LEGACY)
+
+#endif // #ifndef LAR_PANDORA_COLLECTION_CACHE_H
@@ -0,0 +1,9 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraCollectionCache_service.cc
+ *
+ *  @brief  Service definition for the LArPandoraCollectionCache
+ */
+
+#include "larpandora/LArPandoraInterface/LArPandoraCollectionCache.h"
+
+DEFINE_ART_SERVICE(lar_pandora::LArPandoraCollectionCache)
@@ -13,12 +13,24 @@
 
 #include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
 
+#include <cmath>
 #include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <unordered_set>
 
 namespace lar_pandora
 {
 
+std::mutex LArPandoraGeometry::m_geometryConstantsMutex;
+std::unique_ptr<LArGeometryConstants> LArPandoraGeometry::m_pGeometryConstants;
+std::string LArPandoraGeometry::m_geometryName;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void LArPandoraGeometry::LoadDetectorGaps(LArDetectorGapList &listOfGaps)
 {
     // Detector gaps can only be loaded once - throw an exception if the output lists are already filled
@@ -132,6 +144,86 @@ geo::View_t LArPandoraGeometry::GetGlobalView(const unsigned int cstat, const un
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+const LArGeometryConstants &LArPandoraGeometry::LoadGeometryConstants()
+{
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+    const std::string geometryName(theGeometry->DetectorName() + ":" + theGeometry->GDMLFile());
+
+    // ATTN the constants are shared by all producers, so they are only recomputed when the geometry service describes a different detector.
+    // They are then assigned in place, so references handed out earlier stay valid
+    const std::lock_guard<std::mutex> lock(m_geometryConstantsMutex);
+
+    if (!m_pGeometryConstants)
+    {
+        m_pGeometryConstants.reset(new LArGeometryConstants(LArPandoraGeometry::ComputeGeometryConstants()));
+        m_geometryName = geometryName;
+    }
+    else if (geometryName != m_geometryName)
+    {
+        *m_pGeometryConstants = LArPandoraGeometry::ComputeGeometryConstants();
+        m_geometryName = geometryName;
+    }
+
+    return *m_pGeometryConstants;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const LArGeometryConstants &LArPandoraGeometry::GetGeometryConstants()
+{
+    if (!m_pGeometryConstants)
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::GetGeometryConstants --- geometry constants have not been loaded ";
+
+    return *m_pGeometryConstants;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArGeometryConstants LArPandoraGeometry::ComputeGeometryConstants()
+{
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+    const unsigned int nWirePlanes(theGeometry->MaxPlanes());
+
+    if (nWirePlanes > 3)
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::ComputeGeometryConstants --- More than three wire planes present ";
+
+    // We here check the plane information only for the first tpc in the first cryostat.
+    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::ComputeGeometryConstants --- unable to access first tpc in first cryostat ";
+
+    std::unordered_set<geo::_plane_proj> planeSet;
+    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
+        (void) planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
+
+    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
+    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
+    const bool isDualPhase(theGeometry->MaxPlanes() == 2);
+
+    if (nWirePlanes != planeSet.size())
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::ComputeGeometryConstants --- geometry description for wire plane(s) missing ";
+
+    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::ComputeGeometryConstants --- dual phase scenario; expect to find w and y views ";
+
+    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) || (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
+        throw cet::exception("LArPandora") << " LArPandoraGeometry::ComputeGeometryConstants --- single phase scenatio; expect to find u and v views; if there is one further view, it must be w or y ";
+
+    const bool useYPlane((nWirePlanes > 2) && planeSet.count(geo::kY));
+
+    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
+    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
+    const geo::View_t targetViewU(isDualPhase ? geo::kW : geo::kU);
+    const geo::View_t targetViewV(isDualPhase ? geo::kY : geo::kV);
+    const float wirePitchU(theGeometry->WirePitch(targetViewU));
+    const float wirePitchV(theGeometry->WirePitch(targetViewV));
+    const float wirePitchW((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) : (useYPlane) ? theGeometry->WirePitch(geo::kY) :
+        theGeometry->WirePitch(geo::kW));
+
+    return LArGeometryConstants(nWirePlanes, isDualPhase, useYPlane, wirePitchU, wirePitchV, wirePitchW);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 unsigned int LArPandoraGeometry::GetTpcID(const unsigned int cstat, const unsigned int tpc)
 {
     // We assume there will never be more than 10000 TPCs in a cryostat!
@@ -179,40 +271,15 @@ void LArPandoraGeometry::LoadGeometry(LArDriftVolumeList &driftVolumeList)
 
     // Pandora requires three independent images, and ability to correlate features between images (via wire angles and transformation plugin).
     art::ServiceHandle<geo::Geometry const> theGeometry;
-    const unsigned int nWirePlanes(theGeometry->MaxPlanes());
-
-    if (nWirePlanes > 3)
-        throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- More than three wire planes present ";
-
-    // We here check the plane information only for the first tpc in the first cryostat.
-    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
-        throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- unable to access first tpc in first cryostat ";
 
-    std::unordered_set<geo::_plane_proj> planeSet;
-    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
-        (void) planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
-
-    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
-    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
-    const bool isDualPhase(theGeometry->MaxPlanes() == 2);
-
-    if (nWirePlanes != planeSet.size())
-        throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- geometry description for wire plane(s) missing ";
-
-    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
-        throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- dual phase scenario; expect to find w and y views ";
-
-    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) || (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
-        throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- single phase scenatio; expect to find u and v views; if there is one further view, it must be w or y ";
-
-    const bool useYPlane((nWirePlanes > 2) && planeSet.count(geo::kY));
-
-    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
-    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
-    const float wirePitchU(theGeometry->WirePitch((isDualPhase ? geo::kW : geo::kU)));
-    const float wirePitchV(theGeometry->WirePitch((isDualPhase ? geo::kY : geo::kV)));
-    const float wirePitchW((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) : (useYPlane) ? theGeometry->WirePitch(geo::kY) :
-        theGeometry->WirePitch(geo::kW));
+    // The plane information is checked only for the first tpc in the first cryostat, when computing the geometry constants
+    const LArGeometryConstants &geometryConstants(LArPandoraGeometry::LoadGeometryConstants());
+    const unsigned int nWirePlanes(geometryConstants.GetNWirePlanes());
+    const bool isDualPhase(geometryConstants.IsDualPhase());
+    const bool useYPlane(geometryConstants.UseYPlane());
+    const float wirePitchU(geometryConstants.GetWirePitchU());
+    const float wirePitchV(geometryConstants.GetWirePitchV());
+    const float wirePitchW(geometryConstants.GetWirePitchW());
 
     const float maxDeltaTheta(0.01f); // leave this hard-coded for now
 
@@ -10,6 +10,9 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace lar_pandora
@@ -250,6 +253,69 @@ typedef std::map<unsigned int, LArDriftVolume> LArDriftVolumeMap;
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ *  @brief  geometry constants class to hold the validated wire plane layout and pitches, in pandora views, of the first tpc in the first cryostat
+ *
+ *  The wire angles can differ between tpcs, so they are only held per drift volume, see LArPandoraGeometry::LoadGeometry
+ */
+class LArGeometryConstants
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  nWirePlanes number of wire planes
+     *  @param  isDualPhase whether the wire planes are those of a dual phase LArTPC
+     *  @param  useYPlane whether the Y plane is used as the W view
+     *  @param  wirePitchU wire pitch in U view
+     *  @param  wirePitchV wire pitch in V view
+     *  @param  wirePitchW wire pitch in W view
+     */
+    LArGeometryConstants(const unsigned int nWirePlanes, const bool isDualPhase, const bool useYPlane, const float wirePitchU, const float wirePitchV,
+        const float wirePitchW);
+
+    /**
+     *  @brief Return number of wire planes
+     */
+    unsigned int GetNWirePlanes() const;
+
+    /**
+     *  @brief Return whether the wire planes are those of a dual phase LArTPC
+     */
+    bool IsDualPhase() const;
+
+    /**
+     *  @brief Return whether the Y plane is used as the W view
+     */
+    bool UseYPlane() const;
+
+    /**
+     *  @brief Return wire pitch in U view
+     */
+    float GetWirePitchU() const;
+
+    /**
+     *  @brief Return wire pitch in V view
+     */
+    float GetWirePitchV() const;
+
+    /**
+     *  @brief Return wire pitch in W view
+     */
+    float GetWirePitchW() const;
+
+private:
+    unsigned int    m_nWirePlanes;
+    bool            m_isDualPhase;
+    bool            m_useYPlane;
+    float           m_wirePitchU;
+    float           m_wirePitchV;
+    float           m_wirePitchW;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 /**
  *  @brief  LArPandoraGeometry class
  */
@@ -289,7 +355,26 @@ public:
      */
     static geo::View_t GetGlobalView(const unsigned int cstat, const unsigned int tpc, const geo::View_t hit_View);
 
+    /**
+     *  @brief  Load the geometry constants, checking that the wire planes are those of a single or dual phase LArTPC, to be called at
+     *          beginJob or beginRun
+     *
+     *  The constants are shared by all callers, and only recomputed when the detector name or gdml file of the geometry service changes.
+     *  The returned reference stays valid for the job, and holds the values for the latest geometry.
+     */
+    static const LArGeometryConstants &LoadGeometryConstants();
+
+    /**
+     *  @brief  Get the geometry constants from the last call to LoadGeometryConstants, without accessing the geometry service
+     */
+    static const LArGeometryConstants &GetGeometryConstants();
+
 private:
+    /**
+     *  @brief  Compute the geometry constants from the geometry service, checking the wire planes
+     */
+    static LArGeometryConstants ComputeGeometryConstants();
+
     /**
      *  @brief  Generate a unique identifier for each TPC
      *
@@ -329,6 +414,10 @@ private:
      *  @param  parentVolumeList to receive the output daughter drift volume list
      */
     static void LoadGlobalDaughterGeometry(const LArDriftVolumeList &driftVolumeList, LArDriftVolumeList &daughterVolumeList);
+
+    static std::mutex                               m_geometryConstantsMutex;   ///< The mutex guarding the loading of the geometry constants
+    static std::unique_ptr<LArGeometryConstants>    m_pGeometryConstants;       ///< The geometry constants, shared by all callers
+    static std::string                              m_geometryName;             ///< The detector name and gdml file the constants were computed for
 };
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -509,6 +598,62 @@ inline float LArDriftVolume::GetSigmaUVZ() const
     return m_sigmaUVZ;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline LArGeometryConstants::LArGeometryConstants(const unsigned int nWirePlanes, const bool isDualPhase, const bool useYPlane, const float wirePitchU,
+        const float wirePitchV, const float wirePitchW) :
+    m_nWirePlanes(nWirePlanes),
+    m_isDualPhase(isDualPhase),
+    m_useYPlane(useYPlane),
+    m_wirePitchU(wirePitchU),
+    m_wirePitchV(wirePitchV),
+    m_wirePitchW(wirePitchW)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline unsigned int LArGeometryConstants::GetNWirePlanes() const
+{
+    return m_nWirePlanes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArGeometryConstants::IsDualPhase() const
+{
+    return m_isDualPhase;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline bool LArGeometryConstants::UseYPlane() const
+{
+    return m_useYPlane;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArGeometryConstants::GetWirePitchU() const
+{
+    return m_wirePitchU;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArGeometryConstants::GetWirePitchV() const
+{
+    return m_wirePitchV;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline float LArGeometryConstants::GetWirePitchW() const
+{
+    return m_wirePitchW;
+}
+
 } // namespace lar_pandora
 
 #endif // #ifndef LAR_PANDORA_GEOMETRY_H
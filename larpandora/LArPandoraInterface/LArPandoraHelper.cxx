@@ -10,6 +10,8 @@
 #include "art/Framework/Principal/Handle.h"
 #include "canvas/Persistency/Common/FindManyP.h"
 #include "canvas/Persistency/Common/FindOneP.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/Registry/ServiceRegistry.h"
 
 #include "lardataobj/AnalysisBase/T0.h"
 #include "lardataobj/AnalysisBase/CosmicTag.h"
@@ -36,16 +38,25 @@
 #include "Pandora/PdgTable.h"
 #include "Pandora/PandoraInternal.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationCache.h"
+#include "larpandora/LArPandoraInterface/LArPandoraCollectionCache.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
+#include <cmath>
 #include <limits>
 #include <iostream>
+#include <string>
+#include <tuple>
 
 namespace lar_pandora
 {
 
 void LArPandoraHelper::CollectWires(const art::Event &evt, const std::string &label, WireVector &wireVector)
 {
+    // ATTN on a cache miss, the cache calls this function again to fill its entry; that call finds the entry unfilled and reads the wires
+    if (LArPandoraHelper::UseCollectionCache<recob::Wire>(evt, label, &LArPandoraHelper::CollectWires, wireVector))
+        return;
+
     art::Handle< std::vector<recob::Wire> > theWires;
     evt.getByLabel(label, theWires);
 
@@ -70,6 +81,9 @@ void LArPandoraHelper::CollectWires(const art::Event &evt, const std::string &la
 
 void LArPandoraHelper::CollectHits(const art::Event &evt, const std::string &label, HitVector &hitVector)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Hit>(evt, label, &LArPandoraHelper::CollectHits, hitVector))
+        return;
+
     art::Handle< std::vector<recob::Hit> > theHits;
     evt.getByLabel(label, theHits);
 
@@ -94,6 +108,9 @@ void LArPandoraHelper::CollectHits(const art::Event &evt, const std::string &lab
 
 void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticles, particleVector))
+        return;
+
     art::Handle< std::vector<recob::PFParticle> > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -128,6 +145,9 @@ void LArPandoraHelper::CollectSpacePoints(const art::Event &evt, const std::stri
 void LArPandoraHelper::CollectSpacePoints(const art::Event &evt, const std::string &label, SpacePointVector &spacePointVector,
     SpacePointsToHits &spacePointsToHits, HitsToSpacePoints &hitsToSpacePoints)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::SpacePoint>(evt, label, &LArPandoraHelper::CollectSpacePoints, spacePointVector, spacePointsToHits, hitsToSpacePoints))
+        return;
+
     art::Handle< std::vector<recob::SpacePoint> > theSpacePoints;
     evt.getByLabel(label, theSpacePoints);
 
@@ -154,9 +174,42 @@ void LArPandoraHelper::CollectSpacePoints(const art::Event &evt, const std::stri
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraHelper::CollectSpacePoints(const art::Event &evt, const std::string &label, SpacePointVector &spacePointVector,
+    SpacePointsToHitsIndex &spacePointsToHits)
+{
+    if (LArPandoraHelper::UseCollectionCache<recob::SpacePoint>(evt, label, &LArPandoraHelper::CollectSpacePoints, spacePointVector, spacePointsToHits))
+        return;
+
+    art::Handle< std::vector<recob::SpacePoint> > theSpacePoints;
+    evt.getByLabel(label, theSpacePoints);
+
+    if (!theSpacePoints.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find spacepoints... " << std::endl;
+        return;
+    }
+    else
+    {
+        mf::LogDebug("LArPandora") << "  Found: " << theSpacePoints->size() << " SpacePoints " << std::endl;
+    }
+
+    art::FindOneP<recob::Hit> theHitAssns(theSpacePoints, evt, label);
+    for (unsigned int i = 0; i < theSpacePoints->size(); ++i)
+    {
+        const art::Ptr<recob::SpacePoint> spacepoint(theSpacePoints, i);
+        spacePointVector.push_back(spacepoint);
+        spacePointsToHits.Set(spacepoint, theHitAssns.at(i));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void LArPandoraHelper::CollectClusters(const art::Event &evt, const std::string &label, ClusterVector &clusterVector,
     ClustersToHits &clustersToHits)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Cluster>(evt, label, &LArPandoraHelper::CollectClusters, clusterVector, clustersToHits))
+        return;
+
     art::Handle< std::vector<recob::Cluster> > theClusters;
     evt.getByLabel(label, theClusters);
 
@@ -187,9 +240,47 @@ void LArPandoraHelper::CollectClusters(const art::Event &evt, const std::string
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraHelper::CollectClusters(const art::Event &evt, const std::string &label, ClusterVector &clusterVector,
+    ClustersToHitsIndex &clustersToHits)
+{
+    if (LArPandoraHelper::UseCollectionCache<recob::Cluster>(evt, label, &LArPandoraHelper::CollectClusters, clusterVector, clustersToHits))
+        return;
+
+    art::Handle< std::vector<recob::Cluster> > theClusters;
+    evt.getByLabel(label, theClusters);
+
+    if (!theClusters.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find clusters... " << std::endl;
+        clustersToHits.Finalize();
+        return;
+    }
+    else
+    {
+        mf::LogDebug("LArPandora") << "  Found: " << theClusters->size() << " Clusters " << std::endl;
+    }
+
+    art::FindManyP<recob::Hit> theHitAssns(theClusters, evt, label);
+    for (unsigned int i = 0; i < theClusters->size(); ++i)
+    {
+        const art::Ptr<recob::Cluster> cluster(theClusters, i);
+        clusterVector.push_back(cluster);
+
+        for (const art::Ptr<recob::Hit> &hit : theHitAssns.at(i))
+            clustersToHits.Add(cluster, hit);
+    }
+
+    clustersToHits.Finalize();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
     PFParticlesToSpacePoints &particlesToSpacePoints)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticles, particleVector, particlesToSpacePoints))
+        return;
+
     art::Handle< std::vector<recob::PFParticle> > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -223,6 +314,9 @@ void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::stri
 void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
     PFParticlesToClusters &particlesToClusters)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticles, particleVector, particlesToClusters))
+        return;
+
     art::Handle< std::vector<recob::PFParticle> > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -253,9 +347,82 @@ void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::stri
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
+    PFParticlesToSpacePointsIndex &particlesToSpacePoints)
+{
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticles, particleVector, particlesToSpacePoints))
+        return;
+
+    art::Handle< std::vector<recob::PFParticle> > theParticles;
+    evt.getByLabel(label, theParticles);
+
+    if (!theParticles.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
+        particlesToSpacePoints.Finalize();
+        return;
+    }
+    else
+    {
+        mf::LogDebug("LArPandora") << "  Found: " << theParticles->size() << " PFParticles " << std::endl;
+    }
+
+    art::FindManyP<recob::SpacePoint> theSpacePointAssns(theParticles, evt, label);
+    for (unsigned int i = 0; i < theParticles->size(); ++i)
+    {
+        const art::Ptr<recob::PFParticle> particle(theParticles, i);
+        particleVector.push_back(particle);
+
+        for (const art::Ptr<recob::SpacePoint> &spacepoint : theSpacePointAssns.at(i))
+            particlesToSpacePoints.Add(particle, spacepoint);
+    }
+
+    particlesToSpacePoints.Finalize();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
+    PFParticlesToClustersIndex &particlesToClusters)
+{
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticles, particleVector, particlesToClusters))
+        return;
+
+    art::Handle< std::vector<recob::PFParticle> > theParticles;
+    evt.getByLabel(label, theParticles);
+
+    if (!theParticles.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
+        particlesToClusters.Finalize();
+        return;
+    }
+    else
+    {
+        mf::LogDebug("LArPandora") << "  Found: " << theParticles->size() << " PFParticles " << std::endl;
+    }
+
+    art::FindManyP<recob::Cluster> theClusterAssns(theParticles, evt, label);
+    for (unsigned int i = 0; i < theParticles->size(); ++i)
+    {
+        const art::Ptr<recob::PFParticle> particle(theParticles, i);
+        particleVector.push_back(particle);
+
+        for (const art::Ptr<recob::Cluster> &cluster : theClusterAssns.at(i))
+            particlesToClusters.Add(particle, cluster);
+    }
+
+    particlesToClusters.Finalize();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void LArPandoraHelper::CollectPFParticleMetadata(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
     PFParticlesToMetadata &particlesToMetadata)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, &LArPandoraHelper::CollectPFParticleMetadata, particleVector, particlesToMetadata))
+        return;
+
     art::Handle< std::vector<recob::PFParticle> > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -286,9 +453,67 @@ void LArPandoraHelper::CollectPFParticleMetadata(const art::Event &evt, const st
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraHelper::CollectPFParticleAssociations(const art::Event &evt, const std::string &label, const unsigned int associationKinds,
+    PFParticleAssociations &associations)
+{
+    const auto collect([&](PFParticleAssociations &cachedAssociations)
+    {
+        LArPandoraHelper::CollectPFParticleAssociations(evt, label, associationKinds, cachedAssociations);
+    });
+
+    // ATTN collect re-enters this function with the cache's own associations, which are filled below as the entry is still unfilled
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label, label + ":" + std::to_string(associationKinds), collect, associations))
+        return;
+
+    associations = PFParticleAssociations();
+    evt.getByLabel(label, associations.m_handle);
+
+    if (!associations.m_handle.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
+        return;
+    }
+    else
+    {
+        mf::LogDebug("LArPandora") << "  Found: " << associations.m_handle->size() << " PFParticles " << std::endl;
+    }
+
+    associations.m_particles.reserve(associations.m_handle->size());
+
+    for (unsigned int i = 0; i < associations.m_handle->size(); ++i)
+        associations.m_particles.push_back(art::Ptr<recob::PFParticle>(associations.m_handle, i));
+
+    // ATTN each association is built once from the particle collection, rather than from a separate fetch per association kind
+    if (associationKinds & kSpacePointAssociations)
+        associations.FillAssociated(evt, label, associations.m_spacePoints);
+
+    if (associationKinds & (kClusterAssociations | kClusterHitAssociations))
+        associations.FillAssociated(evt, label, associations.m_clusters);
+
+    if (associationKinds & kVertexAssociations)
+        associations.FillAssociated(evt, label, associations.m_vertices);
+
+    if (associationKinds & kMetadataAssociations)
+        associations.FillAssociated(evt, label, associations.m_metadata);
+
+    if (associationKinds & kT0Associations)
+        associations.FillAssociated(evt, label, associations.m_t0s);
+
+    if (associationKinds & kSeedAssociations)
+        associations.FillAssociated(evt, label, associations.m_seeds);
+
+    if (associationKinds & kClusterHitAssociations)
+        associations.FillClusterHits(evt, label);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 void LArPandoraHelper::CollectShowers(const art::Event &evt, const std::string &label, ShowerVector &showerVector,
     PFParticlesToShowers &particlesToShowers)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Shower>(evt, label, &LArPandoraHelper::CollectShowers, showerVector, particlesToShowers))
+        return;
+
     art::Handle< std::vector<recob::Shower> > theShowers;
     evt.getByLabel(label, theShowers);
 
@@ -322,6 +547,9 @@ void LArPandoraHelper::CollectShowers(const art::Event &evt, const std::string &
 void LArPandoraHelper::CollectTracks(const art::Event &evt, const std::string &label, TrackVector &trackVector,
     PFParticlesToTracks &particlesToTracks)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Track>(evt, label, &LArPandoraHelper::CollectTracks, trackVector, particlesToTracks))
+        return;
+
     art::Handle< std::vector<recob::Track> > theTracks;
     evt.getByLabel(label, theTracks);
 
@@ -354,6 +582,9 @@ void LArPandoraHelper::CollectTracks(const art::Event &evt, const std::string &l
 
 void LArPandoraHelper::CollectTracks(const art::Event &evt, const std::string &label, TrackVector &trackVector, TracksToHits &tracksToHits)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Track>(evt, label, &LArPandoraHelper::CollectTracks, trackVector, tracksToHits))
+        return;
+
     art::Handle< std::vector<recob::Track> > theTracks;
     evt.getByLabel(label, theTracks);
 
@@ -386,6 +617,9 @@ void LArPandoraHelper::CollectTracks(const art::Event &evt, const std::string &l
 
 void LArPandoraHelper::CollectShowers(const art::Event &evt, const std::string &label, ShowerVector &showerVector, ShowersToHits &showersToHits)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Shower>(evt, label, &LArPandoraHelper::CollectShowers, showerVector, showersToHits))
+        return;
+
     art::Handle< std::vector<recob::Shower> > theShowers;
     evt.getByLabel(label, theShowers);
 
@@ -419,6 +653,9 @@ void LArPandoraHelper::CollectShowers(const art::Event &evt, const std::string &
 void LArPandoraHelper::CollectSeeds(const art::Event &evt, const std::string &label, SeedVector &seedVector,
     PFParticlesToSeeds &particlesToSeeds)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Seed>(evt, label, &LArPandoraHelper::CollectSeeds, seedVector, particlesToSeeds))
+        return;
+
     art::Handle< std::vector<recob::Seed> > theSeeds;
     evt.getByLabel(label, theSeeds);
 
@@ -451,6 +688,9 @@ void LArPandoraHelper::CollectSeeds(const art::Event &evt, const std::string &la
 
 void LArPandoraHelper::CollectSeeds(const art::Event &evt, const std::string &label, SeedVector &seedVector, SeedsToHits &seedsToHits)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Seed>(evt, label, &LArPandoraHelper::CollectSeeds, seedVector, seedsToHits))
+        return;
+
     art::Handle< std::vector<recob::Seed> > theSeeds;
     evt.getByLabel(label, theSeeds);
 
@@ -486,6 +726,9 @@ void LArPandoraHelper::CollectSeeds(const art::Event &evt, const std::string &la
 void LArPandoraHelper::CollectVertices(const art::Event &evt, const std::string &label, VertexVector &vertexVector,
     PFParticlesToVertices &particlesToVertices)
 {
+    if (LArPandoraHelper::UseCollectionCache<recob::Vertex>(evt, label, &LArPandoraHelper::CollectVertices, vertexVector, particlesToVertices))
+        return;
+
     art::Handle< std::vector<recob::Vertex> > theVertices;
     evt.getByLabel(label, theVertices);
 
@@ -520,24 +763,16 @@ void LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector &particleVe
     const SpacePointsToHits &spacePointsToHits, PFParticlesToHits &particlesToHits, HitsToPFParticles &hitsToParticles,
     const DaughterMode daughterMode)
 {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
-
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(), iterEnd1 = particleVector.end(); iter1 != iterEnd1; ++iter1)
-    {
-        const art::Ptr<recob::PFParticle> particle = *iter1;
-        particleMap[particle->Self()] = particle;
-    }
+    // Resolve the parent/daughter hierarchy once, unless daughter particles are used as they are
+    const PFParticleHierarchyIndex hierarchyIndex((kUseDaughters == daughterMode) ? PFParticleVector() : particleVector);
 
     // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
     for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(), iterEnd1 = particlesToSpacePoints.end();
         iter1 != iterEnd1; ++iter1)
     {
-        const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
-        const art::Ptr<recob::PFParticle> particle((kAddDaughters == daughterMode) ?
-            LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) : thisParticle);
+        art::Ptr<recob::PFParticle> particle;
 
-        if ((kIgnoreDaughters == daughterMode) && !LArPandoraHelper::IsFinalState(particleMap, particle))
+        if (!LArPandoraHelper::GetHitMapParticle(hierarchyIndex, iter1->first, daughterMode, particle))
             continue;
 
         const SpacePointVector &spacePointVector = iter1->second;
@@ -564,24 +799,16 @@ void LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector &particleVe
     const ClustersToHits &clustersToHits, PFParticlesToHits &particlesToHits, HitsToPFParticles &hitsToParticles,
     const DaughterMode daughterMode)
 {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
-
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(), iterEnd1 = particleVector.end(); iter1 != iterEnd1; ++iter1)
-    {
-        const art::Ptr<recob::PFParticle> particle = *iter1;
-        particleMap[particle->Self()] = particle;
-    }
+    // Resolve the parent/daughter hierarchy once, unless daughter particles are used as they are
+    const PFParticleHierarchyIndex hierarchyIndex((kUseDaughters == daughterMode) ? PFParticleVector() : particleVector);
 
     // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
     for (PFParticlesToClusters::const_iterator iter1 = particlesToClusters.begin(), iterEnd1 = particlesToClusters.end();
         iter1 != iterEnd1; ++iter1)
     {
-        const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
-        const art::Ptr<recob::PFParticle> particle((kAddDaughters == daughterMode) ?
-            LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) : thisParticle);
+        art::Ptr<recob::PFParticle> particle;
 
-        if ((kIgnoreDaughters == daughterMode) && !LArPandoraHelper::IsFinalState(particleMap, particle))
+        if (!LArPandoraHelper::GetHitMapParticle(hierarchyIndex, iter1->first, daughterMode, particle))
             continue;
 
         const ClusterVector &clusterVector = iter1->second;
@@ -618,6 +845,17 @@ void LArPandoraHelper::BuildPFParticleHitMaps(const art::Event &evt, const std::
 void LArPandoraHelper::BuildPFParticleHitMaps(const art::Event &evt, const std::string &label_pfpart, const std::string &label_middle,
     PFParticlesToHits &particlesToHits, HitsToPFParticles &hitsToParticles, const DaughterMode daughterMode, const bool useClusters)
 {
+    const auto collect([&](PFParticlesToHits &cachedParticlesToHits, HitsToPFParticles &cachedHitsToParticles)
+    {
+        LArPandoraHelper::BuildPFParticleHitMaps(evt, label_pfpart, label_middle, cachedParticlesToHits, cachedHitsToParticles, daughterMode, useClusters);
+    });
+
+    const std::string cacheLabel(label_pfpart + ":" + label_middle + ":" + std::to_string(daughterMode) + (useClusters ? ":clusters" : ":spacepoints"));
+
+    // ATTN on a miss, collect builds the maps into the unfilled cache entry through the code below, then they are copied out
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label_pfpart, cacheLabel, collect, particlesToHits, hitsToParticles))
+        return;
+
     // Use intermediate clusters
     if (useClusters)
     {
@@ -653,91 +891,256 @@ void LArPandoraHelper::BuildPFParticleHitMaps(const art::Event &evt, const std::
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraHelper::SelectNeutrinoPFParticles(const PFParticleVector &inputParticles, PFParticleVector &outputParticles)
+void LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector &particleVector, const PFParticlesToSpacePointsIndex &particlesToSpacePoints,
+    const SpacePointsToHitsIndex &spacePointsToHits, PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles,
+    const DaughterMode daughterMode)
 {
-    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
+    // Resolve the parent/daughter hierarchy once, unless daughter particles are used as they are
+    const PFParticleHierarchyIndex hierarchyIndex((kUseDaughters == daughterMode) ? PFParticleVector() : particleVector);
+
+    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
+    for (const PFParticlesToSpacePointsIndex::value_type &entry : particlesToSpacePoints)
     {
-        const art::Ptr<recob::PFParticle> particle = *iter;
+        art::Ptr<recob::PFParticle> particle;
 
-        if (LArPandoraHelper::IsNeutrino(particle))
-            outputParticles.push_back(particle);
-    }
-}
+        if (!LArPandoraHelper::GetHitMapParticle(hierarchyIndex, entry.first, daughterMode, particle))
+            continue;
 
-//------------------------------------------------------------------------------------------------------------------------------------------
+        for (const art::Ptr<recob::SpacePoint> &spacepoint : entry.second)
+        {
+            if (!spacePointsToHits.count(spacepoint))
+                throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- Found a space point without an associated hit ";
 
-void LArPandoraHelper::SelectFinalStatePFParticles(const PFParticleVector &inputParticles, PFParticleVector &outputParticles)
-{
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
+            const art::Ptr<recob::Hit> &hit(spacePointsToHits.at(spacepoint));
 
-    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
-    {
-        const art::Ptr<recob::PFParticle> particle = *iter;
-        particleMap[particle->Self()] = particle;
+            particlesToHits.Add(particle, hit);
+            hitsToParticles.Set(hit, particle);
+        }
     }
 
-    // Select final-state particles
-    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
-    {
-        const art::Ptr<recob::PFParticle> particle = *iter;
-
-        if (LArPandoraHelper::IsFinalState(particleMap, particle))
-            outputParticles.push_back(particle);
-    }
+    particlesToHits.Finalize();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraHelper::CollectCosmicTags(const art::Event &evt, const std::string &label, CosmicTagVector &cosmicTagVector,
-    TracksToCosmicTags &tracksToCosmicTags)
+void LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector &particleVector, const PFParticlesToClustersIndex &particlesToClusters,
+    const ClustersToHitsIndex &clustersToHits, PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles,
+    const DaughterMode daughterMode)
 {
-    art::Handle< std::vector<anab::CosmicTag> > theCosmicTags;
-    evt.getByLabel(label, theCosmicTags);
+    // Resolve the parent/daughter hierarchy once, unless daughter particles are used as they are
+    const PFParticleHierarchyIndex hierarchyIndex((kUseDaughters == daughterMode) ? PFParticleVector() : particleVector);
 
-    if (theCosmicTags.isValid())
+    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
+    for (const PFParticlesToClustersIndex::value_type &entry : particlesToClusters)
     {
-        art::FindOneP<recob::Track> theCosmicAssns(theCosmicTags, evt, label); // We assume there is one tag per algorithm
-        for (unsigned int i = 0; i < theCosmicTags->size(); ++i)
-        {
-            const art::Ptr<anab::CosmicTag> cosmicTag(theCosmicTags, i);
-            const art::Ptr<recob::Track> track = theCosmicAssns.at(i);
-            tracksToCosmicTags[track].push_back(cosmicTag); // We assume there could be multiple algorithms
-            cosmicTagVector.push_back(cosmicTag);
-        }
-    }
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------
+        art::Ptr<recob::PFParticle> particle;
 
-void LArPandoraHelper::CollectT0s(const art::Event &evt, const std::string &label, T0Vector &t0Vector, PFParticlesToT0s &particlesToT0s)
-{
-    art::Handle< std::vector<anab::T0> > theT0s;
-    evt.getByLabel(label, theT0s);
+        if (!LArPandoraHelper::GetHitMapParticle(hierarchyIndex, entry.first, daughterMode, particle))
+            continue;
 
-    if (theT0s.isValid())
-    {
-        art::FindManyP<recob::PFParticle> theAssns(theT0s, evt, label);
-        for (unsigned int i = 0; i < theT0s->size(); ++i)
+        for (const art::Ptr<recob::Cluster> &cluster : entry.second)
         {
-            const art::Ptr<anab::T0> theT0(theT0s, i);
-            t0Vector.push_back(theT0);
+            if (!clustersToHits.count(cluster))
+                throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- Found a cluster without associated hits ";
 
-            const std::vector< art::Ptr<recob::PFParticle> > particles = theAssns.at(i);
-            for (unsigned int j=0; j<particles.size(); ++j)
+            for (const art::Ptr<recob::Hit> &hit : clustersToHits.at(cluster))
             {
-                const art::Ptr<recob::PFParticle> theParticle = particles.at(j);
-                particlesToT0s[theParticle].push_back(theT0); // We assume there could be multiple T0s per PFParticle
+                particlesToHits.Add(particle, hit);
+                hitsToParticles.Set(hit, particle);
             }
         }
     }
+
+    particlesToHits.Finalize();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraHelper::CollectSimChannels(const art::Event &evt, const std::string &label, SimChannelVector &simChannelVector, bool &areSimChannelsValid)
+void LArPandoraHelper::BuildPFParticleHitMaps(const art::Event &evt, const std::string &label_pfpart, const std::string &label_middle,
+    PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles, const DaughterMode daughterMode, const bool useClusters)
 {
-    art::Handle< std::vector<sim::SimChannel> > theSimChannels;
+    const auto collect([&](PFParticlesToHitsIndex &cachedParticlesToHits, HitsToPFParticlesIndex &cachedHitsToParticles)
+    {
+        LArPandoraHelper::BuildPFParticleHitMaps(evt, label_pfpart, label_middle, cachedParticlesToHits, cachedHitsToParticles, daughterMode, useClusters);
+    });
+
+    const std::string cacheLabel(label_pfpart + ":" + label_middle + ":" + std::to_string(daughterMode) + (useClusters ? ":clusters" : ":spacepoints"));
+
+    // ATTN on a miss, collect builds the indices into the unfilled cache entry through the code below, then they are copied out
+    if (LArPandoraHelper::UseCollectionCache<recob::PFParticle>(evt, label_pfpart, cacheLabel, collect, particlesToHits, hitsToParticles))
+        return;
+
+    // Use intermediate clusters
+    if (useClusters)
+    {
+        PFParticleVector particleVector;
+        PFParticlesToClustersIndex particlesToClusters;
+
+        ClusterVector clusterVector;
+        ClustersToHitsIndex clustersToHits;
+
+        LArPandoraHelper::CollectPFParticles(evt, label_pfpart, particleVector, particlesToClusters);
+        LArPandoraHelper::CollectClusters(evt, label_middle, clusterVector, clustersToHits);
+
+        LArPandoraHelper::BuildPFParticleHitMaps(particleVector, particlesToClusters, clustersToHits,
+            particlesToHits, hitsToParticles, daughterMode);
+    }
+
+    // Use intermediate space points
+    else
+    {
+        PFParticleVector particleVector;
+        PFParticlesToSpacePointsIndex particlesToSpacePoints;
+
+        SpacePointVector spacePointVector;
+        SpacePointsToHitsIndex spacePointsToHits;
+
+        LArPandoraHelper::CollectPFParticles(evt, label_pfpart, particleVector, particlesToSpacePoints);
+        LArPandoraHelper::CollectSpacePoints(evt, label_middle, spacePointVector, spacePointsToHits);
+
+        LArPandoraHelper::BuildPFParticleHitMaps(particleVector, particlesToSpacePoints, spacePointsToHits,
+            particlesToHits, hitsToParticles, daughterMode);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraHelper::GetHitMapParticle(const PFParticleHierarchyIndex &hierarchyIndex, const art::Ptr<recob::PFParticle> &inputParticle,
+    const DaughterMode daughterMode, art::Ptr<recob::PFParticle> &outputParticle)
+{
+    if (kUseDaughters == daughterMode)
+    {
+        outputParticle = inputParticle;
+        return true;
+    }
+
+    // ATTN adding daughters walks up to the final-state ancestor, so the whole chain of ancestors must be in the index
+    if (kAddDaughters == daughterMode)
+    {
+        if (!hierarchyIndex.GetFinalState(inputParticle, outputParticle))
+            throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- Found a PFParticle without a particle ID ";
+
+        return true;
+    }
+
+    // ATTN ignoring daughters only needs the particle and its parent, as in IsFinalState, so a broken chain further up is not an error
+    art::Ptr<recob::PFParticle> indexedParticle;
+
+    if (!hierarchyIndex.GetParticle(inputParticle->Self(), indexedParticle) || (indexedParticle != inputParticle))
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- Found a PFParticle without a particle ID ";
+
+    outputParticle = inputParticle;
+
+    if (LArPandoraHelper::IsNeutrino(inputParticle))
+        return false;
+
+    if (inputParticle->IsPrimary())
+        return true;
+
+    art::Ptr<recob::PFParticle> parentParticle;
+
+    if (!hierarchyIndex.GetParticle(inputParticle->Parent(), parentParticle))
+        throw cet::exception("LArPandora") << " PandoraCollector::IsFinalState --- Found a PFParticle without a particle ID ";
+
+    return LArPandoraHelper::IsNeutrino(parentParticle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::SelectNeutrinoPFParticles(const PFParticleVector &inputParticles, PFParticleVector &outputParticles)
+{
+    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
+    {
+        const art::Ptr<recob::PFParticle> particle = *iter;
+
+        if (LArPandoraHelper::IsNeutrino(particle))
+            outputParticles.push_back(particle);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::SelectFinalStatePFParticles(const PFParticleVector &inputParticles, PFParticleVector &outputParticles)
+{
+    // Build mapping from particle to particle ID for parent/daughter navigation
+    PFParticleMap particleMap;
+
+    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
+    {
+        const art::Ptr<recob::PFParticle> particle = *iter;
+        particleMap[particle->Self()] = particle;
+    }
+
+    // Select final-state particles
+    for (PFParticleVector::const_iterator iter = inputParticles.begin(), iterEnd = inputParticles.end(); iter != iterEnd; ++iter)
+    {
+        const art::Ptr<recob::PFParticle> particle = *iter;
+
+        if (LArPandoraHelper::IsFinalState(particleMap, particle))
+            outputParticles.push_back(particle);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::CollectCosmicTags(const art::Event &evt, const std::string &label, CosmicTagVector &cosmicTagVector,
+    TracksToCosmicTags &tracksToCosmicTags)
+{
+    if (LArPandoraHelper::UseCollectionCache<anab::CosmicTag>(evt, label, &LArPandoraHelper::CollectCosmicTags, cosmicTagVector, tracksToCosmicTags))
+        return;
+
+    art::Handle< std::vector<anab::CosmicTag> > theCosmicTags;
+    evt.getByLabel(label, theCosmicTags);
+
+    if (theCosmicTags.isValid())
+    {
+        art::FindOneP<recob::Track> theCosmicAssns(theCosmicTags, evt, label); // We assume there is one tag per algorithm
+        for (unsigned int i = 0; i < theCosmicTags->size(); ++i)
+        {
+            const art::Ptr<anab::CosmicTag> cosmicTag(theCosmicTags, i);
+            const art::Ptr<recob::Track> track = theCosmicAssns.at(i);
+            tracksToCosmicTags[track].push_back(cosmicTag); // We assume there could be multiple algorithms
+            cosmicTagVector.push_back(cosmicTag);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::CollectT0s(const art::Event &evt, const std::string &label, T0Vector &t0Vector, PFParticlesToT0s &particlesToT0s)
+{
+    if (LArPandoraHelper::UseCollectionCache<anab::T0>(evt, label, &LArPandoraHelper::CollectT0s, t0Vector, particlesToT0s))
+        return;
+
+    art::Handle< std::vector<anab::T0> > theT0s;
+    evt.getByLabel(label, theT0s);
+
+    if (theT0s.isValid())
+    {
+        art::FindManyP<recob::PFParticle> theAssns(theT0s, evt, label);
+        for (unsigned int i = 0; i < theT0s->size(); ++i)
+        {
+            const art::Ptr<anab::T0> theT0(theT0s, i);
+            t0Vector.push_back(theT0);
+
+            const std::vector< art::Ptr<recob::PFParticle> > particles = theAssns.at(i);
+            for (unsigned int j=0; j<particles.size(); ++j)
+            {
+                const art::Ptr<recob::PFParticle> theParticle = particles.at(j);
+                particlesToT0s[theParticle].push_back(theT0); // We assume there could be multiple T0s per PFParticle
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::CollectSimChannels(const art::Event &evt, const std::string &label, SimChannelVector &simChannelVector, bool &areSimChannelsValid)
+{
+    if (LArPandoraHelper::UseCollectionCache<sim::SimChannel>(evt, label, &LArPandoraHelper::CollectSimChannels, simChannelVector, areSimChannelsValid))
+        return;
+
+    art::Handle< std::vector<sim::SimChannel> > theSimChannels;
     evt.getByLabel(label, theSimChannels);
 
     if (!theSimChannels.isValid())
@@ -763,6 +1166,9 @@ void LArPandoraHelper::CollectSimChannels(const art::Event &evt, const std::stri
 
 void LArPandoraHelper::CollectMCParticles(const art::Event &evt, const std::string &label, MCParticleVector &particleVector)
 {
+    if (LArPandoraHelper::UseCollectionCache<simb::MCParticle>(evt, label, &LArPandoraHelper::CollectMCParticles, particleVector))
+        return;
+
     art::Handle< RawMCParticleVector > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -787,6 +1193,9 @@ void LArPandoraHelper::CollectMCParticles(const art::Event &evt, const std::stri
 
 void LArPandoraHelper::CollectGeneratorMCParticles(const art::Event &evt, const std::string &label, RawMCParticleVector &particleVector)
 {
+    if (LArPandoraHelper::UseCollectionCache<simb::MCTruth>(evt, label, &LArPandoraHelper::CollectGeneratorMCParticles, particleVector))
+        return;
+
     art::Handle< std::vector<simb::MCTruth> > mcTruthBlocks;
     evt.getByLabel(label, mcTruthBlocks);
 
@@ -817,6 +1226,9 @@ void LArPandoraHelper::CollectGeneratorMCParticles(const art::Event &evt, const
 void LArPandoraHelper::CollectMCParticles(const art::Event &evt, const std::string &label, MCTruthToMCParticles &truthToParticles,
     MCParticlesToMCTruth &particlesToTruth)
 {
+    if (LArPandoraHelper::UseCollectionCache<simb::MCParticle>(evt, label, &LArPandoraHelper::CollectMCParticles, truthToParticles, particlesToTruth))
+        return;
+
     art::Handle< RawMCParticleVector > theParticles;
     evt.getByLabel(label, theParticles);
 
@@ -907,53 +1319,98 @@ void LArPandoraHelper::BuildMCParticleHitMaps(const HitsToTrackIDEs &hitsToTrack
     }
 
     // Loop over hits and build mapping between reconstructed hits and true particles
-    for (HitsToTrackIDEs::const_iterator iter1 = hitsToTrackIDEs.begin(), iterEnd1 = hitsToTrackIDEs.end(); iter1 != iterEnd1; ++iter1)
+    for (HitsToTrackIDEs::const_iterator iter = hitsToTrackIDEs.begin(), iterEnd = hitsToTrackIDEs.end(); iter != iterEnd; ++iter)
     {
-        const art::Ptr<recob::Hit> hit = iter1->first;
-        const TrackIDEVector &trackCollection = iter1->second;
+        const art::Ptr<recob::Hit> hit = iter->first;
+        art::Ptr<simb::MCParticle> selectedParticle;
 
-        int bestTrackID(-1);
-        float bestEnergyFrac(0.f);
+        if (!LArPandoraHelper::GetHitMapMCParticle(particleMap, iter->second, daughterMode, selectedParticle))
+            continue;
 
-        for (TrackIDEVector::const_iterator iter2 = trackCollection.begin(), iterEnd2 = trackCollection.end(); iter2 != iterEnd2; ++iter2)
-        {
-            const sim::TrackIDE &trackIDE = *iter2;
-            const int trackID(std::abs(trackIDE.trackID)); // TODO: Find out why std::abs is needed
-            const float energyFrac(trackIDE.energyFrac);
+        particlesToHits[selectedParticle].push_back(hit);
+        hitsToParticles[hit] = selectedParticle;
+    }
+}
 
-            if (energyFrac > bestEnergyFrac)
-            {
-                bestEnergyFrac = energyFrac;
-                bestTrackID = trackID;
-            }
-        }
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::BuildMCParticleHitMaps(const HitsToTrackIDEsIndex &hitsToTrackIDEs, const MCTruthToMCParticles &truthToParticles,
+    MCParticlesToHits &particlesToHits, HitsToMCParticles &hitsToParticles, const DaughterMode daughterMode)
+{
+    // Build mapping between particles and track IDs for parent/daughter navigation
+    MCParticleMap particleMap;
 
-        if (bestTrackID >= 0)
+    for (MCTruthToMCParticles::const_iterator iter1 = truthToParticles.begin(), iterEnd1 = truthToParticles.end(); iter1 != iterEnd1; ++iter1)
+    {
+        const MCParticleVector &particleVector = iter1->second;
+        for (MCParticleVector::const_iterator iter2 = particleVector.begin(), iterEnd2 = particleVector.end(); iter2 != iterEnd2; ++iter2)
         {
-            MCParticleMap::const_iterator iter3 = particleMap.find(bestTrackID);
-            if (particleMap.end() == iter3)
-                throw cet::exception("LArPandora") << " PandoraCollector::BuildMCParticleHitMaps --- Found a track ID without an MC Particle ";
+            const art::Ptr<simb::MCParticle> particle = *iter2;
+            particleMap[particle->TrackId()] = particle;
+        }
+    }
 
-            try
-            {
-                const art::Ptr<simb::MCParticle> thisParticle = iter3->second;
-                const art::Ptr<simb::MCParticle> primaryParticle(LArPandoraHelper::GetFinalStateMCParticle(particleMap, thisParticle));
-                const art::Ptr<simb::MCParticle> selectedParticle((kAddDaughters == daughterMode) ? primaryParticle : thisParticle);
+    // Loop over hits and build mapping between reconstructed hits and true particles
+    for (const HitsToTrackIDEsIndex::value_type &entry : hitsToTrackIDEs)
+    {
+        art::Ptr<simb::MCParticle> selectedParticle;
 
-                if ((kIgnoreDaughters == daughterMode) && (selectedParticle != primaryParticle))
-                    continue;
+        if (!LArPandoraHelper::GetHitMapMCParticle(particleMap, entry.second, daughterMode, selectedParticle))
+            continue;
 
-                if (!(LArPandoraHelper::IsVisible(selectedParticle)))
-                    continue;
+        particlesToHits[selectedParticle].push_back(entry.first);
+        hitsToParticles[entry.first] = selectedParticle;
+    }
+}
 
-                particlesToHits[selectedParticle].push_back(hit);
-                hitsToParticles[hit] = selectedParticle;
-            }
-            catch (cet::exception &e)
-            {
-            }
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraHelper::GetHitMapMCParticle(const MCParticleMap &particleMap, const TrackIDEVector &trackCollection, const DaughterMode daughterMode,
+    art::Ptr<simb::MCParticle> &outputParticle)
+{
+    int bestTrackID(-1);
+    float bestEnergyFrac(0.f);
+
+    for (TrackIDEVector::const_iterator iter = trackCollection.begin(), iterEnd = trackCollection.end(); iter != iterEnd; ++iter)
+    {
+        const sim::TrackIDE &trackIDE = *iter;
+        const int trackID(std::abs(trackIDE.trackID)); // TODO: Find out why std::abs is needed
+        const float energyFrac(trackIDE.energyFrac);
+
+        if (energyFrac > bestEnergyFrac)
+        {
+            bestEnergyFrac = energyFrac;
+            bestTrackID = trackID;
         }
     }
+
+    if (bestTrackID < 0)
+        return false;
+
+    MCParticleMap::const_iterator iter = particleMap.find(bestTrackID);
+    if (particleMap.end() == iter)
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildMCParticleHitMaps --- Found a track ID without an MC Particle ";
+
+    try
+    {
+        const art::Ptr<simb::MCParticle> thisParticle = iter->second;
+        const art::Ptr<simb::MCParticle> primaryParticle(LArPandoraHelper::GetFinalStateMCParticle(particleMap, thisParticle));
+        const art::Ptr<simb::MCParticle> selectedParticle((kAddDaughters == daughterMode) ? primaryParticle : thisParticle);
+
+        if ((kIgnoreDaughters == daughterMode) && (selectedParticle != primaryParticle))
+            return false;
+
+        if (!(LArPandoraHelper::IsVisible(selectedParticle)))
+            return false;
+
+        outputParticle = selectedParticle;
+        return true;
+    }
+    catch (cet::exception &e)
+    {
+    }
+
+    return false;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -979,6 +1436,15 @@ void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::
 void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::string &hitLabel, const std::string &backtrackLabel,
     HitsToTrackIDEs &hitsToTrackIDEs)
 {
+    const auto collect([&](HitsToTrackIDEs &cachedHitsToTrackIDEs)
+    {
+        LArPandoraHelper::BuildMCParticleHitMaps(evt, hitLabel, backtrackLabel, cachedHitsToTrackIDEs);
+    });
+
+    // ATTN the re-entrant call from collect finds its cache entry unfilled, so it reads the back tracker matching below
+    if (LArPandoraHelper::UseCollectionCache<recob::Hit>(evt, hitLabel, hitLabel + ":" + backtrackLabel, collect, hitsToTrackIDEs))
+        return;
+
     // Start by getting the collection of Hits
     art::Handle< std::vector<recob::Hit> > theHits;
     evt.getByLabel(hitLabel, theHits);
@@ -1015,35 +1481,266 @@ void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::
     {
         const art::Ptr<recob::Hit> hit = *iter;
 
-        particleVector.clear(); backtrackerVector.clear();
-        particles_per_hit.get(hit.key(), particleVector, backtrackerVector);
+        particleVector.clear(); backtrackerVector.clear();
+        particles_per_hit.get(hit.key(), particleVector, backtrackerVector);
+
+        for (unsigned int j = 0; j < particleVector.size(); ++j)
+        {
+            const art::Ptr<simb::MCParticle> particle = particleVector[j];
+
+            sim::TrackIDE trackIDE;
+            trackIDE.trackID = particle->TrackId();
+            trackIDE.energy = backtrackerVector[j]->energy;
+            trackIDE.energyFrac = backtrackerVector[j]->ideFraction;
+
+            hitsToTrackIDEs[hit].push_back(trackIDE);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::string &hitLabel, const std::string &backtrackLabel,
+    HitsToTrackIDEsIndex &hitsToTrackIDEs)
+{
+    const auto collect([&](HitsToTrackIDEsIndex &cachedHitsToTrackIDEs)
+    {
+        LArPandoraHelper::BuildMCParticleHitMaps(evt, hitLabel, backtrackLabel, cachedHitsToTrackIDEs);
+    });
+
+    // ATTN the re-entrant call from collect finds its cache entry unfilled, so it reads the back tracker matching below
+    if (LArPandoraHelper::UseCollectionCache<recob::Hit>(evt, hitLabel, hitLabel + ":" + backtrackLabel, collect, hitsToTrackIDEs))
+        return;
+
+    art::Handle< std::vector<recob::Hit> > theHits;
+    evt.getByLabel(hitLabel, theHits);
+
+    if (!theHits.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find hits... " << std::endl;
+        return;
+    }
+
+    std::vector<anab::BackTrackerHitMatchingData const*> backtrackerVector;
+
+    MCParticleVector particleVector;
+
+    art::FindManyP<simb::MCParticle, anab::BackTrackerHitMatchingData> particles_per_hit(theHits, evt, backtrackLabel);
+
+    if (!particles_per_hit.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find reco-truth matching... " << std::endl;
+        return;
+    }
+
+    // ATTN all hits come from the one collection, so the index holds the true energy deposits of each hit in a dense vector
+    for (unsigned int i = 0; i < theHits->size(); ++i)
+    {
+        const art::Ptr<recob::Hit> hit(theHits, i);
+
+        particleVector.clear(); backtrackerVector.clear();
+        particles_per_hit.get(hit.key(), particleVector, backtrackerVector);
+
+        if (particleVector.empty())
+            continue;
+
+        TrackIDEVector trackCollection;
+
+        for (unsigned int j = 0; j < particleVector.size(); ++j)
+        {
+            const art::Ptr<simb::MCParticle> particle = particleVector[j];
+
+            sim::TrackIDE trackIDE;
+            trackIDE.trackID = particle->TrackId();
+            trackIDE.energy = backtrackerVector[j]->energy;
+            trackIDE.energyFrac = backtrackerVector[j]->ideFraction;
+
+            trackCollection.push_back(trackIDE);
+        }
+
+        hitsToTrackIDEs.Set(hit, trackCollection);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::string &truthLabel, const std::string &hitLabel,
+    const std::string &backtrackLabel, MCParticlesToHits &particlesToHits, HitsToMCParticles &hitsToParticles, const DaughterMode daughterMode)
+{
+    const auto collect([&](MCParticlesToHits &cachedParticlesToHits, HitsToMCParticles &cachedHitsToParticles)
+    {
+        LArPandoraHelper::BuildMCParticleHitMaps(evt, truthLabel, hitLabel, backtrackLabel, cachedParticlesToHits, cachedHitsToParticles, daughterMode);
+    });
+
+    const std::string cacheLabel(truthLabel + ":" + hitLabel + ":" + backtrackLabel + ":" + std::to_string(daughterMode));
+
+    // ATTN collect calls back into this function, which skips the unfilled cache entry and builds the truth maps below
+    if (LArPandoraHelper::UseCollectionCache<simb::MCParticle>(evt, truthLabel, cacheLabel, collect, particlesToHits, hitsToParticles))
+        return;
+
+    MCTruthToMCParticles truthToParticles;
+    MCParticlesToMCTruth particlesToTruth;
+    HitsToTrackIDEs hitsToTrackIDEs;
+
+    LArPandoraHelper::CollectMCParticles(evt, truthLabel, truthToParticles, particlesToTruth);
+    LArPandoraHelper::BuildMCParticleHitMaps(evt, hitLabel, backtrackLabel, hitsToTrackIDEs);
+    LArPandoraHelper::BuildMCParticleHitMaps(hitsToTrackIDEs, truthToParticles, particlesToHits, hitsToParticles, daughterMode);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename Input, typename Collector, typename... Outputs>
+bool LArPandoraHelper::UseCollectionCache(const art::Event &evt, const std::string &inputLabel, const std::string &cacheLabel, const Collector &collect,
+    Outputs &... outputs)
+{
+    if (!art::ServiceRegistry::isAvailable<LArPandoraCollectionCache>())
+        return false;
+
+    art::ServiceHandle<LArPandoraCollectionCache> collectionCache;
+
+    if (!collectionCache->IsEnabled())
+        return false;
+
+    // ATTN a missing input is not cached, as a later module may still put it in the event; the function reports it instead
+    art::Handle< std::vector<Input> > theInputs;
+    evt.getByLabel(inputLabel, theInputs);
+
+    if (!theInputs.isValid())
+        return false;
+
+    typedef std::tuple<Outputs...> CachedOutputs;
+
+    bool isFilled(false);
+    CachedOutputs *pCachedOutputs(collectionCache->GetEntry<CachedOutputs>(evt, cacheLabel, theInputs.id(), isFilled));
+
+    // ATTN the entry is being filled by an outer call for the same objects, which needs this call to do the work itself
+    if (pCachedOutputs && !isFilled)
+        return false;
+
+    if (!pCachedOutputs)
+    {
+        pCachedOutputs = &collectionCache->AddEntry<CachedOutputs>(evt, cacheLabel, theInputs.id());
+
+        try
+        {
+            std::apply(collect, *pCachedOutputs);
+        }
+        catch (...)
+        {
+            collectionCache->RemoveEntry<CachedOutputs>(cacheLabel, theInputs.id());
+            throw;
+        }
+
+        collectionCache->SetFilled<CachedOutputs>(cacheLabel, theInputs.id());
+    }
+
+    // ATTN the outputs are owned by the caller and may already hold objects, so the cached objects are copied into them
+    const auto addOutputs([&](const Outputs &... cached)
+    {
+        (LArPandoraHelper::AddCachedOutput(cached, outputs), ...);
+    });
+
+    std::apply(addOutputs, *pCachedOutputs);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename Input, typename... Outputs>
+bool LArPandoraHelper::UseCollectionCache(const art::Event &evt, const std::string &label,
+    void (*pCollect)(const art::Event &, const std::string &, Outputs &...), Outputs &... outputs)
+{
+    const auto collect([&](Outputs &... cachedOutputs)
+    {
+        (*pCollect)(evt, label, cachedOutputs...);
+    });
+
+    return LArPandoraHelper::UseCollectionCache<Input>(evt, label, label, collect, outputs...);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void LArPandoraHelper::AddCachedOutput(const std::vector<T> &cached, std::vector<T> &output)
+{
+    output.insert(output.end(), cached.begin(), cached.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+void LArPandoraHelper::AddCachedOutput(const std::map<K, std::vector<V> > &cached, std::map<K, std::vector<V> > &output)
+{
+    if (output.empty())
+    {
+        output = cached;
+        return;
+    }
+
+    for (const typename std::map<K, std::vector<V> >::value_type &entry : cached)
+    {
+        std::vector<V> &values(output[entry.first]);
+        values.insert(values.end(), entry.second.begin(), entry.second.end());
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+void LArPandoraHelper::AddCachedOutput(const std::map<K, V> &cached, std::map<K, V> &output)
+{
+    if (output.empty())
+    {
+        output = cached;
+        return;
+    }
+
+    for (const typename std::map<K, V>::value_type &entry : cached)
+        output[entry.first] = entry.second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+void LArPandoraHelper::AddCachedOutput(const PtrToVectorIndex<K, U> &cached, PtrToVectorIndex<K, U> &output)
+{
+    if (output.empty())
+    {
+        output = cached;
+        return;
+    }
+
+    for (const typename PtrToVectorIndex<K, U>::value_type &entry : cached)
+    {
+        for (const art::Ptr<U> &value : entry.second)
+            output.Add(entry.first, value);
+    }
 
-        for (unsigned int j = 0; j < particleVector.size(); ++j)
-        {
-            const art::Ptr<simb::MCParticle> particle = particleVector[j];
+    output.Finalize();
+}
 
-            sim::TrackIDE trackIDE;
-            trackIDE.trackID = particle->TrackId();
-            trackIDE.energy = backtrackerVector[j]->energy;
-            trackIDE.energyFrac = backtrackerVector[j]->ideFraction;
+//------------------------------------------------------------------------------------------------------------------------------------------
 
-            hitsToTrackIDEs[hit].push_back(trackIDE);
-        }
+template <typename K, typename V>
+void LArPandoraHelper::AddCachedOutput(const PtrToValueIndex<K, V> &cached, PtrToValueIndex<K, V> &output)
+{
+    if (output.empty())
+    {
+        output = cached;
+        return;
     }
+
+    for (const typename PtrToValueIndex<K, V>::value_type &entry : cached)
+        output.Set(entry.first, entry.second);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraHelper::BuildMCParticleHitMaps(const art::Event &evt, const std::string &truthLabel, const std::string &hitLabel,
-    const std::string &backtrackLabel, MCParticlesToHits &particlesToHits, HitsToMCParticles &hitsToParticles, const DaughterMode daughterMode)
+template <typename T>
+void LArPandoraHelper::AddCachedOutput(const T &cached, T &output)
 {
-    MCTruthToMCParticles truthToParticles;
-    MCParticlesToMCTruth particlesToTruth;
-    HitsToTrackIDEs hitsToTrackIDEs;
-
-    LArPandoraHelper::CollectMCParticles(evt, truthLabel, truthToParticles, particlesToTruth);
-    LArPandoraHelper::BuildMCParticleHitMaps(evt, hitLabel, backtrackLabel, hitsToTrackIDEs);
-    LArPandoraHelper::BuildMCParticleHitMaps(hitsToTrackIDEs, truthToParticles, particlesToHits, hitsToParticles, daughterMode);
+    output = cached;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1052,11 +1749,16 @@ template <typename T>
 void LArPandoraHelper::GetAssociatedHits(const art::Event &evt, const std::string &label, const std::vector<art::Ptr<T> > &inputVector,
     HitVector &associatedHits, const pandora::IntVector* const indexVector)
 {
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::GetAssociatedHits(associationCache, label, inputVector, associatedHits, indexVector);
+}
 
-    art::Handle<std::vector<T> > handle;
-    evt.getByLabel(label, handle);
-    art::FindManyP<recob::Hit> hitAssoc(handle, evt, label);
+//------------------------------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+void LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache &associationCache, const std::string &label, const std::vector<art::Ptr<T> > &inputVector,
+    HitVector &associatedHits, const pandora::IntVector* const indexVector)
+{
     if (indexVector != nullptr)
     {
         if (inputVector.size() != indexVector->size())
@@ -1066,7 +1768,7 @@ void LArPandoraHelper::GetAssociatedHits(const art::Event &evt, const std::strin
         for (int index : (*indexVector))
         {
             const art::Ptr<T> &element = inputVector.at(index);
-            const HitVector &hits = hitAssoc.at(element.key());
+            const HitVector &hits = associationCache.GetAssociated<T, recob::Hit>(label, element);
             associatedHits.insert(associatedHits.end(), hits.begin(), hits.end());
         }
     }
@@ -1075,7 +1777,7 @@ void LArPandoraHelper::GetAssociatedHits(const art::Event &evt, const std::strin
         // If indexVector is empty just loop through inputSpacePoints
         for (const art::Ptr<T> &element : inputVector)
         {
-            const HitVector &hits = hitAssoc.at(element.key());
+            const HitVector &hits = associationCache.GetAssociated<T, recob::Hit>(label, element);
             associatedHits.insert(associatedHits.end(), hits.begin(), hits.end());
         }
     }
@@ -1381,10 +2083,396 @@ larpandoraobj::PFParticleMetadata LArPandoraHelper::GetPFParticleMetadata(const
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+const PFParticleVector &PFParticleAssociations::GetParticles() const
+{
+    return m_particles;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const SpacePointVector &PFParticleAssociations::GetSpacePoints(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_spacePoints, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const ClusterVector &PFParticleAssociations::GetClusters(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_clusters, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const VertexVector &PFParticleAssociations::GetVertices(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_vertices, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const MetadataVector &PFParticleAssociations::GetMetadata(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_metadata, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const T0Vector &PFParticleAssociations::GetT0s(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_t0s, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const SeedVector &PFParticleAssociations::GetSeeds(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_seeds, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const HitVector &PFParticleAssociations::GetClusterHits(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return this->GetAssociated(m_clusterHits, particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+void PFParticleAssociations::FillAssociated(const art::Event &evt, const std::string &label, std::vector<std::vector<art::Ptr<T> > > &associated) const
+{
+    const art::FindManyP<T> theAssns(m_handle, evt, label);
+
+    if (!theAssns.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find particle associations... " << std::endl;
+        return;
+    }
+
+    associated.resize(m_handle->size());
+
+    for (unsigned int i = 0; i < m_handle->size(); ++i)
+        associated[i] = theAssns.at(i);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PFParticleAssociations::FillClusterHits(const art::Event &evt, const std::string &label)
+{
+    art::Handle<std::vector<recob::Cluster> > clusterHandle;
+    evt.getByLabel(label, clusterHandle);
+
+    if (!clusterHandle.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find clusters... " << std::endl;
+        return;
+    }
+
+    // ATTN the cluster to hit association is read once, and looked up by key for the clusters of every particle
+    const art::FindManyP<recob::Hit> theAssns(clusterHandle, evt, label);
+
+    if (!theAssns.isValid())
+    {
+        mf::LogDebug("LArPandora") << "  Failed to find cluster associations... " << std::endl;
+        return;
+    }
+
+    m_clusterHits.resize(m_clusters.size());
+
+    for (unsigned int i = 0; i < m_clusters.size(); ++i)
+    {
+        for (const art::Ptr<recob::Cluster> &cluster : m_clusters[i])
+        {
+            if (cluster.id() != clusterHandle.id())
+                throw cet::exception("LArPandora") << " PFParticleAssociations::FillClusterHits --- found a cluster that is not in the collection with label " << label;
+
+            const HitVector &hits(theAssns.at(cluster.key()));
+            m_clusterHits[i].insert(m_clusterHits[i].end(), hits.begin(), hits.end());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+const std::vector<art::Ptr<T> > &PFParticleAssociations::GetAssociated(const std::vector<std::vector<art::Ptr<T> > > &associated,
+    const art::Ptr<recob::PFParticle> &particle) const
+{
+    static const std::vector<art::Ptr<T> > emptyVector;
+
+    if (!m_handle.isValid() || particle.isNull())
+        return emptyVector;
+
+    if (particle.id() != m_handle.id())
+        throw cet::exception("LArPandora") << " PFParticleAssociations::GetAssociated --- particle " << particle.key() << " is not from the held collection ";
+
+    if (particle.key() >= associated.size())
+        return emptyVector;
+
+    return associated[particle.key()];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const size_t PFParticleHierarchyIndex::kNoPosition(std::numeric_limits<size_t>::max());
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PFParticleHierarchyIndex::PFParticleHierarchyIndex(const PFParticleVector &particleVector, const PFParticlesToMetadata &particlesToMetadata) :
+    m_particles(particleVector),
+    m_metadata(particleVector.size()),
+    m_nodes(particleVector.size())
+{
+    m_idToPosition.reserve(m_particles.size());
+
+    for (size_t position = 0; position < m_particles.size(); ++position)
+    {
+        if (!m_idToPosition.insert(std::unordered_map<size_t, size_t>::value_type(m_particles.at(position)->Self(), position)).second)
+            throw cet::exception("LArPandora") << " PFParticleHierarchyIndex::PFParticleHierarchyIndex --- Found repeated PFParticle ID " << m_particles.at(position)->Self();
+
+        PFParticlesToMetadata::const_iterator metadataIter(particlesToMetadata.find(m_particles.at(position)));
+
+        if ((particlesToMetadata.end() != metadataIter) && !metadataIter->second.empty())
+            m_metadata.at(position) = metadataIter->second.front();
+    }
+
+    // Link each particle to its parent, then visit the hierarchy downward from the primary particles so parents are always resolved first
+    std::vector<std::vector<size_t> > daughterPositions(m_particles.size());
+    std::vector<size_t> positionsToVisit;
+    positionsToVisit.reserve(m_particles.size());
+
+    for (size_t position = 0; position < m_particles.size(); ++position)
+    {
+        const art::Ptr<recob::PFParticle> &particle(m_particles.at(position));
+
+        if (particle->IsPrimary())
+        {
+            positionsToVisit.push_back(position);
+            continue;
+        }
+
+        std::unordered_map<size_t, size_t>::const_iterator parentIter(m_idToPosition.find(particle->Parent()));
+
+        if ((m_idToPosition.end() != parentIter) && (parentIter->second != position))
+            daughterPositions.at(parentIter->second).push_back(position);
+    }
+
+    for (size_t visitIndex = 0; visitIndex < positionsToVisit.size(); ++visitIndex)
+    {
+        const size_t position(positionsToVisit.at(visitIndex));
+        Node &node(m_nodes.at(position));
+        node.m_isNeutrino = LArPandoraHelper::IsNeutrino(m_particles.at(position));
+
+        if (kNoPosition == node.m_parentPosition)
+        {
+            float value(0.f);
+            node.m_rootPosition = position;
+            node.m_finalStatePosition = position;
+            node.m_generation = 1;
+            node.m_isClearCosmic = (PFParticleHierarchyIndex::GetMetadataValue(m_metadata.at(position), "IsClearCosmic", value) &&
+                static_cast<bool>(std::round(value)));
+            node.m_hasSliceIndex = PFParticleHierarchyIndex::GetMetadataValue(m_metadata.at(position), "SliceIndex", value);
+            node.m_sliceIndex = (node.m_hasSliceIndex ? static_cast<unsigned int>(std::round(value)) : 0);
+        }
+        else
+        {
+            const Node &parentNode(m_nodes.at(node.m_parentPosition));
+            node.m_rootPosition = parentNode.m_rootPosition;
+            node.m_finalStatePosition = (parentNode.m_isNeutrino ? position : parentNode.m_finalStatePosition);
+            node.m_generation = parentNode.m_generation + 1;
+            node.m_isClearCosmic = parentNode.m_isClearCosmic;
+            node.m_hasSliceIndex = parentNode.m_hasSliceIndex;
+            node.m_sliceIndex = parentNode.m_sliceIndex;
+        }
+
+        for (const size_t daughterPosition : daughterPositions.at(position))
+        {
+            m_nodes.at(daughterPosition).m_parentPosition = position;
+            positionsToVisit.push_back(daughterPosition);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::IsIndexed(const art::Ptr<recob::PFParticle> &particle) const
+{
+    return (nullptr != this->GetNode(particle));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetParticle(const size_t id, art::Ptr<recob::PFParticle> &particle) const
+{
+    std::unordered_map<size_t, size_t>::const_iterator iter(m_idToPosition.find(id));
+
+    if (m_idToPosition.end() == iter)
+        return false;
+
+    particle = m_particles.at(iter->second);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetParent(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &parentParticle) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode || (kNoPosition == pNode->m_parentPosition))
+        return false;
+
+    parentParticle = m_particles.at(pNode->m_parentPosition);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetRoot(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &rootParticle) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode)
+        return false;
+
+    rootParticle = m_particles.at(pNode->m_rootPosition);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetFinalState(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &finalStateParticle) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode)
+        return false;
+
+    finalStateParticle = m_particles.at(pNode->m_finalStatePosition);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::IsFinalState(const art::Ptr<recob::PFParticle> &particle) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode || pNode->m_isNeutrino)
+        return false;
+
+    return (m_particles.at(pNode->m_finalStatePosition) == particle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetGeneration(const art::Ptr<recob::PFParticle> &particle, int &generation) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode)
+        return false;
+
+    generation = pNode->m_generation;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetSliceIndex(const art::Ptr<recob::PFParticle> &particle, unsigned int &sliceIndex) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode || !pNode->m_hasSliceIndex)
+        return false;
+
+    sliceIndex = pNode->m_sliceIndex;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::IsClearCosmic(const art::Ptr<recob::PFParticle> &particle) const
+{
+    const Node *const pNode(this->GetNode(particle));
+    return (pNode && pNode->m_isClearCosmic);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetRootMetadataValue(const art::Ptr<recob::PFParticle> &particle, const std::string &key, float &value) const
+{
+    const Node *const pNode(this->GetNode(particle));
+
+    if (!pNode)
+        return false;
+
+    return PFParticleHierarchyIndex::GetMetadataValue(m_metadata.at(pNode->m_rootPosition), key, value);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const PFParticleHierarchyIndex::Node *PFParticleHierarchyIndex::GetNode(const art::Ptr<recob::PFParticle> &particle) const
+{
+    if (particle.isNull())
+        return nullptr;
+
+    std::unordered_map<size_t, size_t>::const_iterator iter(m_idToPosition.find(particle->Self()));
+
+    // ATTN particles from another collection may share an ID with an indexed particle
+    if ((m_idToPosition.end() == iter) || (m_particles.at(iter->second) != particle))
+        return nullptr;
+
+    const Node &node(m_nodes.at(iter->second));
+    return ((kNoPosition == node.m_rootPosition) ? nullptr : &node);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool PFParticleHierarchyIndex::GetMetadataValue(const art::Ptr<larpandoraobj::PFParticleMetadata> &metadata, const std::string &key, float &value)
+{
+    if (metadata.isNull())
+        return false;
+
+    const larpandoraobj::PFParticleMetadata::PropertiesMap &propertiesMap(metadata->GetPropertiesMap());
+    larpandoraobj::PFParticleMetadata::PropertiesMap::const_iterator iter(propertiesMap.find(key));
+
+    if (propertiesMap.end() == iter)
+        return false;
+
+    value = iter->second;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PFParticleHierarchyIndex::Node::Node() :
+    m_parentPosition(PFParticleHierarchyIndex::kNoPosition),
+    m_rootPosition(PFParticleHierarchyIndex::kNoPosition),
+    m_finalStatePosition(PFParticleHierarchyIndex::kNoPosition),
+    m_generation(0),
+    m_isNeutrino(false),
+    m_isClearCosmic(false),
+    m_hasSliceIndex(false),
+    m_sliceIndex(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 template void LArPandoraHelper::GetAssociatedHits(const art::Event &, const std::string &, const std::vector<art::Ptr<recob::Cluster> > &,
     HitVector &, const pandora::IntVector* const);
 
 template void LArPandoraHelper::GetAssociatedHits(const art::Event &, const std::string &, const std::vector<art::Ptr<recob::SpacePoint> > &,
     HitVector &, const pandora::IntVector* const);
 
+template void LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache &, const std::string &, const std::vector<art::Ptr<recob::Cluster> > &,
+    HitVector &, const pandora::IntVector* const);
+
+template void LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache &, const std::string &, const std::vector<art::Ptr<recob::SpacePoint> > &,
+    HitVector &, const pandora::IntVector* const);
+
 } // namespace lar_pandora
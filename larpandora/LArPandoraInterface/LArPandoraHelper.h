@@ -8,11 +8,23 @@
 #define LAR_PANDORA_HELPER_H
 
 #include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+
+#include "canvas/Persistency/Common/Ptr.h"
+
+#include "cetlib_except/exception.h"
 
 #include "lardataobj/Simulation/SimChannel.h"
 
+#include "larpandora/LArPandoraInterface/CompressedAssociation.h"
+
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace anab {class CosmicTag; class T0;}
@@ -27,6 +39,10 @@ namespace simb {class MCParticle; class MCTruth;}
 namespace lar_pandora
 {
 
+class LArPandoraAssociationCache;
+class PFParticleAssociations;
+class PFParticleHierarchyIndex;
+
 typedef std::set< art::Ptr<recob::Hit> > HitList;
 
 typedef std::vector< art::Ptr<recob::Wire> >        WireVector;
@@ -87,6 +103,230 @@ typedef std::map< const pandora::ParticleFlowObject*, size_t> ThreeDParticleMap;
 typedef std::map< const pandora::Vertex*, unsigned int> ThreeDVertexMap;
 typedef std::map< int, HitVector > HitArray;
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PtrToVectorIndex class
+ *
+ *  Flat alternative to std::map<art::Ptr<K>, std::vector<art::Ptr<U> > > for keys from a single collection (product ID). The values
+ *  are held in a CompressedAssociation with one row per Ptr key. Values are added with Add, then Finalize builds the rows, keeping the
+ *  order in which the values of each key were added. As with the maps, the index can be filled again: values added after Finalize are
+ *  placed after those already held for their key at the next call to Finalize. Accessors mirror std::map: count, at, size, empty and
+ *  iteration over the keys with values, in key order. A key from another collection has no values for count, but at throws for it.
+ */
+template <typename K, typename U>
+class PtrToVectorIndex
+{
+public:
+    typedef typename CompressedAssociation<K, U>::Row Range;
+    typedef std::pair<art::Ptr<K>, Range> value_type;
+
+    /**
+     *  @brief  const_iterator class, visiting the keys with values in key order
+     */
+    class const_iterator
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pIndex address of the index
+         *  @param  key the Ptr key to start from
+         */
+        const_iterator(const PtrToVectorIndex *const pIndex, const size_t key);
+
+        value_type operator*() const;
+        const_iterator &operator++();
+        bool operator==(const const_iterator &rhs) const;
+        bool operator!=(const const_iterator &rhs) const;
+
+    private:
+        const PtrToVectorIndex *m_pIndex;   ///< Address of the index
+        size_t                  m_key;      ///< The current Ptr key
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    PtrToVectorIndex();
+
+    /**
+     *  @brief  Add a value for a key, to be indexed at the next call to Finalize
+     *
+     *  @param  key the key, which must come from the same collection as all other keys
+     *  @param  value the value
+     */
+    void Add(const art::Ptr<K> &key, const art::Ptr<U> &value);
+
+    /**
+     *  @brief  Index the values added since the last call, after any values already held for the same keys
+     */
+    void Finalize();
+
+    /**
+     *  @brief  Get the number of values for a key (zero or one for the key, as for std::map), zero for a key from another collection
+     *
+     *  @param  key the key
+     */
+    size_t count(const art::Ptr<K> &key) const;
+
+    /**
+     *  @brief  Get the values for a key, throwing if the key has no values
+     *
+     *  @param  key the key
+     */
+    Range at(const art::Ptr<K> &key) const;
+
+    /**
+     *  @brief  Get the number of keys with values
+     */
+    size_t size() const;
+
+    /**
+     *  @brief  Whether no key has values
+     */
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    /**
+     *  @brief  Get the Ptr key of a key in the index, the number of slots if the key has no values. Throws if values have been added
+     *          since the last call to Finalize
+     *
+     *  @param  key the key
+     *  @param  allowOtherCollection whether a key from another collection has no values, rather than throwing
+     */
+    size_t GetSlot(const art::Ptr<K> &key, const bool allowOtherCollection) const;
+
+    /**
+     *  @brief  Get the first Ptr key at or after a given key that has values
+     *
+     *  @param  key the Ptr key to start from
+     */
+    size_t GetNextKey(size_t key) const;
+
+    art::ProductID                  m_productId;        ///< The product ID of the keys, invalid until a value is added
+    size_t                          m_nKeys;            ///< The number of keys with values
+    std::vector<art::Ptr<K> >       m_keys;             ///< The key for each Ptr key, null if the key has no values
+    CompressedAssociation<K, U>     m_association;      ///< The values, in one row per Ptr key
+    std::vector<art::Ptr<K> >       m_addedKeys;        ///< The key of each value added since the last call to Finalize
+    std::vector<art::Ptr<U> >       m_addedValues;      ///< The values added since the last call to Finalize
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PtrToValueIndex class
+ *
+ *  Flat alternative to std::map<art::Ptr<K>, V> for keys from a single collection (product ID), holding one value per Ptr key in a
+ *  dense vector. As for std::map::operator[], setting the value of a key replaces any previous value. Accessors mirror std::map: count,
+ *  at, size, empty and iteration over the keys with values, in key order. A key from another collection has no value for count, but at
+ *  throws for it.
+ */
+template <typename K, typename V>
+class PtrToValueIndex
+{
+public:
+    typedef std::pair<art::Ptr<K>, V> value_type;
+
+    /**
+     *  @brief  const_iterator class, visiting the keys with values in key order
+     */
+    class const_iterator
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  pIndex address of the index
+         *  @param  key the Ptr key to start from
+         */
+        const_iterator(const PtrToValueIndex *const pIndex, const size_t key);
+
+        value_type operator*() const;
+        const_iterator &operator++();
+        bool operator==(const const_iterator &rhs) const;
+        bool operator!=(const const_iterator &rhs) const;
+
+    private:
+        const PtrToValueIndex  *m_pIndex;   ///< Address of the index
+        size_t                  m_key;      ///< The current Ptr key
+    };
+
+    /**
+     *  @brief  Default constructor
+     */
+    PtrToValueIndex();
+
+    /**
+     *  @brief  Set the value for a key, replacing any previous value
+     *
+     *  @param  key the key, which must come from the same collection as all other keys
+     *  @param  value the value
+     */
+    void Set(const art::Ptr<K> &key, const V &value);
+
+    /**
+     *  @brief  Get the number of values for a key (zero or one), zero for a key from another collection
+     *
+     *  @param  key the key
+     */
+    size_t count(const art::Ptr<K> &key) const;
+
+    /**
+     *  @brief  Get the value for a key, throwing if the key has no value
+     *
+     *  @param  key the key
+     */
+    const V &at(const art::Ptr<K> &key) const;
+
+    /**
+     *  @brief  Get the number of keys with values
+     */
+    size_t size() const;
+
+    /**
+     *  @brief  Whether no key has a value
+     */
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    /**
+     *  @brief  Get the first Ptr key at or after a given key that has a value
+     *
+     *  @param  key the Ptr key to start from
+     */
+    size_t GetNextKey(size_t key) const;
+
+    /**
+     *  @brief  Get the Ptr key of a key in the index, the number of slots if the key has no value
+     *
+     *  @param  key the key
+     *  @param  allowOtherCollection whether a key from another collection has no value, rather than throwing
+     */
+    size_t GetSlot(const art::Ptr<K> &key, const bool allowOtherCollection) const;
+
+    art::ProductID              m_productId;        ///< The product ID of the keys, invalid until a value is set
+    size_t                      m_nKeys;            ///< The number of keys with values
+    std::vector<art::Ptr<K> >   m_keys;             ///< The key for each Ptr key, null if the key has no value
+    std::vector<V>              m_values;           ///< The value for each Ptr key
+};
+
+typedef PtrToVectorIndex< recob::PFParticle, recob::SpacePoint >            PFParticlesToSpacePointsIndex;
+typedef PtrToVectorIndex< recob::PFParticle, recob::Cluster >               PFParticlesToClustersIndex;
+typedef PtrToVectorIndex< recob::PFParticle, recob::Hit >                   PFParticlesToHitsIndex;
+typedef PtrToVectorIndex< recob::Cluster,    recob::Hit >                   ClustersToHitsIndex;
+typedef PtrToValueIndex< recob::SpacePoint,  art::Ptr<recob::Hit> >         SpacePointsToHitsIndex;
+typedef PtrToValueIndex< recob::Hit,         art::Ptr<recob::PFParticle> >  HitsToPFParticlesIndex;
+typedef PtrToValueIndex< recob::Hit,         TrackIDEVector >               HitsToTrackIDEsIndex;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 /**
  *  @brief  LArPandoraHelper class
  */
@@ -103,6 +343,20 @@ public:
         kAddDaughters = 2        // Absorb daughter particles into parent particles
     };
 
+    /**
+     *  @brief  PFParticleAssociationKind enumeration, values may be combined to request several kinds at once
+     */
+    enum PFParticleAssociationKind
+    {
+        kSpacePointAssociations = 1,    // Associated space points
+        kClusterAssociations = 2,       // Associated clusters
+        kVertexAssociations = 4,        // Associated vertices
+        kMetadataAssociations = 8,      // Associated metadata
+        kT0Associations = 16,           // Associated T0s
+        kSeedAssociations = 32,         // Associated seeds
+        kClusterHitAssociations = 64    // Hits of the associated clusters, also filling the associated clusters
+    };
+
     /**
      *  @brief Collect the reconstructed wires from the ART event record
      *
@@ -153,6 +407,17 @@ public:
     static void CollectSpacePoints(const art::Event &evt, const std::string &label, SpacePointVector &spacePointVector,
         SpacePointsToHits &spacePointsToHits, HitsToSpacePoints &hitsToSpacePoints);
 
+    /**
+     *  @brief Collect the reconstructed SpacePoints and associated hits from the ART event record, into a flat index
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the SpacePoint list in the event
+     *  @param spacePointVector the output vector of SpacePoint objects
+     *  @param spacePointsToHits the output index from SpacePoint to Hit objects
+     */
+    static void CollectSpacePoints(const art::Event &evt, const std::string &label, SpacePointVector &spacePointVector,
+        SpacePointsToHitsIndex &spacePointsToHits);
+
     /**
      *  @brief Collect the reconstructed Clusters and associated hits from the ART event record
      *
@@ -164,6 +429,17 @@ public:
     static void CollectClusters(const art::Event &evt, const std::string &label, ClusterVector &clusterVector,
         ClustersToHits &clustersToHits);
 
+    /**
+     *  @brief Collect the reconstructed Clusters and associated hits from the ART event record, into a flat index
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Cluster list in the event
+     *  @param clusterVector the output vector of Cluster objects
+     *  @param clustersToHits the output index from Cluster to Hit objects
+     */
+    static void CollectClusters(const art::Event &evt, const std::string &label, ClusterVector &clusterVector,
+        ClustersToHitsIndex &clustersToHits);
+
     /**
      *  @brief Collect the reconstructed PFParticles and associated SpacePoints from the ART event record
      *
@@ -186,6 +462,40 @@ public:
     static void CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
         PFParticlesToClusters &particlesToClusters);
 
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated SpacePoints from the ART event record, into a flat index
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToSpacePoints the output index from PFParticle to SpacePoint objects
+     */
+    static void CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
+        PFParticlesToSpacePointsIndex &particlesToSpacePoints);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated Clusters from the ART event record, into a flat index
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToClusters the output index from PFParticle to Cluster objects
+     */
+    static void CollectPFParticles(const art::Event &evt, const std::string &label, PFParticleVector &particleVector,
+        PFParticlesToClustersIndex &particlesToClusters);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and several kinds of associated objects from the ART event record, reading the
+     *         PFParticle collection once and building each requested association once
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param associationKinds the requested association kinds, a combination of PFParticleAssociationKind values
+     *  @param associations the output PFParticles and their associated objects
+     */
+    static void CollectPFParticleAssociations(const art::Event &evt, const std::string &label, const unsigned int associationKinds,
+        PFParticleAssociations &associations);
+
     /**
      *  @brief Collect the reconstructed PFParticle Metadata from the ART event record
      *
@@ -331,6 +641,49 @@ public:
         PFParticlesToHits &particlesToHits, HitsToPFParticles &hitsToParticles, const DaughterMode daughterMode = kUseDaughters,
         const bool useClusters = true);
 
+    /**
+     *  @brief Build flat indices between PFParticles and Hits using PFParticle/SpacePoint/Hit indices
+     *
+     *  @param particleVector the input vector of PFParticle objects
+     *  @param particlesToSpacePoints the input index from PFParticle to SpacePoint objects
+     *  @param spacePointsToHits the input index from SpacePoint to Hit objects
+     *  @param particlesToHits the output index from PFParticle to Hit objects
+     *  @param hitsToParticles the output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of maps
+     */
+    static void BuildPFParticleHitMaps(const PFParticleVector &particleVector, const PFParticlesToSpacePointsIndex &particlesToSpacePoints,
+        const SpacePointsToHitsIndex &spacePointsToHits, PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles,
+        const DaughterMode daughterMode = kUseDaughters);
+
+    /**
+     *  @brief Build flat indices between PFParticles and Hits using PFParticle/Cluster/Hit indices
+     *
+     *  @param particleVector the input vector of PFParticle objects
+     *  @param particlesToClusters the input index from PFParticle to Cluster objects
+     *  @param clustersToHits the input index from Cluster to Hit objects
+     *  @param particlesToHits the output index from PFParticle to Hit objects
+     *  @param hitsToParticles the output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of maps
+     */
+    static void BuildPFParticleHitMaps(const PFParticleVector &particleVector, const PFParticlesToClustersIndex &particlesToClusters,
+        const ClustersToHitsIndex &clustersToHits, PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles,
+        const DaughterMode daughterMode = kUseDaughters);
+
+    /**
+     *  @brief Build flat indices between PFParticles and Hits starting from ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label_pfpart the label for the PFParticle list in the event
+     *  @param label_mid the label for the Intermediate list in the event
+     *  @param particlesToHits output index from PFParticle to Hit objects
+     *  @param hitsToParticles output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of maps
+     *  @param useClusters choice of intermediate object (true for Clusters, false for SpacePoints)
+     */
+    static void BuildPFParticleHitMaps(const art::Event &evt, const std::string &label_pfpart, const std::string &label_mid,
+        PFParticlesToHitsIndex &particlesToHits, HitsToPFParticlesIndex &hitsToParticles, const DaughterMode daughterMode = kUseDaughters,
+        const bool useClusters = true);
+
     /**
      *  @brief Collect a vector of cosmic tags from the ART event record
      *
@@ -414,6 +767,18 @@ public:
     static void BuildMCParticleHitMaps(const HitsToTrackIDEs &hitsToTrackIDEs, const MCTruthToMCParticles &truthToParticles,
         MCParticlesToHits &particlesToHits, HitsToMCParticles &hitsToParticles, const DaughterMode daughterMode = kUseDaughters);
 
+    /**
+     *  @brief Build mapping between Hits and MCParticles, starting from a flat index of Hit/TrackIDE and MCParticle information
+     *
+     *  @param hitsToTrackIDEs the input index from hits to true energy deposits
+     *  @param truthToParticles the input map of truth information
+     *  @param particlesToHits the mapping between true particles and reconstructed hits
+     *  @param hitsToParticles the mapping between reconstructed hits and true particles
+     *  @param daughterMode treatment of daughter particles in construction of maps
+     */
+    static void BuildMCParticleHitMaps(const HitsToTrackIDEsIndex &hitsToTrackIDEs, const MCTruthToMCParticles &truthToParticles,
+        MCParticlesToHits &particlesToHits, HitsToMCParticles &hitsToParticles, const DaughterMode daughterMode = kUseDaughters);
+
     /**
      *  @brief Build mapping between Hits and MCParticles, starting from ART event record
      *
@@ -438,6 +803,17 @@ public:
     static void BuildMCParticleHitMaps(const art::Event &evt, const std::string &hitLabel, const std::string &backtrackLabel,
         HitsToTrackIDEs &hitsToTrackIDEs);
 
+    /**
+     *  @brief  Get flat index between hits and true energy deposits using back-tracker information
+     *
+     *  @param  evt the event record
+     *  @param  hitLabel the label of the collection of hits
+     *  @param  backtrackLabel the label of the collection of back-tracker information
+     *  @param  hitsToTrackIDEs the output index between hits and true energy deposits
+     */
+    static void BuildMCParticleHitMaps(const art::Event &evt, const std::string &hitLabel, const std::string &backtrackLabel,
+        HitsToTrackIDEsIndex &hitsToTrackIDEs);
+
     /**
      *  @brief Build mapping between Hits and MCParticles, starting from Hit/TrackIDE/MCParticle information
      *
@@ -466,6 +842,19 @@ public:
     static void GetAssociatedHits(const art::Event &evt, const std::string &label, const std::vector<art::Ptr<T> > &inputVector,
         HitVector &associatedHits, const pandora::IntVector* const indexVector = nullptr);
 
+    /**
+     *  @brief  Get all hits associated with input clusters, using associations read once per event
+     *
+     *  @param  associationCache the association cache for the event containing the hits
+     *  @param  label the label of the collection producing PFParticles
+     *  @param  input vector input of T (clusters, spacepoints)
+     *  @param  associatedHits output hits associated with T
+     *  @param  indexVector vector of spacepoint indices reflecting trajectory points sorting order
+     */
+    template <typename T>
+    static void GetAssociatedHits(LArPandoraAssociationCache &associationCache, const std::string &label, const std::vector<art::Ptr<T> > &inputVector,
+        HitVector &associatedHits, const pandora::IntVector* const indexVector = nullptr);
+
     /**
      *  @brief Select reconstructed neutrino particles from a list of all reconstructed particles
      *
@@ -620,8 +1009,792 @@ public:
      *  @return larpandoraobj::PFParticleMetadata
      */
     static larpandoraobj::PFParticleMetadata GetPFParticleMetadata(const pandora::ParticleFlowObject *const pPfo);
+
+private:
+    /**
+     *  @brief Get the particle to which the hits of a particle are assigned, for a given treatment of daughter particles
+     *
+     *  @param hierarchyIndex the hierarchy index of the particles, which may be empty when using daughters
+     *  @param inputParticle the particle owning the hits
+     *  @param daughterMode treatment of daughter particles
+     *  @param outputParticle to receive the particle to which the hits are assigned
+     *
+     *  @return whether the hits should be assigned
+     */
+    static bool GetHitMapParticle(const PFParticleHierarchyIndex &hierarchyIndex, const art::Ptr<recob::PFParticle> &inputParticle,
+        const DaughterMode daughterMode, art::Ptr<recob::PFParticle> &outputParticle);
+
+    /**
+     *  @brief Get the true particle to which a hit is assigned, from its true energy deposits, for a given treatment of daughter particles
+     *
+     *  @param particleMap the mapping from track IDs to true particles
+     *  @param trackCollection the true energy deposits of the hit
+     *  @param daughterMode treatment of daughter particles
+     *  @param outputParticle to receive the true particle to which the hit is assigned
+     *
+     *  @return whether the hit should be assigned
+     */
+    static bool GetHitMapMCParticle(const MCParticleMap &particleMap, const TrackIDEVector &trackCollection, const DaughterMode daughterMode,
+        art::Ptr<simb::MCParticle> &outputParticle);
+
+    /**
+     *  @brief Fill the outputs of a helper function from the LArPandoraCollectionCache service, if the service is enabled
+     *
+     *  The cache entry is identified by the cache label, the output types and the product id of the input collection of objects of type
+     *  Input. On the first call in an event, the function is called to fill the entry. It re-enters this function, which finds the entry
+     *  unfilled and returns false, so the function does the work itself. The cached objects are then added to the outputs, as the
+     *  function would add them, which copies them (art::Ptr copies) on every call. Nothing is cached if the input collection is missing.
+     *
+     *  @param evt the ART event record
+     *  @param inputLabel the label of the input collection of objects of type Input
+     *  @param cacheLabel the cache label, identifying the input labels and options of the function
+     *  @param collect the function filling the outputs
+     *  @param outputs the outputs to fill
+     *
+     *  @return whether the outputs were filled from the cache
+     */
+    template <typename Input, typename Collector, typename... Outputs>
+    static bool UseCollectionCache(const art::Event &evt, const std::string &inputLabel, const std::string &cacheLabel, const Collector &collect,
+        Outputs &... outputs);
+
+    /**
+     *  @brief Fill the outputs of a helper function, taking only the event and the label of an input collection of objects of type Input,
+     *         from the LArPandoraCollectionCache service
+     *
+     *  @param evt the ART event record
+     *  @param label the label passed to the function
+     *  @param pCollect the function filling the outputs
+     *  @param outputs the outputs to fill
+     *
+     *  @return whether the outputs were filled from the cache
+     */
+    template <typename Input, typename... Outputs>
+    static bool UseCollectionCache(const art::Event &evt, const std::string &label,
+        void (*pCollect)(const art::Event &, const std::string &, Outputs &...), Outputs &... outputs);
+
+    /**
+     *  @brief Add cached objects to a vector output
+     *
+     *  @param cached the cached objects
+     *  @param output the output vector
+     */
+    template <typename T>
+    static void AddCachedOutput(const std::vector<T> &cached, std::vector<T> &output);
+
+    /**
+     *  @brief Add cached objects to a one-to-many map output, appending to the vector of each key
+     *
+     *  @param cached the cached objects
+     *  @param output the output map
+     */
+    template <typename K, typename V>
+    static void AddCachedOutput(const std::map<K, std::vector<V> > &cached, std::map<K, std::vector<V> > &output);
+
+    /**
+     *  @brief Add cached objects to a one-to-one map output, replacing the value of each key
+     *
+     *  @param cached the cached objects
+     *  @param output the output map
+     */
+    template <typename K, typename V>
+    static void AddCachedOutput(const std::map<K, V> &cached, std::map<K, V> &output);
+
+    /**
+     *  @brief Add cached objects to a flat one-to-many index output, after any values already held for each key
+     *
+     *  @param cached the cached objects
+     *  @param output the output index
+     */
+    template <typename K, typename U>
+    static void AddCachedOutput(const PtrToVectorIndex<K, U> &cached, PtrToVectorIndex<K, U> &output);
+
+    /**
+     *  @brief Add cached objects to a flat one-to-one index output, replacing the value of each key
+     *
+     *  @param cached the cached objects
+     *  @param output the output index
+     */
+    template <typename K, typename V>
+    static void AddCachedOutput(const PtrToValueIndex<K, V> &cached, PtrToValueIndex<K, V> &output);
+
+    /**
+     *  @brief Set any other output from its cached value
+     *
+     *  @param cached the cached value
+     *  @param output the output
+     */
+    template <typename T>
+    static void AddCachedOutput(const T &cached, T &output);
 };
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PFParticleAssociations class
+ *
+ *  Holds a PFParticle collection and the requested kinds of associated objects, indexed by position in the collection. Filled by
+ *  LArPandoraHelper::CollectPFParticleAssociations. Lookups return an empty vector for kinds that weren't requested or found, and for a
+ *  null particle. Looking up a particle from another collection throws.
+ */
+class PFParticleAssociations
+{
+public:
+    /**
+     *  @brief  Get the PFParticles, in collection order
+     */
+    const PFParticleVector &GetParticles() const;
+
+    /**
+     *  @brief  Get the space points associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const SpacePointVector &GetSpacePoints(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the clusters associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const ClusterVector &GetClusters(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the vertices associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const VertexVector &GetVertices(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the metadata associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const MetadataVector &GetMetadata(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the T0s associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const T0Vector &GetT0s(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the seeds associated with a particle
+     *
+     *  @param  particle the input particle
+     */
+    const SeedVector &GetSeeds(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the hits of the clusters associated with a particle, in cluster order
+     *
+     *  @param  particle the input particle
+     */
+    const HitVector &GetClusterHits(const art::Ptr<recob::PFParticle> &particle) const;
+
+private:
+    /**
+     *  @brief  Fill the objects of type T associated with each particle
+     *
+     *  @param  evt the ART event record
+     *  @param  label the label for the association in the event
+     *  @param  associated the output objects associated with each particle
+     */
+    template <typename T>
+    void FillAssociated(const art::Event &evt, const std::string &label, std::vector<std::vector<art::Ptr<T> > > &associated) const;
+
+    /**
+     *  @brief  Fill the hits of the clusters associated with each particle, from the associated clusters
+     *
+     *  @param  evt the ART event record
+     *  @param  label the label for the clusters and their association to hits in the event
+     */
+    void FillClusterHits(const art::Event &evt, const std::string &label);
+
+    /**
+     *  @brief  Get the objects of type T associated with a particle
+     *
+     *  @param  associated the objects associated with each particle
+     *  @param  particle the input particle
+     */
+    template <typename T>
+    const std::vector<art::Ptr<T> > &GetAssociated(const std::vector<std::vector<art::Ptr<T> > > &associated, const art::Ptr<recob::PFParticle> &particle) const;
+
+    art::Handle<std::vector<recob::PFParticle> >    m_handle;           ///< The handle to the PFParticle collection
+    PFParticleVector                                m_particles;        ///< The PFParticles
+    std::vector<SpacePointVector>                   m_spacePoints;      ///< The space points associated with each particle
+    std::vector<ClusterVector>                      m_clusters;         ///< The clusters associated with each particle
+    std::vector<VertexVector>                       m_vertices;         ///< The vertices associated with each particle
+    std::vector<MetadataVector>                     m_metadata;         ///< The metadata associated with each particle
+    std::vector<T0Vector>                           m_t0s;              ///< The T0s associated with each particle
+    std::vector<SeedVector>                         m_seeds;            ///< The seeds associated with each particle
+    std::vector<HitVector>                          m_clusterHits;      ///< The hits of the clusters associated with each particle
+
+    friend class LArPandoraHelper;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  PFParticleHierarchyIndex class
+ *
+ *  Resolves the parent, top-level parent, final-state ancestor, generation, neutrino flag and top-level metadata of every particle in a
+ *  collection with a single pass down the hierarchy, so that subsequent lookups are constant time. Lookups do not throw: they return false for particles that are not in
+ *  the indexed collection, or that can't be connected to a primary particle within it.
+ */
+class PFParticleHierarchyIndex
+{
+public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleVector the input vector of reconstructed particles
+     *  @param  particlesToMetadata the mapping between reconstructed particles and their metadata
+     */
+    PFParticleHierarchyIndex(const PFParticleVector &particleVector, const PFParticlesToMetadata &particlesToMetadata = PFParticlesToMetadata());
+
+    /**
+     *  @brief  Whether a particle is in the index and connected to a primary particle
+     *
+     *  @param  particle the input particle
+     */
+    bool IsIndexed(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the particle with a given ID, whether or not it is connected to a primary particle
+     *
+     *  @param  id the particle ID
+     *  @param  particle to receive the particle
+     *
+     *  @return whether the input vector holds a particle with this ID
+     */
+    bool GetParticle(const size_t id, art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the parent of a particle
+     *
+     *  @param  particle the input particle
+     *  @param  parentParticle to receive the parent particle
+     *
+     *  @return whether the particle is indexed and has a parent
+     */
+    bool GetParent(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &parentParticle) const;
+
+    /**
+     *  @brief  Get the top-level parent of a particle (the particle itself if primary)
+     *
+     *  @param  particle the input particle
+     *  @param  rootParticle to receive the top-level parent particle
+     *
+     *  @return whether the particle is indexed
+     */
+    bool GetRoot(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &rootParticle) const;
+
+    /**
+     *  @brief  Get the final-state ancestor of a particle: the daughter of a neutrino on its path to the top-level parent, or the
+     *          top-level parent if there is no such neutrino (the particle itself if final state)
+     *
+     *  @param  particle the input particle
+     *  @param  finalStateParticle to receive the final-state ancestor
+     *
+     *  @return whether the particle is indexed
+     */
+    bool GetFinalState(const art::Ptr<recob::PFParticle> &particle, art::Ptr<recob::PFParticle> &finalStateParticle) const;
+
+    /**
+     *  @brief  Whether a particle is indexed and final state: not a neutrino, and either primary or the daughter of a neutrino
+     *
+     *  @param  particle the input particle
+     */
+    bool IsFinalState(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get the generation of a particle (first generation if primary)
+     *
+     *  @param  particle the input particle
+     *  @param  generation to receive the generation
+     *
+     *  @return whether the particle is indexed
+     */
+    bool GetGeneration(const art::Ptr<recob::PFParticle> &particle, int &generation) const;
+
+    /**
+     *  @brief  Get the index of the slice of a particle, from the metadata of its top-level parent
+     *
+     *  @param  particle the input particle
+     *  @param  sliceIndex to receive the slice index
+     *
+     *  @return whether the particle is indexed and its top-level parent has a slice index
+     */
+    bool GetSliceIndex(const art::Ptr<recob::PFParticle> &particle, unsigned int &sliceIndex) const;
+
+    /**
+     *  @brief  Whether a particle is indexed and its top-level parent has been flagged as a clear cosmic ray
+     *
+     *  @param  particle the input particle
+     */
+    bool IsClearCosmic(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Get a value from the metadata of the top-level parent of a particle
+     *
+     *  @param  particle the input particle
+     *  @param  key the metadata key
+     *  @param  value to receive the metadata value
+     *
+     *  @return whether the particle is indexed and the metadata of its top-level parent holds the key
+     */
+    bool GetRootMetadataValue(const art::Ptr<recob::PFParticle> &particle, const std::string &key, float &value) const;
+
+private:
+    static const size_t kNoPosition;    ///< The position used for a missing parent or top-level parent
+
+    /**
+     *  @brief  Node class, the resolved hierarchy information of a single particle
+     */
+    class Node
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        Node();
+
+        size_t          m_parentPosition;       ///< The position of the parent particle, kNoPosition if primary
+        size_t          m_rootPosition;         ///< The position of the top-level parent particle, kNoPosition if not indexed
+        size_t          m_finalStatePosition;   ///< The position of the final-state ancestor, kNoPosition if not indexed
+        int             m_generation;           ///< The generation of the particle
+        bool            m_isNeutrino;           ///< Whether the particle is a neutrino
+        bool            m_isClearCosmic;        ///< Whether the top-level parent has been flagged as a clear cosmic ray
+        bool            m_hasSliceIndex;        ///< Whether the top-level parent has a slice index
+        unsigned int    m_sliceIndex;           ///< The slice index of the top-level parent
+    };
+
+    /**
+     *  @brief  Get the node of a particle, nullptr if the particle is not indexed
+     *
+     *  @param  particle the input particle
+     */
+    const Node *GetNode(const art::Ptr<recob::PFParticle> &particle) const;
+
+    /**
+     *  @brief  Look up a value in a metadata object
+     *
+     *  @param  metadata the metadata object
+     *  @param  key the metadata key
+     *  @param  value to receive the metadata value
+     *
+     *  @return whether the metadata holds the key
+     */
+    static bool GetMetadataValue(const art::Ptr<larpandoraobj::PFParticleMetadata> &metadata, const std::string &key, float &value);
+
+    PFParticleVector                                        m_particles;        ///< The indexed particles
+    MetadataVector                                          m_metadata;         ///< The metadata of each particle, null if absent
+    std::vector<Node>                                       m_nodes;            ///< The resolved hierarchy of each particle
+    std::unordered_map<size_t, size_t>                      m_idToPosition;     ///< The mapping from particle ID to position
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline PtrToVectorIndex<K, U>::const_iterator::const_iterator(const PtrToVectorIndex *const pIndex, const size_t key) :
+    m_pIndex(pIndex),
+    m_key(pIndex->GetNextKey(key))
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline typename PtrToVectorIndex<K, U>::value_type PtrToVectorIndex<K, U>::const_iterator::operator*() const
+{
+    return value_type(m_pIndex->m_keys.at(m_key), m_pIndex->m_association.GetRow(m_key));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline typename PtrToVectorIndex<K, U>::const_iterator &PtrToVectorIndex<K, U>::const_iterator::operator++()
+{
+    m_key = m_pIndex->GetNextKey(m_key + 1);
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline bool PtrToVectorIndex<K, U>::const_iterator::operator==(const const_iterator &rhs) const
+{
+    return ((m_pIndex == rhs.m_pIndex) && (m_key == rhs.m_key));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline bool PtrToVectorIndex<K, U>::const_iterator::operator!=(const const_iterator &rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline PtrToVectorIndex<K, U>::PtrToVectorIndex() :
+    m_nKeys(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline void PtrToVectorIndex<K, U>::Add(const art::Ptr<K> &key, const art::Ptr<U> &value)
+{
+    if (key.isNull())
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::Add --- found a null key ";
+
+    if (!m_productId.isValid())
+    {
+        m_productId = key.id();
+    }
+    else if (key.id() != m_productId)
+    {
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::Add --- keys must come from a single collection ";
+    }
+
+    m_addedKeys.push_back(key);
+    m_addedValues.push_back(value);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline void PtrToVectorIndex<K, U>::Finalize()
+{
+    if (m_addedKeys.empty())
+        return;
+
+    size_t nSlots(m_keys.size());
+
+    for (const art::Ptr<K> &key : m_addedKeys)
+        nSlots = std::max(nSlots, static_cast<size_t>(key.key()) + 1);
+
+    m_keys.resize(nSlots);
+    std::vector<size_t> addedOffsets(nSlots + 1, 0);
+
+    for (const art::Ptr<K> &key : m_addedKeys)
+    {
+        if (m_keys.at(key.key()).isNull())
+        {
+            m_keys.at(key.key()) = key;
+            ++m_nKeys;
+        }
+
+        ++addedOffsets.at(key.key() + 1);
+    }
+
+    for (size_t slot = 0; slot < nSlots; ++slot)
+        addedOffsets.at(slot + 1) += addedOffsets.at(slot);
+
+    // Group the added values by key, keeping the order in which they were added
+    std::vector<size_t> positions(addedOffsets.begin(), addedOffsets.end() - 1);
+    std::vector<art::Ptr<U> > addedValues(m_addedValues.size());
+
+    for (size_t index = 0; index < m_addedKeys.size(); ++index)
+        addedValues.at(positions.at(m_addedKeys.at(index).key())++) = m_addedValues.at(index);
+
+    // Rebuild the rows, placing the added values of each key after any values it already held
+    CompressedAssociation<K, U> association;
+    association.Reserve(nSlots, m_association.GetNumberOfTargets() + addedValues.size());
+
+    std::vector<art::Ptr<U> > rowValues;
+
+    for (size_t slot = 0; slot < nSlots; ++slot)
+    {
+        const typename std::vector<art::Ptr<U> >::const_iterator addedBegin(addedValues.begin() + addedOffsets.at(slot));
+        const typename std::vector<art::Ptr<U> >::const_iterator addedEnd(addedValues.begin() + addedOffsets.at(slot + 1));
+
+        if ((slot >= m_association.GetNumberOfSources()) || m_association.GetRow(slot).empty())
+        {
+            association.AddRow(addedBegin, addedEnd);
+            continue;
+        }
+
+        const Range heldValues(m_association.GetRow(slot));
+        rowValues.assign(heldValues.begin(), heldValues.end());
+        rowValues.insert(rowValues.end(), addedBegin, addedEnd);
+        association.AddRow(rowValues);
+    }
+
+    m_association = std::move(association);
+    std::vector<art::Ptr<K> >().swap(m_addedKeys);
+    std::vector<art::Ptr<U> >().swap(m_addedValues);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline size_t PtrToVectorIndex<K, U>::count(const art::Ptr<K> &key) const
+{
+    return ((this->GetSlot(key, true) < m_keys.size()) ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline typename PtrToVectorIndex<K, U>::Range PtrToVectorIndex<K, U>::at(const art::Ptr<K> &key) const
+{
+    const size_t slot(this->GetSlot(key, false));
+
+    if (slot >= m_keys.size())
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::at --- key " << key.key() << " has no values ";
+
+    return m_association.GetRow(slot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline size_t PtrToVectorIndex<K, U>::size() const
+{
+    return m_nKeys;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline bool PtrToVectorIndex<K, U>::empty() const
+{
+    return (0 == m_nKeys);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline typename PtrToVectorIndex<K, U>::const_iterator PtrToVectorIndex<K, U>::begin() const
+{
+    if (!m_addedKeys.empty())
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::begin --- values have been added since the index was finalized ";
+
+    return const_iterator(this, 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline typename PtrToVectorIndex<K, U>::const_iterator PtrToVectorIndex<K, U>::end() const
+{
+    return const_iterator(this, m_keys.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline size_t PtrToVectorIndex<K, U>::GetSlot(const art::Ptr<K> &key, const bool allowOtherCollection) const
+{
+    if (!m_addedKeys.empty())
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::GetSlot --- values have been added since the index was finalized ";
+
+    if (key.isNull() || !m_productId.isValid())
+        return m_keys.size();
+
+    if (key.id() != m_productId)
+    {
+        if (allowOtherCollection)
+            return m_keys.size();
+
+        throw cet::exception("LArPandora") << " PtrToVectorIndex::GetSlot --- key " << key.key() << " is not from the indexed collection ";
+    }
+
+    if ((key.key() >= m_keys.size()) || m_keys.at(key.key()).isNull())
+        return m_keys.size();
+
+    return static_cast<size_t>(key.key());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename U>
+inline size_t PtrToVectorIndex<K, U>::GetNextKey(size_t key) const
+{
+    while ((key < m_keys.size()) && m_keys.at(key).isNull())
+        ++key;
+
+    return std::min(key, m_keys.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline PtrToValueIndex<K, V>::const_iterator::const_iterator(const PtrToValueIndex *const pIndex, const size_t key) :
+    m_pIndex(pIndex),
+    m_key(pIndex->GetNextKey(key))
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline typename PtrToValueIndex<K, V>::value_type PtrToValueIndex<K, V>::const_iterator::operator*() const
+{
+    return value_type(m_pIndex->m_keys.at(m_key), m_pIndex->m_values.at(m_key));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline typename PtrToValueIndex<K, V>::const_iterator &PtrToValueIndex<K, V>::const_iterator::operator++()
+{
+    m_key = m_pIndex->GetNextKey(m_key + 1);
+    return *this;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline bool PtrToValueIndex<K, V>::const_iterator::operator==(const const_iterator &rhs) const
+{
+    return ((m_pIndex == rhs.m_pIndex) && (m_key == rhs.m_key));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline bool PtrToValueIndex<K, V>::const_iterator::operator!=(const const_iterator &rhs) const
+{
+    return !(*this == rhs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline PtrToValueIndex<K, V>::PtrToValueIndex() :
+    m_nKeys(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline void PtrToValueIndex<K, V>::Set(const art::Ptr<K> &key, const V &value)
+{
+    if (key.isNull())
+        throw cet::exception("LArPandora") << " PtrToValueIndex::Set --- found a null key ";
+
+    if (!m_productId.isValid())
+    {
+        m_productId = key.id();
+    }
+    else if (key.id() != m_productId)
+    {
+        throw cet::exception("LArPandora") << " PtrToValueIndex::Set --- keys must come from a single collection ";
+    }
+
+    const size_t slot(static_cast<size_t>(key.key()));
+
+    if (slot >= m_keys.size())
+    {
+        m_keys.resize(slot + 1);
+        m_values.resize(slot + 1);
+    }
+
+    if (m_keys.at(slot).isNull())
+    {
+        m_keys.at(slot) = key;
+        ++m_nKeys;
+    }
+
+    m_values.at(slot) = value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline size_t PtrToValueIndex<K, V>::count(const art::Ptr<K> &key) const
+{
+    return ((this->GetSlot(key, true) < m_keys.size()) ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline const V &PtrToValueIndex<K, V>::at(const art::Ptr<K> &key) const
+{
+    const size_t slot(this->GetSlot(key, false));
+
+    if (slot >= m_keys.size())
+        throw cet::exception("LArPandora") << " PtrToValueIndex::at --- key " << key.key() << " has no value ";
+
+    return m_values.at(slot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline size_t PtrToValueIndex<K, V>::size() const
+{
+    return m_nKeys;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline bool PtrToValueIndex<K, V>::empty() const
+{
+    return (0 == m_nKeys);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline typename PtrToValueIndex<K, V>::const_iterator PtrToValueIndex<K, V>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline typename PtrToValueIndex<K, V>::const_iterator PtrToValueIndex<K, V>::end() const
+{
+    return const_iterator(this, m_keys.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline size_t PtrToValueIndex<K, V>::GetSlot(const art::Ptr<K> &key, const bool allowOtherCollection) const
+{
+    if (key.isNull() || !m_productId.isValid())
+        return m_keys.size();
+
+    if (key.id() != m_productId)
+    {
+        if (allowOtherCollection)
+            return m_keys.size();
+
+        throw cet::exception("LArPandora") << " PtrToValueIndex::GetSlot --- key " << key.key() << " is not from the indexed collection ";
+    }
+
+    if ((key.key() >= m_keys.size()) || m_keys.at(key.key()).isNull())
+        return m_keys.size();
+
+    return static_cast<size_t>(key.key());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename K, typename V>
+inline size_t PtrToValueIndex<K, V>::GetNextKey(size_t key) const
+{
+    while ((key < m_keys.size()) && m_keys.at(key).isNull())
+        ++key;
+
+    return std::min(key, m_keys.size());
+}
+
 } // namespace lar_pandora
 
 #endif //  LAR_PANDORA_HELPER_H
@@ -6,6 +6,8 @@
  */
 
 #include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Provenance.h"
 #include "cetlib_except/exception.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
@@ -15,9 +17,13 @@
 #include "lardata/Utilities/AssociationUtil.h"
 
 #include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/PCAxis.h"
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/RecoBase/PFParticleMetadata.h"
+#include "lardataobj/RecoBase/Shower.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/TrackHitMeta.h"
 #include "lardataobj/RecoBase/Vertex.h"
 #include "lardataobj/RecoBase/Slice.h"
 #include "lardataobj/AnalysisBase/T0.h"
@@ -38,8 +44,10 @@
 #include "larpandoracontent/LArControlFlow/MultiPandoraApi.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
+#include "larpandora/LArPandoraInterface/LArPandoraSummary.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <iostream>
 #include <limits>
@@ -52,6 +60,9 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
     settings.Validate();
     const std::string instanceLabel(settings.m_shouldProduceAllOutcomes ? settings.m_allOutcomesInstanceLabel : "");
     const std::string testBeamInteractionVertexInstanceLabel(instanceLabel + settings.m_testBeamInteractionVerticesInstanceLabel);
+    const std::string pfoSummaryInstanceLabel(instanceLabel + settings.m_pfoSummaryInstanceLabel);
+    const bool useFastClusterParams(std::find(settings.m_fastClusterParamsInstanceLabels.begin(), settings.m_fastClusterParamsInstanceLabels.end(),
+        instanceLabel) != settings.m_fastClusterParamsInstanceLabels.end());
 
     // Set up mandatory output collections
     PFParticleCollection            outputParticles( new std::vector<recob::PFParticle> );
@@ -64,6 +75,13 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
     VertexCollection                outputTestBeamInteractionVertices(settings.m_shouldProduceTestBeamInteractionVertices ? new std::vector<recob::Vertex> : nullptr);
     T0Collection                    outputT0s(settings.m_shouldRunStitching ? new std::vector<anab::T0> : nullptr);
     SliceCollection                 outputSlices(settings.m_shouldProduceSlices ? new std::vector<recob::Slice> : nullptr);
+    IntCollection                   outputPfoSummary(settings.m_shouldProducePfoSummary ? new std::vector<int> : nullptr);
+    FloatCollection                 outputPfoSummarySpacePoints(settings.m_shouldProducePfoSummary ? new std::vector<float> : nullptr);
+    IntCollection                   outputPfoSummaryHits(settings.m_shouldProducePfoSummary ? new std::vector<int> : nullptr);
+    StringCollection                outputPfoSummaryHitTag(settings.m_shouldProducePfoSummary ? new std::string : nullptr);
+    TrackCollection                 outputTracks(settings.m_shouldProduceTracksAndShowers ? new std::vector<recob::Track> : nullptr);
+    ShowerCollection                outputShowers(settings.m_shouldProduceTracksAndShowers ? new std::vector<recob::Shower> : nullptr);
+    PCAxisCollection                outputPCAxes(settings.m_shouldProduceTracksAndShowers ? new std::vector<recob::PCAxis> : nullptr);
 
     // Set up mandatory output associations
     PFParticleToMetadataCollection    outputParticlesToMetadata( new art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata> );
@@ -78,11 +96,20 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
     PFParticleToVertexCollection      outputParticlesToTestBeamInteractionVertices(settings.m_shouldProduceTestBeamInteractionVertices ? new art::Assns<recob::PFParticle, recob::Vertex> : nullptr);
     PFParticleToT0Collection          outputParticlesToT0s(settings.m_shouldRunStitching ? new art::Assns<recob::PFParticle, anab::T0> : nullptr);
     PFParticleToSliceCollection       outputParticlesToSlices(settings.m_shouldProduceSlices ? new art::Assns<recob::PFParticle, recob::Slice> : nullptr);
+    PFParticleToTrackCollection       outputParticlesToTracks(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::PFParticle, recob::Track> : nullptr);
+    PFParticleToShowerCollection      outputParticlesToShowers(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::PFParticle, recob::Shower> : nullptr);
+    PFParticleToPCAxisCollection      outputParticlesToPCAxes(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::PFParticle, recob::PCAxis> : nullptr);
+    TrackToHitCollection              outputTracksToHits(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::Track, recob::Hit> : nullptr);
+    TrackToHitWithMetaCollection      outputTracksToHitsWithMeta(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> : nullptr);
+    ShowerToHitCollection             outputShowersToHits(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::Shower, recob::Hit> : nullptr);
+    ShowerToPCAxisCollection          outputShowersToPCAxes(settings.m_shouldProduceTracksAndShowers ? new art::Assns<recob::Shower, recob::PCAxis> : nullptr);
 
     // Collect immutable lists of pandora collections that we should convert to ART format
     const pandora::PfoVector pfoVector(settings.m_shouldProduceAllOutcomes ?
         LArPandoraOutput::CollectAllPfoOutcomes(settings.m_pPrimaryPandora) :
         LArPandoraOutput::CollectPfos(settings.m_pPrimaryPandora));
+    const PfoPropertiesVector pfoPropertiesTable(LArPandoraOutput::BuildPfoPropertiesTable(pfoVector));
+    const OutputTierVector pfoTiers(LArPandoraOutput::GetOutputTiers(settings, pfoPropertiesTable));
 
     IdToIdVectorMap pfoToVerticesMap, pfoToTestBeamInteractionVerticesMap;
     const pandora::VertexVector vertexVector(LArPandoraOutput::CollectVertices(pfoVector, pfoToVerticesMap, lar_content::LArPfoHelper::GetVertex));
@@ -90,10 +117,10 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
         lar_content::LArPfoHelper::GetTestBeamInteractionVertex) : pandora::VertexVector());
 
     IdToIdVectorMap pfoToClustersMap;
-    const pandora::ClusterList clusterList(LArPandoraOutput::CollectClusters(pfoVector, pfoToClustersMap));
+    const pandora::ClusterList clusterList(LArPandoraOutput::CollectClusters(pfoVector, pfoTiers, pfoToClustersMap));
 
     IdToIdVectorMap pfoToThreeDHitsMap;
-    const pandora::CaloHitList threeDHitList(LArPandoraOutput::Collect3DHits(pfoVector, pfoToThreeDHitsMap));
+    const pandora::CaloHitList threeDHitList(LArPandoraOutput::Collect3DHits(pfoVector, pfoTiers, settings.m_spacePointDecimation, pfoToThreeDHitsMap));
 
     // Get mapping from pandora hits to art hits
     CaloHitToArtHitMap pandoraHitToArtHitMap;
@@ -108,17 +135,31 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
     LArPandoraOutput::BuildSpacePoints(evt, settings.m_pProducer, instanceLabel, threeDHitList, pandoraHitToArtHitMap, outputSpacePoints, outputSpacePointsToHits);
 
     IdToIdVectorMap pfoToArtClustersMap;
-    LArPandoraOutput::BuildClusters(evt, settings.m_pProducer, instanceLabel, clusterList, pandoraHitToArtHitMap, pfoToClustersMap, outputClusters, outputClustersToHits, pfoToArtClustersMap);
+    LArPandoraOutput::BuildClusters(evt, settings.m_pProducer, instanceLabel, clusterList, pandoraHitToArtHitMap, pfoToClustersMap, outputClusters, outputClustersToHits, pfoToArtClustersMap, useFastClusterParams);
 
     LArPandoraOutput::BuildPFParticles(evt, settings.m_pProducer, instanceLabel, pfoVector, pfoToVerticesMap, pfoToThreeDHitsMap, pfoToArtClustersMap, outputParticles, outputParticlesToVertices, outputParticlesToSpacePoints, outputParticlesToClusters);
 
-    LArPandoraOutput::BuildParticleMetadata(evt, settings.m_pProducer, instanceLabel, pfoVector, outputParticleMetadata, outputParticlesToMetadata);
+    LArPandoraOutput::BuildParticleMetadata(evt, settings.m_pProducer, instanceLabel, pfoVector, pfoTiers, outputParticleMetadata, outputParticlesToMetadata);
+
+    if (settings.m_shouldProduceTracksAndShowers)
+    {
+        // ATTN the tracks and showers are built from the in-memory pfos, reusing the space point and cluster outputs of this event
+        const pandora::CaloHitVector threeDHitVector(threeDHitList.begin(), threeDHitList.end());
+        std::vector<HitVector> artClusterHits;
+        LArPandoraOutput::CollectArtClusterHits(outputClustersToHits, outputClusters->size(), artClusterHits);
+
+        LArPandoraOutput::BuildTracks(settings, evt, instanceLabel, pfoVector, vertexVector, threeDHitVector, pandoraHitToArtHitMap, pfoToVerticesMap, pfoToThreeDHitsMap, pfoToArtClustersMap, artClusterHits, outputTracks, outputParticlesToTracks, outputTracksToHits, outputTracksToHitsWithMeta);
+        LArPandoraOutput::BuildShowers(evt, settings.m_pProducer, instanceLabel, pfoVector, vertexVector, threeDHitVector, pfoToVerticesMap, pfoToThreeDHitsMap, pfoToArtClustersMap, artClusterHits, outputShowers, outputPCAxes, outputParticlesToShowers, outputParticlesToPCAxes, outputShowersToHits, outputShowersToPCAxes);
+    }
+
+    if (settings.m_shouldProducePfoSummary)
+        LArPandoraOutput::BuildPfoSummary(evt, settings.m_hitfinderModuleLabel, pfoVector, pfoPropertiesTable, clusterList, threeDHitList, pandoraHitToArtHitMap, pfoToClustersMap, pfoToThreeDHitsMap, outputPfoSummary, outputPfoSummarySpacePoints, outputPfoSummaryHits, outputPfoSummaryHitTag);
 
     if (settings.m_shouldProduceSlices)
-        LArPandoraOutput::BuildSlices(settings, settings.m_pPrimaryPandora, evt, settings.m_pProducer, instanceLabel, pfoVector, idToHitMap, outputSlices, outputParticlesToSlices, outputSlicesToHits);
+        LArPandoraOutput::BuildSlices(settings, settings.m_pPrimaryPandora, evt, settings.m_pProducer, instanceLabel, pfoVector, pfoPropertiesTable, idToHitMap, outputSlices, outputParticlesToSlices, outputSlicesToHits);
 
     if (settings.m_shouldRunStitching)
-        LArPandoraOutput::BuildT0s(evt, settings.m_pProducer, instanceLabel, pfoVector, outputT0s, outputParticlesToT0s);
+        LArPandoraOutput::BuildT0s(evt, settings.m_pProducer, instanceLabel, pfoPropertiesTable, outputT0s, outputParticlesToT0s);
 
     if (settings.m_shouldProduceTestBeamInteractionVertices)
         LArPandoraOutput::AssociateAdditionalVertices(evt, settings.m_pProducer, instanceLabel, pfoVector, pfoToTestBeamInteractionVerticesMap, outputParticlesToTestBeamInteractionVertices);
@@ -155,6 +196,28 @@ void LArPandoraOutput::ProduceArtOutput(const Settings &settings, const IdToHitM
         evt.put(std::move(outputSlices), instanceLabel);
         evt.put(std::move(outputSlicesToHits), instanceLabel);
     }
+
+    if (settings.m_shouldProduceTracksAndShowers)
+    {
+        evt.put(std::move(outputTracks), instanceLabel);
+        evt.put(std::move(outputShowers), instanceLabel);
+        evt.put(std::move(outputPCAxes), instanceLabel);
+        evt.put(std::move(outputParticlesToTracks), instanceLabel);
+        evt.put(std::move(outputParticlesToShowers), instanceLabel);
+        evt.put(std::move(outputParticlesToPCAxes), instanceLabel);
+        evt.put(std::move(outputTracksToHits), instanceLabel);
+        evt.put(std::move(outputTracksToHitsWithMeta), instanceLabel);
+        evt.put(std::move(outputShowersToHits), instanceLabel);
+        evt.put(std::move(outputShowersToPCAxes), instanceLabel);
+    }
+
+    if (settings.m_shouldProducePfoSummary)
+    {
+        evt.put(std::move(outputPfoSummary), pfoSummaryInstanceLabel + LArPandoraSummary::kPfoSuffix);
+        evt.put(std::move(outputPfoSummarySpacePoints), pfoSummaryInstanceLabel + LArPandoraSummary::kSpacePointSuffix);
+        evt.put(std::move(outputPfoSummaryHits), pfoSummaryInstanceLabel + LArPandoraSummary::kHitSuffix);
+        evt.put(std::move(outputPfoSummaryHitTag), pfoSummaryInstanceLabel + LArPandoraSummary::kHitTagSuffix);
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -292,6 +355,137 @@ unsigned int LArPandoraOutput::GetSliceIndex(const pandora::ParticleFlowObject *
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+LArPandoraOutput::PfoPropertiesVector LArPandoraOutput::BuildPfoPropertiesTable(const pandora::PfoVector &pfoVector)
+{
+    std::unordered_map<const pandora::ParticleFlowObject *, size_t> pfoToIdMap;
+    for (size_t pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        if (!pfoToIdMap.emplace(pfoVector.at(pfoId), pfoId).second)
+            throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoPropertiesTable --- repeated pfos in input list ";
+    }
+
+    // Resolve the direct parent of each pfo through the id map
+    std::vector<size_t> parentIds(pfoVector.size(), recob::PFParticle::kPFParticlePrimary);
+
+    for (size_t pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        const pandora::PfoList &parentList(pfoVector.at(pfoId)->GetParentPfoList());
+
+        if (parentList.size() > 1)
+            throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoPropertiesTable --- this pfo has multiple parent particles ";
+
+        if (parentList.empty())
+            continue;
+
+        const auto parentIdIter(pfoToIdMap.find(parentList.front()));
+        if (pfoToIdMap.end() == parentIdIter)
+            throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoPropertiesTable --- found a pfo whose parent is not in the input list ";
+
+        parentIds.at(pfoId) = parentIdIter->second;
+    }
+
+    // Resolve the top-level parent of each pfo, stopping each walk at the first pfo already resolved, so each link is followed once
+    std::vector<size_t> topLevelIds(pfoVector.size(), recob::PFParticle::kPFParticlePrimary);
+    std::vector<size_t> unresolvedIds;
+
+    for (size_t pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        size_t currentId(pfoId);
+
+        while ((recob::PFParticle::kPFParticlePrimary == topLevelIds.at(currentId)) && (recob::PFParticle::kPFParticlePrimary != parentIds.at(currentId)))
+        {
+            unresolvedIds.push_back(currentId);
+            currentId = parentIds.at(currentId);
+        }
+
+        const size_t topLevelId(recob::PFParticle::kPFParticlePrimary == topLevelIds.at(currentId) ? currentId : topLevelIds.at(currentId));
+        topLevelIds.at(currentId) = topLevelId;
+
+        for (const size_t unresolvedId : unresolvedIds)
+            topLevelIds.at(unresolvedId) = topLevelId;
+
+        unresolvedIds.clear();
+    }
+
+    // Read the properties map of each top-level parent once, then share its properties with the rest of its hierarchy
+    PfoPropertiesVector pfoPropertiesTable(pfoVector.size());
+
+    for (size_t pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        if (recob::PFParticle::kPFParticlePrimary != parentIds.at(pfoId))
+            continue;
+
+        const pandora::ParticleFlowObject *const pParent(pfoVector.at(pfoId));
+        PfoProperties &parentProperties(pfoPropertiesTable.at(pfoId));
+        parentProperties.m_pParentPfo = pParent;
+        parentProperties.m_isInNeutrinoHierarchy = lar_content::LArPfoHelper::IsNeutrino(pParent);
+
+        const auto &properties(pParent->GetPropertiesMap());
+        const auto isClearCosmicIter(properties.find("IsClearCosmic"));
+        const auto sliceIndexIter(properties.find("SliceIndex"));
+        const auto x0Iter(properties.find("X0"));
+
+        parentProperties.m_isClearCosmic = (properties.end() != isClearCosmicIter) && static_cast<bool>(std::round(isClearCosmicIter->second));
+        parentProperties.m_isFromSlice = (properties.end() != sliceIndexIter);
+        parentProperties.m_sliceIndex = parentProperties.m_isFromSlice ? static_cast<unsigned int>(std::round(sliceIndexIter->second)) : 0;
+        parentProperties.m_x0 = (properties.end() != x0Iter) ? x0Iter->second : 0.f;
+    }
+
+    for (size_t pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        if (recob::PFParticle::kPFParticlePrimary == parentIds.at(pfoId))
+            continue;
+
+        PfoProperties &pfoProperties(pfoPropertiesTable.at(pfoId));
+        pfoProperties = pfoPropertiesTable.at(topLevelIds.at(pfoId));
+        pfoProperties.m_parentId = parentIds.at(pfoId);
+    }
+
+    return pfoPropertiesTable;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraOutput::OutputTier LArPandoraOutput::GetOutputTier(const std::string &name)
+{
+    if ("Full" == name)
+        return kFullOutput;
+
+    if ("DecimatedSpacePoints" == name)
+        return kDecimatedSpacePoints;
+
+    if ("SummaryOnly" == name)
+        return kSummaryOnly;
+
+    throw cet::exception("LArPandora") << " LArPandoraOutput::GetOutputTier --- unknown output tier: " << name;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraOutput::OutputTierVector LArPandoraOutput::GetOutputTiers(const Settings &settings, const PfoPropertiesVector &pfoPropertiesTable)
+{
+    OutputTierVector pfoTiers;
+
+    if ((kFullOutput == settings.m_clearCosmicOutputTier) && (kFullOutput == settings.m_sliceCosmicOutputTier) && (kFullOutput == settings.m_neutrinoOutputTier))
+        return pfoTiers;
+
+    for (const PfoProperties &pfoProperties : pfoPropertiesTable)
+    {
+        if (pfoProperties.m_isInNeutrinoHierarchy)
+        {
+            pfoTiers.push_back(settings.m_neutrinoOutputTier);
+        }
+        else
+        {
+            pfoTiers.push_back(pfoProperties.m_isClearCosmic ? settings.m_clearCosmicOutputTier : settings.m_sliceCosmicOutputTier);
+        }
+    }
+
+    return pfoTiers;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::PfoVector LArPandoraOutput::CollectPfos(const pandora::Pandora *const pPrimaryPandora)
 {
     const pandora::PfoList *pParentPfoList(nullptr);
@@ -356,7 +550,8 @@ pandora::VertexVector LArPandoraOutput::CollectVertices(const pandora::PfoVector
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-pandora::ClusterList LArPandoraOutput::CollectClusters(const pandora::PfoVector &pfoVector, IdToIdVectorMap &pfoToClustersMap)
+pandora::ClusterList LArPandoraOutput::CollectClusters(const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers,
+    IdToIdVectorMap &pfoToClustersMap)
 {
     pandora::ClusterList clusterList;
 
@@ -366,7 +561,8 @@ pandora::ClusterList LArPandoraOutput::CollectClusters(const pandora::PfoVector
 
         // Get the sorted list of clusters from the pfo
         pandora::ClusterList clusters;
-        lar_content::LArPfoHelper::GetTwoDClusterList(pPfo, clusters);
+        if (pfoTiers.empty() || (kSummaryOnly != pfoTiers.at(pfoId)))
+            lar_content::LArPfoHelper::GetTwoDClusterList(pPfo, clusters);
         clusters.sort(lar_content::LArClusterHelper::SortByNHits);
 
         // Get incrementing id's for each cluster
@@ -384,7 +580,8 @@ pandora::ClusterList LArPandoraOutput::CollectClusters(const pandora::PfoVector
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-pandora::CaloHitList LArPandoraOutput::Collect3DHits(const pandora::PfoVector &pfoVector, IdToIdVectorMap &pfoToThreeDHitsMap)
+pandora::CaloHitList LArPandoraOutput::Collect3DHits(const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers,
+    const unsigned int spacePointDecimation, IdToIdVectorMap &pfoToThreeDHitsMap)
 {
     pandora::CaloHitList caloHitList;
 
@@ -395,11 +592,20 @@ pandora::CaloHitList LArPandoraOutput::Collect3DHits(const pandora::PfoVector &p
         if (!pfoToThreeDHitsMap.insert(IdToIdVectorMap::value_type(pfoId, {})).second)
             throw cet::exception("LArPandora") << " LArPandoraOutput::Collect3DHits --- repeated pfos in input list ";
 
+        const OutputTier tier(pfoTiers.empty() ? kFullOutput : pfoTiers.at(pfoId));
+        if (kSummaryOnly == tier)
+            continue;
+
         pandora::CaloHitVector sorted3DHits;
         LArPandoraOutput::Collect3DHits(pPfo, sorted3DHits);
 
-        for (const pandora::CaloHit *const pCaloHit3D : sorted3DHits)
+        // ATTN for decimated pfos, keep the first of every spacePointDecimation hits along the sorted trajectory
+        const unsigned int stride((kDecimatedSpacePoints == tier) ? spacePointDecimation : 1u);
+
+        for (unsigned int hitIndex = 0; hitIndex < sorted3DHits.size(); hitIndex += stride)
         {
+            const pandora::CaloHit *const pCaloHit3D(sorted3DHits.at(hitIndex));
+
             if (pandora::TPC_3D != pCaloHit3D->GetHitType()) // TODO decide if this is required, or should I just insert them?
                 throw cet::exception("LArPandora") << " LArPandoraOutput::Collect3DHits --- found a 2D hit in a 3D cluster";
 
@@ -521,7 +727,7 @@ void LArPandoraOutput::BuildSpacePoints(const art::Event &event, const art::EDPr
 
 void LArPandoraOutput::BuildClusters(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel, const pandora::ClusterList &clusterList,
     const CaloHitToArtHitMap &pandoraHitToArtHitMap, const IdToIdVectorMap &pfoToClustersMap, ClusterCollection &outputClusters,
-    ClusterToHitCollection &outputClustersToHits, IdToIdVectorMap &pfoToArtClustersMap)
+    ClusterToHitCollection &outputClustersToHits, IdToIdVectorMap &pfoToArtClustersMap, const bool useFastClusterParams)
 {
     cluster::StandardClusterParamsAlg clusterParamAlgo;
 
@@ -531,7 +737,7 @@ void LArPandoraOutput::BuildClusters(const art::Event &event, const art::EDProdu
     for (const pandora::Cluster *const pCluster : clusterList)
     {
         std::vector<HitVector> hitVectors;
-        const std::vector<recob::Cluster> clusters(LArPandoraOutput::BuildClusters(pCluster, clusterList, pandoraHitToArtHitMap, pandoraClusterToArtClustersMap, hitVectors, nextClusterId, clusterParamAlgo));
+        const std::vector<recob::Cluster> clusters(LArPandoraOutput::BuildClusters(pCluster, clusterList, pandoraHitToArtHitMap, pandoraClusterToArtClustersMap, hitVectors, nextClusterId, clusterParamAlgo, useFastClusterParams));
 
         if (hitVectors.size() != clusters.size())
             throw cet::exception("LArPandora") << " LArPandoraOutput::BuildClusters --- invalid hit vectors for clusters produced ";
@@ -602,16 +808,89 @@ void LArPandoraOutput::AssociateAdditionalVertices(const art::Event &event, cons
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 void LArPandoraOutput::BuildParticleMetadata(const art::Event &event, const art::EDProducer *const pProducer,
-    const std::string &instanceLabel, const pandora::PfoVector &pfoVector, PFParticleMetadataCollection &outputParticleMetadata,
-    PFParticleToMetadataCollection &outputParticlesToMetadata)
+    const std::string &instanceLabel, const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers,
+    PFParticleMetadataCollection &outputParticleMetadata, PFParticleToMetadataCollection &outputParticlesToMetadata)
 {
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
     {
         const pandora::ParticleFlowObject *const pPfo(pfoVector.at(pfoId));
 
         LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, outputParticleMetadata->size(), outputParticlesToMetadata);
-        larpandoraobj::PFParticleMetadata pPFParticleMetadata(LArPandoraHelper::GetPFParticleMetadata(pPfo));
-		outputParticleMetadata->push_back(pPFParticleMetadata);
+
+        if (pfoTiers.empty())
+        {
+            larpandoraobj::PFParticleMetadata pPFParticleMetadata(LArPandoraHelper::GetPFParticleMetadata(pPfo));
+            outputParticleMetadata->push_back(pPFParticleMetadata);
+            continue;
+        }
+
+        // Record the output tier that was applied to this pfo
+        pandora::PropertiesMap propertiesMap(pPfo->GetPropertiesMap());
+        propertiesMap["OutputTier"] = static_cast<float>(pfoTiers.at(pfoId));
+        outputParticleMetadata->push_back(larpandoraobj::PFParticleMetadata(propertiesMap));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraOutput::BuildPfoSummary(const art::Event &event, const std::string &hitfinderModuleLabel, const pandora::PfoVector &pfoVector, const PfoPropertiesVector &pfoPropertiesTable, const pandora::ClusterList &clusterList,
+    const pandora::CaloHitList &threeDHitList, const CaloHitToArtHitMap &pandoraHitToArtHitMap, const IdToIdVectorMap &pfoToClustersMap,
+    const IdToIdVectorMap &pfoToThreeDHitsMap, IntCollection &outputPfoSummary, FloatCollection &outputPfoSummarySpacePoints,
+    IntCollection &outputPfoSummaryHits, StringCollection &outputPfoSummaryHitTag)
+{
+    art::Handle< std::vector<recob::Hit> > hitHandle;
+    event.getByLabel(hitfinderModuleLabel, hitHandle);
+
+    if (!hitHandle.isValid())
+        throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoSummary --- couldn't find the hit collection with label: " << hitfinderModuleLabel;
+
+    // ATTN: Record the fully resolved tag, including the process name, so that readers index the same hit collection
+    *outputPfoSummaryHitTag = hitHandle.provenance()->inputTag().encode();
+
+    const pandora::ClusterVector clusterVector(clusterList.begin(), clusterList.end());
+    const pandora::CaloHitVector threeDHitVector(threeDHitList.begin(), threeDHitList.end());
+
+    outputPfoSummary->reserve(pfoVector.size() * LArPandoraSummary::kNPfoColumns);
+    outputPfoSummarySpacePoints->reserve(threeDHitVector.size() * 3);
+
+    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        const pandora::ParticleFlowObject *const pPfo(pfoVector.at(pfoId));
+        const PfoProperties &pfoProperties(pfoPropertiesTable.at(pfoId));
+
+        const int parentId(recob::PFParticle::kPFParticlePrimary == pfoProperties.m_parentId ? LArPandoraSummary::kNoId : static_cast<int>(pfoProperties.m_parentId));
+        const int sliceIndex(pfoProperties.m_isFromSlice ? static_cast<int>(pfoProperties.m_sliceIndex) : LArPandoraSummary::kNoId);
+        const int spacePointBegin(outputPfoSummarySpacePoints->size() / 3);
+        const int hitBegin(outputPfoSummaryHits->size());
+
+        for (const size_t threeDHitId : pfoToThreeDHitsMap.at(pfoId))
+        {
+            const pandora::CartesianVector &position(threeDHitVector.at(threeDHitId)->GetPositionVector());
+            outputPfoSummarySpacePoints->push_back(position.GetX());
+            outputPfoSummarySpacePoints->push_back(position.GetY());
+            outputPfoSummarySpacePoints->push_back(position.GetZ());
+        }
+
+        for (const size_t clusterId : pfoToClustersMap.at(pfoId))
+        {
+            pandora::CaloHitVector sortedHits;
+            LArPandoraOutput::GetHitsInCluster(clusterVector.at(clusterId), sortedHits);
+
+            for (const pandora::CaloHit *const pCaloHit : sortedHits)
+            {
+                CaloHitToArtHitMap::const_iterator it(pandoraHitToArtHitMap.find(pCaloHit));
+                if (it == pandoraHitToArtHitMap.end())
+                    throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoSummary --- found a pandora hit without a corresponding art hit ";
+
+                if (it->second.id() != hitHandle.id())
+                    throw cet::exception("LArPandora") << " LArPandoraOutput::BuildPfoSummary --- found an art hit that is not in the collection " << *outputPfoSummaryHitTag;
+
+                outputPfoSummaryHits->push_back(static_cast<int>(it->second.key()));
+            }
+        }
+
+        outputPfoSummary->insert(outputPfoSummary->end(), {pPfo->GetParticleId(), parentId, sliceIndex, spacePointBegin,
+            static_cast<int>(outputPfoSummarySpacePoints->size() / 3), hitBegin, static_cast<int>(outputPfoSummaryHits->size())});
     }
 }
 
@@ -619,8 +898,8 @@ void LArPandoraOutput::BuildParticleMetadata(const art::Event &event, const art:
 
 void LArPandoraOutput::BuildSlices(const Settings &settings, const pandora::Pandora *const pPrimaryPandora, const art::Event &event,
     const art::EDProducer *const pProducer, const std::string &instanceLabel, const pandora::PfoVector &pfoVector,
-    const IdToHitMap &idToHitMap, SliceCollection &outputSlices, PFParticleToSliceCollection &outputParticlesToSlices,
-    SliceToHitCollection &outputSlicesToHits)
+    const PfoPropertiesVector &pfoPropertiesTable, const IdToHitMap &idToHitMap, SliceCollection &outputSlices,
+    PFParticleToSliceCollection &outputParticlesToSlices, SliceToHitCollection &outputSlicesToHits)
 {
     // Check for the special case in which there are no slices, and only the neutrino reconstruction was used on all hits
     if (settings.m_isNeutrinoRecoOnlyNoSlicing)
@@ -642,12 +921,13 @@ void LArPandoraOutput::BuildSlices(const Settings &settings, const pandora::Pand
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
     {
         const pandora::ParticleFlowObject *const pPfo(pfoVector.at(pfoId));
+        const PfoProperties &pfoProperties(pfoPropertiesTable.at(pfoId));
 
         // If this PFO is the parent of a hierarchy we have yet to use, then add a new slice
-        if (LArPandoraOutput::IsFromSlice(pPfo))
+        if (pfoProperties.m_isFromSlice)
             continue;
 
-        if (lar_content::LArPfoHelper::GetParentPfo(pPfo) != pPfo)
+        if (pfoProperties.m_pParentPfo != pPfo)
             continue;
 
         if (!parentPfoToSliceIndexMap.emplace(pPfo, LArPandoraOutput::BuildSlice(pPfo, event, pProducer, instanceLabel, idToHitMap, outputSlices, outputSlicesToHits)).second)
@@ -657,17 +937,17 @@ void LArPandoraOutput::BuildSlices(const Settings &settings, const pandora::Pand
     // Add the associations from PFOs to slices
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
     {
-        const pandora::ParticleFlowObject *const pPfo(pfoVector.at(pfoId));
+        const PfoProperties &pfoProperties(pfoPropertiesTable.at(pfoId));
 
         // For PFOs that are from a Pandora slice, add the association and move on to the next PFO
-        if (LArPandoraOutput::IsFromSlice(pPfo))
+        if (pfoProperties.m_isFromSlice)
         {
-            LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, LArPandoraOutput::GetSliceIndex(pPfo), outputParticlesToSlices);
+            LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, pfoProperties.m_sliceIndex, outputParticlesToSlices);
             continue;
         }
 
         // Get the parent of the particle
-        const pandora::ParticleFlowObject *const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
+        const pandora::ParticleFlowObject *const pParent(pfoProperties.m_pParentPfo);
         if (parentPfoToSliceIndexMap.find(pParent) == parentPfoToSliceIndexMap.end())
             throw cet::exception("LArPandora") << " LArPandoraOutput::BuildSlices --- found pfo without a parent in the input list ";
 
@@ -699,12 +979,16 @@ void LArPandoraOutput::CopyAllHitsToSingleSlice(const Settings &settings, const
 {
     const unsigned int sliceIndex(LArPandoraOutput::BuildDummySlice(outputSlices));
 
-    // Add all of the hits in the events to the slice
+    // Add all of the input hits to the slice, reusing the art pointers held by the interface rather than reading the hits again
     HitVector hits;
-    LArPandoraHelper::CollectHits(event, settings.m_hitfinderModuleLabel, hits);
+    hits.reserve(idToHitMap.size());
+
+    for (const IdToHitMap::value_type &idToHit : idToHitMap)
+        hits.push_back(idToHit.second);
+
     LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, sliceIndex, hits, outputSlicesToHits);
 
-    mf::LogDebug("LArPandora") << "Finding hits with label: " << settings.m_hitfinderModuleLabel << std::endl;
+    mf::LogDebug("LArPandora") << "Copying input hits from label: " << settings.m_hitfinderModuleLabel << std::endl;
     mf::LogDebug("LArPandora") << " - Found " << hits.size() << std::endl;
     mf::LogDebug("LArPandora") << " - Making associations " << outputSlicesToHits->size() << std::endl;
 
@@ -738,24 +1022,27 @@ unsigned int LArPandoraOutput::BuildSlice(const pandora::ParticleFlowObject *con
     }
 
     // Add the associations to the hits
+    HitVector artHits;
+    artHits.reserve(hits.size());
+
     for (const pandora::CaloHit *const pCaloHit : hits)
-        LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, sliceIndex, {LArPandoraOutput::GetHit(idToHitMap, pCaloHit)}, outputSlicesToHits);
+        artHits.push_back(LArPandoraOutput::GetHit(idToHitMap, pCaloHit));
+
+    LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, sliceIndex, artHits, outputSlicesToHits);
 
     return sliceIndex;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraOutput::BuildT0s(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel, const pandora::PfoVector &pfoVector,
-    T0Collection &outputT0s, PFParticleToT0Collection &outputParticlesToT0s)
+void LArPandoraOutput::BuildT0s(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
+    const PfoPropertiesVector &pfoPropertiesTable, T0Collection &outputT0s, PFParticleToT0Collection &outputParticlesToT0s)
 {
     size_t nextT0Id(0);
-    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    for (unsigned int pfoId = 0; pfoId < pfoPropertiesTable.size(); ++pfoId)
     {
-        const pandora::ParticleFlowObject *const pPfo(pfoVector.at(pfoId));
-
         anab::T0 t0;
-        if (!LArPandoraOutput::BuildT0(pPfo, pfoVector, nextT0Id, t0)) continue;
+        if (!LArPandoraOutput::BuildT0(pfoPropertiesTable.at(pfoId), pfoId, nextT0Id, t0)) continue;
 
         LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, nextT0Id - 1, outputParticlesToT0s);
         outputT0s->push_back(t0);
@@ -764,6 +1051,174 @@ void LArPandoraOutput::BuildT0s(const art::Event &event, const art::EDProducer *
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void LArPandoraOutput::CollectArtClusterHits(const ClusterToHitCollection &outputClustersToHits, const size_t nClusters, std::vector<HitVector> &artClusterHits)
+{
+    artClusterHits.assign(nClusters, HitVector());
+
+    for (const auto &clusterToHit : *outputClustersToHits)
+        artClusterHits.at(clusterToHit.first.key()).push_back(clusterToHit.second);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraOutput::GetFitInputs(const size_t pfoId, const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector,
+    const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+    pandora::CartesianPointVector &cartesianPointVector, pandora::CartesianVector &vertexPosition)
+{
+    IdToIdVectorMap::const_iterator threeDHitsIter(pfoToThreeDHitsMap.find(pfoId));
+
+    if ((pfoToThreeDHitsMap.end() == threeDHitsIter) || threeDHitsIter->second.empty())
+    {
+        mf::LogDebug("LArPandora") << "No spacepoints associated to particle ";
+        return false;
+    }
+
+    IdToIdVectorMap::const_iterator clustersIter(pfoToArtClustersMap.find(pfoId));
+
+    if ((pfoToArtClustersMap.end() == clustersIter) || clustersIter->second.empty())
+    {
+        mf::LogDebug("LArPandora") << "No clusters associated to particle ";
+        return false;
+    }
+
+    IdToIdVectorMap::const_iterator verticesIter(pfoToVerticesMap.find(pfoId));
+
+    if ((pfoToVerticesMap.end() == verticesIter) || (1 != verticesIter->second.size()))
+    {
+        mf::LogDebug("LArPandora") << "Unexpected number of vertices for particle ";
+        return false;
+    }
+
+    // ATTN the positions are read from the same pandora hits and vertices the space points and vertices are built from, so they are identical
+    cartesianPointVector.clear();
+    cartesianPointVector.reserve(threeDHitsIter->second.size());
+
+    for (const size_t threeDHitId : threeDHitsIter->second)
+        cartesianPointVector.push_back(threeDHitVector.at(threeDHitId)->GetPositionVector());
+
+    vertexPosition = vertexVector.at(verticesIter->second.front())->GetPosition();
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraOutput::BuildTracks(const Settings &settings, const art::Event &event, const std::string &instanceLabel, const pandora::PfoVector &pfoVector,
+    const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector, const CaloHitToArtHitMap &pandoraHitToArtHitMap,
+    const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+    const std::vector<HitVector> &artClusterHits, TrackCollection &outputTracks, PFParticleToTrackCollection &outputParticlesToTracks,
+    TrackToHitCollection &outputTracksToHits, TrackToHitWithMetaCollection &outputTracksToHitsWithMeta)
+{
+    const art::PtrMaker<recob::Track> makeTrackPtr(event, instanceLabel);
+
+    pandora::CartesianPointVector cartesianPointVector;
+    pandora::CartesianVector vertexPosition(0.f, 0.f, 0.f);
+
+    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        // Select track-like pfos
+        if (!lar_content::LArPfoHelper::IsTrack(pfoVector.at(pfoId)))
+            continue;
+
+        if (!LArPandoraOutput::GetFitInputs(pfoId, vertexVector, threeDHitVector, pfoToVerticesMap, pfoToThreeDHitsMap, pfoToArtClustersMap,
+            cartesianPointVector, vertexPosition))
+            continue;
+
+        lar_content::LArTrackStateVector trackStateVector;
+        pandora::IntVector indexVector;
+
+        if (!LArPandoraOutput::GetSlidingFitTrajectory(cartesianPointVector, vertexPosition, settings.m_slidingFitHalfWindow, settings.m_wirePitchW,
+            trackStateVector, indexVector))
+        {
+            mf::LogDebug("LArPandora") << "Unable to extract sliding fit trajectory";
+            continue;
+        }
+
+        if (trackStateVector.size() < settings.m_minTrajectoryPoints)
+        {
+            mf::LogDebug("LArPandora") << "Insufficient input trajectory points to build track: " << trackStateVector.size();
+            continue;
+        }
+
+        const IdVector &threeDHitIds(pfoToThreeDHitsMap.at(pfoId));
+
+        if (indexVector.size() != threeDHitIds.size())
+            throw cet::exception("LArPandora") << " LArPandoraOutput::BuildTracks --- trying to use an index vector not matching input vector";
+
+        HitVector hitsFromSpacePoints, hitsFromClusters, hitsInParticle;
+
+        for (const int index : indexVector)
+            hitsFromSpacePoints.push_back(pandoraHitToArtHitMap.at(threeDHitVector.at(threeDHitIds.at(index))));
+
+        for (const size_t clusterId : pfoToArtClustersMap.at(pfoId))
+            hitsFromClusters.insert(hitsFromClusters.end(), artClusterHits.at(clusterId).begin(), artClusterHits.at(clusterId).end());
+
+        LArPandoraOutput::GetTrackHits(hitsFromSpacePoints, hitsFromClusters, trackStateVector, hitsInParticle);
+
+        const size_t trackId(outputTracks->size());
+        outputTracks->emplace_back(LArPandoraOutput::BuildTrack(static_cast<int>(trackId), trackStateVector));
+
+        LArPandoraOutput::AddAssociation(event, settings.m_pProducer, instanceLabel, pfoId, trackId, outputParticlesToTracks);
+        LArPandoraOutput::AddAssociation(event, settings.m_pProducer, instanceLabel, trackId, hitsInParticle, outputTracksToHits);
+        LArPandoraOutput::AddTrackHitMetadata(makeTrackPtr(trackId), hitsInParticle, hitsFromSpacePoints.size(), outputTracksToHitsWithMeta);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraOutput::BuildShowers(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
+    const pandora::PfoVector &pfoVector, const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector,
+    const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+    const std::vector<HitVector> &artClusterHits, ShowerCollection &outputShowers, PCAxisCollection &outputPCAxes,
+    PFParticleToShowerCollection &outputParticlesToShowers, PFParticleToPCAxisCollection &outputParticlesToPCAxes,
+    ShowerToHitCollection &outputShowersToHits, ShowerToPCAxisCollection &outputShowersToPCAxes)
+{
+    pandora::CartesianPointVector cartesianPointVector;
+    pandora::CartesianVector vertexPosition(0.f, 0.f, 0.f);
+
+    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+    {
+        // Select shower-like pfos
+        if (!lar_content::LArPfoHelper::IsShower(pfoVector.at(pfoId)))
+            continue;
+
+        if (!LArPandoraOutput::GetFitInputs(pfoId, vertexVector, threeDHitVector, pfoToVerticesMap, pfoToThreeDHitsMap, pfoToArtClustersMap,
+            cartesianPointVector, vertexPosition))
+            continue;
+
+        const size_t showerId(outputShowers->size());
+
+        try
+        {
+            // Ensure successful creation of all structures before placing results in output containers, remaking LArShowerPCA with updated vertex
+            const lar_content::LArShowerPCA initialLArShowerPCA(lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition));
+            pandora::CartesianVector projectedVertexPosition(0.f, 0.f, 0.f);
+            const lar_content::LArShowerPCA larShowerPCA(LArPandoraOutput::OrientShowerPCA(initialLArShowerPCA, vertexPosition, projectedVertexPosition));
+            const recob::Shower shower(LArPandoraOutput::BuildShower(static_cast<int>(showerId), larShowerPCA, projectedVertexPosition));
+            const recob::PCAxis pcAxis(LArPandoraOutput::BuildPCAxis(larShowerPCA));
+            outputShowers->emplace_back(shower);
+            outputPCAxes->emplace_back(pcAxis);
+        }
+        catch (const pandora::StatusCodeException &)
+        {
+            mf::LogDebug("LArPandora") << "Unable to extract shower pca";
+            continue;
+        }
+
+        HitVector hitsInParticle;
+
+        for (const size_t clusterId : pfoToArtClustersMap.at(pfoId))
+            hitsInParticle.insert(hitsInParticle.end(), artClusterHits.at(clusterId).begin(), artClusterHits.at(clusterId).end());
+
+        // ATTN showers and pca axes are written in step, so they share ids
+        LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, showerId, outputParticlesToShowers);
+        LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, pfoId, showerId, outputParticlesToPCAxes);
+        LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, showerId, hitsInParticle, outputShowersToHits);
+        LArPandoraOutput::AddAssociation(event, pProducer, instanceLabel, showerId, showerId, outputShowersToPCAxes);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 recob::PFParticle LArPandoraOutput::BuildPFParticle(const pandora::ParticleFlowObject *const pPfo, const size_t pfoId, const pandora::PfoVector &pfoVector)
 {
     // Get parent Pfo ID
@@ -810,7 +1265,7 @@ void LArPandoraOutput::GetHitsInCluster(const pandora::Cluster *const pCluster,
 
 std::vector<recob::Cluster> LArPandoraOutput::BuildClusters(const pandora::Cluster *const pCluster, const pandora::ClusterList &clusterList,
     const CaloHitToArtHitMap &pandoraHitToArtHitMap, IdToIdVectorMap &pandoraClusterToArtClustersMap,
-    std::vector<HitVector> &hitVectors, size_t &nextId, cluster::ClusterParamsAlgBase &algo)
+    std::vector<HitVector> &hitVectors, size_t &nextId, cluster::ClusterParamsAlgBase &algo, const bool useFastClusterParams)
 {
     std::vector<recob::Cluster> clusters;
 
@@ -848,7 +1303,8 @@ std::vector<recob::Cluster> LArPandoraOutput::BuildClusters(const pandora::Clust
     {
         const HitVector &clusterHits(hitArrayEntry.second);
 
-        clusters.push_back(LArPandoraOutput::BuildCluster(nextId, clusterHits, isolatedHits, algo));
+        clusters.push_back(useFastClusterParams ? LArPandoraOutput::BuildClusterFastParams(nextId, clusterHits, isolatedHits) :
+            LArPandoraOutput::BuildCluster(nextId, clusterHits, isolatedHits, algo));
         hitVectors.push_back(clusterHits);
         pandoraClusterToArtClustersMap.at(clusterId).push_back(nextId);
 
@@ -943,6 +1399,70 @@ recob::Cluster LArPandoraOutput::BuildCluster(const size_t id, const HitVector &
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+recob::Cluster LArPandoraOutput::BuildClusterFastParams(const size_t id, const HitVector &hitVector, const HitList &isolatedHits)
+{
+    if (hitVector.empty())
+        throw cet::exception("LArPandora") << " LArPandoraOutput::BuildClusterFastParams --- No input hits were provided ";
+
+    geo::View_t view(geo::kUnknown);
+    geo::PlaneID planeID;
+
+    float startWire(+std::numeric_limits<float>::max()), sigmaStartWire(0.f);
+    float startTime(+std::numeric_limits<float>::max()), sigmaStartTime(0.f);
+    float endWire(-std::numeric_limits<float>::max()), sigmaEndWire(0.f);
+    float endTime(-std::numeric_limits<float>::max()), sigmaEndTime(0.f);
+    float integral(0.f);
+
+    for (const art::Ptr<recob::Hit> &hit : hitVector)
+    {
+        // ATTN the end point uncertainties are defined as in BuildCluster: half a wire, and twice the hit RMS in ticks
+        const float thisWire(hit->WireID().Wire);
+        const float thisWireSigma(0.5f);
+        const float thisTime(hit->PeakTime());
+        const float thisTimeSigma(2.f * hit->RMS());
+        const geo::View_t thisView(hit->View());
+        const geo::PlaneID thisPlaneID(hit->WireID().planeID());
+
+        if (geo::kUnknown == view)
+        {
+            view = thisView;
+            planeID = thisPlaneID;
+        }
+
+        if (!(thisView == view && thisPlaneID == planeID))
+            throw cet::exception("LArPandora") << " LArPandoraOutput::BuildClusterFastParams --- Input hits have inconsistent plane IDs ";
+
+        integral += hit->Integral();
+
+        if (isolatedHits.count(hit))
+            continue;
+
+        if (thisWire < startWire || (thisWire == startWire && thisTime < startTime))
+        {
+            startWire = thisWire;
+            sigmaStartWire = thisWireSigma;
+            startTime = thisTime;
+            sigmaStartTime = thisTimeSigma;
+        }
+
+        if (thisWire > endWire || (thisWire == endWire && thisTime > endTime))
+        {
+            endWire = thisWire;
+            sigmaEndWire = thisWireSigma;
+            endTime = thisTime;
+            sigmaEndTime = thisTimeSigma;
+        }
+    }
+
+    // ATTN only the end points and their uncertainties, hit count and integral are filled, all other parameters are left at zero
+    return recob::Cluster(startWire, sigmaStartWire, startTime, sigmaStartTime, 0.f, 0.f, 0.f,
+        endWire, sigmaEndWire, endTime, sigmaEndTime, 0.f, 0.f, 0.f,
+        integral, 0.f, 0.f, 0.f, static_cast<unsigned int>(hitVector.size()), 0.f, 0.f,
+        id, view, planeID, recob::Cluster::Sentry);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 recob::SpacePoint LArPandoraOutput::BuildSpacePoint(const pandora::CaloHit *const pCaloHit, const size_t spacePointId)
 {
     if (pandora::TPC_3D != pCaloHit->GetHitType())
@@ -960,11 +1480,173 @@ recob::SpacePoint LArPandoraOutput::BuildSpacePoint(const pandora::CaloHit *cons
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-bool LArPandoraOutput::BuildT0(const pandora::ParticleFlowObject *const pPfo, const pandora::PfoVector &pfoVector, size_t &nextId,
-    anab::T0 &t0)
+recob::Track LArPandoraOutput::BuildTrack(const int id, const lar_content::LArTrackStateVector &trackStateVector)
 {
-    const pandora::ParticleFlowObject *const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
-    const float x0(pParent->GetPropertiesMap().count("X0") ? pParent->GetPropertiesMap().at("X0") : 0.f);
+    if (trackStateVector.empty())
+        throw cet::exception("LArPandora") << " LArPandoraOutput::BuildTrack --- No input trajectory points provided ";
+
+    recob::tracking::Positions_t xyz;
+    recob::tracking::Momenta_t pxpypz;
+    recob::TrackTrajectory::Flags_t flags;
+
+    for (const lar_content::LArTrackState &trackState : trackStateVector)
+    {
+        xyz.emplace_back(recob::tracking::Point_t(trackState.GetPosition().GetX(), trackState.GetPosition().GetY(), trackState.GetPosition().GetZ()));
+        pxpypz.emplace_back(recob::tracking::Vector_t(trackState.GetDirection().GetX(), trackState.GetDirection().GetY(), trackState.GetDirection().GetZ()));
+        // Set flag NoPoint if point has bogus coordinates, otherwise use clean flag set
+        if (std::fabs(trackState.GetPosition().GetX()-util::kBogusF)<std::numeric_limits<float>::epsilon() &&
+            std::fabs(trackState.GetPosition().GetY()-util::kBogusF)<std::numeric_limits<float>::epsilon() &&
+            std::fabs(trackState.GetPosition().GetZ()-util::kBogusF)<std::numeric_limits<float>::epsilon())
+        {
+            flags.emplace_back(recob::TrajectoryPointFlags(recob::TrajectoryPointFlags::InvalidHitIndex, recob::TrajectoryPointFlagTraits::NoPoint));
+        } else {
+            flags.emplace_back(recob::TrajectoryPointFlags());
+        }
+    }
+
+    // note from gc: eventually we should produce a TrackTrajectory, not a Track with empty covariance matrix and bogus chi2, etc.
+    return recob::Track(recob::TrackTrajectory(std::move(xyz), std::move(pxpypz), std::move(flags), false),
+                        util::kBogusI, util::kBogusF, util::kBogusI, recob::tracking::SMatrixSym55(), recob::tracking::SMatrixSym55(), id);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraOutput::GetSlidingFitTrajectory(const pandora::CartesianPointVector &cartesianPointVector, const pandora::CartesianVector &vertexPosition,
+    const unsigned int slidingFitHalfWindow, const float wirePitchW, lar_content::LArTrackStateVector &trackStateVector, pandora::IntVector &indexVector)
+{
+    try
+    {
+        lar_content::LArPfoHelper::GetSlidingFitTrajectory(cartesianPointVector, vertexPosition, slidingFitHalfWindow, wirePitchW, trackStateVector, &indexVector);
+    }
+    catch (const pandora::StatusCodeException &)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraOutput::GetTrackHits(const HitVector &hitsFromSpacePoints, const HitVector &hitsFromClusters, lar_content::LArTrackStateVector &trackStateVector,
+    HitVector &hitsInParticle)
+{
+    if (!hitsInParticle.empty())
+        throw cet::exception("LArPandora") << " LArPandoraOutput::GetTrackHits --- vector to hold hits is not empty ";
+
+    if (trackStateVector.size() > hitsFromSpacePoints.size())
+        throw cet::exception("LArPandora") << " LArPandoraOutput::GetTrackHits --- more trajectory points than hits from space points ";
+
+    // ATTN hits ordered along the trajectory from the space points, hits only found in the clusters are added at the end
+    hitsInParticle.insert(hitsInParticle.end(), hitsFromSpacePoints.begin(), hitsFromSpacePoints.end());
+    const HitSet hitsInParticleSet(hitsFromSpacePoints.begin(), hitsFromSpacePoints.end());
+
+    for (const art::Ptr<recob::Hit> &pHit : hitsFromClusters)
+    {
+        if (hitsInParticleSet.count(pHit) == 0)
+            hitsInParticle.push_back(pHit);
+    }
+
+    // Add invalid points at the end of the vector, so that the number of the trajectory points is the same as the number of hits
+    while (trackStateVector.size() < hitsInParticle.size())
+    {
+        trackStateVector.push_back(lar_content::LArTrackState(pandora::CartesianVector(util::kBogusF, util::kBogusF, util::kBogusF),
+            pandora::CartesianVector(util::kBogusF, util::kBogusF, util::kBogusF), nullptr));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraOutput::AddTrackHitMetadata(const art::Ptr<recob::Track> &pTrack, const HitVector &hitsInParticle, const size_t nHitsFromSpacePoints,
+    TrackToHitWithMetaCollection &outputTracksToHitsWithMeta)
+{
+    // ATTN metadata added with index from space points if available, null for others
+    for (unsigned int hitIndex = 0; hitIndex < hitsInParticle.size(); ++hitIndex)
+    {
+        const int index((hitIndex < nHitsFromSpacePoints) ? hitIndex : std::numeric_limits<int>::max());
+        const recob::TrackHitMeta metadata(index, -std::numeric_limits<double>::max());
+        outputTracksToHitsWithMeta->addSingle(pTrack, hitsInParticle.at(hitIndex), metadata);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+lar_content::LArShowerPCA LArPandoraOutput::OrientShowerPCA(const lar_content::LArShowerPCA &initialLArShowerPCA, const pandora::CartesianVector &vertexPosition,
+    pandora::CartesianVector &projectedVertexPosition)
+{
+    const pandora::CartesianVector &centroid(initialLArShowerPCA.GetCentroid());
+    const pandora::CartesianVector &primaryAxis(initialLArShowerPCA.GetPrimaryAxis());
+    const pandora::CartesianVector &secondaryAxis(initialLArShowerPCA.GetSecondaryAxis());
+    const pandora::CartesianVector &tertiaryAxis(initialLArShowerPCA.GetTertiaryAxis());
+    const pandora::CartesianVector &eigenvalues(initialLArShowerPCA.GetEigenValues());
+
+    // Project the PFParticle vertex onto the PCA axis
+    projectedVertexPosition = centroid - primaryAxis.GetUnitVector() * (centroid - vertexPosition).GetDotProduct(primaryAxis);
+
+    // By convention, principal axis should always point away from vertex
+    const float testProjection(primaryAxis.GetDotProduct(projectedVertexPosition - centroid));
+    const float directionScaleFactor((testProjection > std::numeric_limits<float>::epsilon()) ? -1.f : 1.f);
+
+    return lar_content::LArShowerPCA(centroid, primaryAxis * directionScaleFactor, secondaryAxis * directionScaleFactor, tertiaryAxis * directionScaleFactor, eigenvalues);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+recob::Shower LArPandoraOutput::BuildShower(const int id, const lar_content::LArShowerPCA &larShowerPCA, const pandora::CartesianVector &vertexPosition)
+{
+    const pandora::CartesianVector &showerLength(larShowerPCA.GetAxisLengths());
+    const pandora::CartesianVector &showerDirection(larShowerPCA.GetPrimaryAxis());
+
+    const float length(showerLength.GetX());
+    const float openingAngle(larShowerPCA.GetPrimaryLength() > 0.f ? std::atan(larShowerPCA.GetSecondaryLength() / larShowerPCA.GetPrimaryLength()) : 0.f);
+    const TVector3 direction(showerDirection.GetX(), showerDirection.GetY(), showerDirection.GetZ());
+    const TVector3 vertex(vertexPosition.GetX(), vertexPosition.GetY(), vertexPosition.GetZ());
+
+    // TODO
+    const TVector3 directionErr;
+    const TVector3 vertexErr;
+    const std::vector<double> totalEnergyErr;
+    const std::vector<double> dEdx;
+    const std::vector<double> dEdxErr;
+    const std::vector<double> totalEnergy;
+    const int bestplane(0);
+
+    return recob::Shower(direction, directionErr, vertex, vertexErr, totalEnergy, totalEnergyErr, dEdx, dEdxErr, bestplane, id, length, openingAngle);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+recob::PCAxis LArPandoraOutput::BuildPCAxis(const lar_content::LArShowerPCA &larShowerPCA)
+{
+    const pandora::CartesianVector &showerCentroid(larShowerPCA.GetCentroid());
+    const pandora::CartesianVector &showerDirection(larShowerPCA.GetPrimaryAxis());
+    const pandora::CartesianVector &showerSecondaryVector(larShowerPCA.GetSecondaryAxis());
+    const pandora::CartesianVector &showerTertiaryVector(larShowerPCA.GetTertiaryAxis());
+    const pandora::CartesianVector &showerEigenValues(larShowerPCA.GetEigenValues());
+
+    const bool svdOK(true); ///< SVD Decomposition was successful
+    const double eigenValues[3] = {showerEigenValues.GetX(), showerEigenValues.GetY(), showerEigenValues.GetZ()}; ///< Eigen values from SVD decomposition
+    const double avePosition[3] = {showerCentroid.GetX(), showerCentroid.GetY(), showerCentroid.GetZ()}; ///< Average position of hits fed to PCA
+
+    std::vector< std::vector<double> > eigenVecs = { /// The three principle axes
+        { showerDirection.GetX(), showerDirection.GetY(), showerDirection.GetZ() },
+        { showerSecondaryVector.GetX(), showerSecondaryVector.GetY(), showerSecondaryVector.GetZ() },
+        { showerTertiaryVector.GetX(), showerTertiaryVector.GetY(), showerTertiaryVector.GetZ() }
+    };
+
+    // TODO
+    const int numHitsUsed(100); ///< Number of hits in the decomposition, not yet ready
+    const double aveHitDoca(0.); ///< Average doca of hits used in PCA, not ready yet
+    const size_t iD(util::kBogusI); ///< Axis ID, not ready yet
+
+    return recob::PCAxis(svdOK, numHitsUsed, eigenValues, eigenVecs, avePosition, aveHitDoca, iD);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraOutput::BuildT0(const PfoProperties &pfoProperties, const size_t pfoId, size_t &nextId, anab::T0 &t0)
+{
+    const float x0(pfoProperties.m_x0);
 
     auto const* theDetector = lar::providerFrom<detinfo::DetectorPropertiesService>();
     const double cm_per_tick(theDetector->GetXTicksCoefficient());
@@ -977,7 +1659,7 @@ bool LArPandoraOutput::BuildT0(const pandora::ParticleFlowObject *const pPfo, co
         return false;
 
     // Output T0 objects [arguments are:  time (nanoseconds);  trigger type (3 for TPC stitching!);  pfparticle SelfID code;  T0 ID code]
-    t0 = anab::T0(T0, 3, LArPandoraOutput::GetId(pPfo, pfoVector), nextId++);
+    t0 = anab::T0(T0, 3, pfoId, nextId++);
 
     return true;
 }
@@ -991,7 +1673,16 @@ LArPandoraOutput::Settings::Settings() :
     m_shouldRunStitching(false),
     m_shouldProduceAllOutcomes(false),
     m_shouldProduceTestBeamInteractionVertices(false),
-    m_isNeutrinoRecoOnlyNoSlicing(false)
+    m_isNeutrinoRecoOnlyNoSlicing(false),
+    m_shouldProducePfoSummary(false),
+    m_clearCosmicOutputTier(kFullOutput),
+    m_sliceCosmicOutputTier(kFullOutput),
+    m_neutrinoOutputTier(kFullOutput),
+    m_spacePointDecimation(1),
+    m_shouldProduceTracksAndShowers(false),
+    m_minTrajectoryPoints(2),
+    m_slidingFitHalfWindow(20),
+    m_wirePitchW(0.f)
 {
 }
 
@@ -1005,10 +1696,33 @@ void LArPandoraOutput::Settings::Validate() const
     if (!m_pProducer)
         throw cet::exception("LArPandora") << " LArPandoraOutput::Settings::Validate --- pointer to ART Producer module does not exist ";
 
+    if (0 == m_spacePointDecimation)
+        throw cet::exception("LArPandora") << " LArPandoraOutput::Settings::Validate --- space point decimation factor must be positive ";
+
+    if (m_shouldProduceTracksAndShowers && (m_minTrajectoryPoints < 2))
+        throw cet::exception("LArPandora") << " LArPandoraOutput::Settings::Validate --- minimum number of trajectory points should not be smaller than 2 ";
+
+    if (m_shouldProduceTracksAndShowers && !(m_wirePitchW > 0.f))
+        throw cet::exception("LArPandora") << " LArPandoraOutput::Settings::Validate --- sliding fit length scale not set ";
+
     if (!m_shouldProduceAllOutcomes) return;
 
     if (m_allOutcomesInstanceLabel.empty())
         throw cet::exception("LArPandora") << " LArPandoraOutput::Settings::Validate --- all outcomes instance label not set ";
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraOutput::PfoProperties::PfoProperties() :
+    m_pParentPfo(nullptr),
+    m_parentId(recob::PFParticle::kPFParticlePrimary),
+    m_isInNeutrinoHierarchy(false),
+    m_isClearCosmic(false),
+    m_isFromSlice(false),
+    m_sliceIndex(0),
+    m_x0(0.f)
+{
+}
+
 } // namespace lar_pandora
@@ -20,8 +20,16 @@
 
 #include "Pandora/PandoraInternal.h"
 
+#include "larpandoracontent/LArObjects/LArPfoObjects.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <exception>
+
 namespace art {class EDProducer;}
 namespace pandora {class Pandora;}
+namespace recob {class PCAxis; class TrackHitMeta;}
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -42,6 +50,24 @@ public:
     typedef std::unique_ptr< std::vector<anab::T0> > T0Collection;
     typedef std::unique_ptr< std::vector<larpandoraobj::PFParticleMetadata> > PFParticleMetadataCollection;
     typedef std::unique_ptr< std::vector<recob::Slice> > SliceCollection;
+    typedef std::unique_ptr< std::vector<int> > IntCollection;
+    typedef std::unique_ptr< std::vector<float> > FloatCollection;
+    typedef std::unique_ptr< std::string > StringCollection;
+    typedef std::unique_ptr< std::vector<recob::Track> > TrackCollection;
+    typedef std::unique_ptr< std::vector<recob::Shower> > ShowerCollection;
+    typedef std::unique_ptr< std::vector<recob::PCAxis> > PCAxisCollection;
+
+    /**
+     *  @brief  The level of detail with which a pfo is written
+     */
+    enum OutputTier
+    {
+        kFullOutput = 0,            ///< All products are written
+        kDecimatedSpacePoints = 1,  ///< All products are written, but only one in every m_spacePointDecimation space points is kept
+        kSummaryOnly = 2            ///< Only the PFParticle, vertex, metadata (and slice) products are written, no clusters or space points
+    };
+
+    typedef std::vector<OutputTier> OutputTierVector;
 
     typedef std::unique_ptr< art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata> > PFParticleToMetadataCollection;
     typedef std::unique_ptr< art::Assns<recob::PFParticle, recob::SpacePoint> > PFParticleToSpacePointCollection;
@@ -54,6 +80,14 @@ public:
     typedef std::unique_ptr< art::Assns<recob::SpacePoint, recob::Hit> > SpacePointToHitCollection;
     typedef std::unique_ptr< art::Assns<recob::Slice, recob::Hit> > SliceToHitCollection;
 
+    typedef std::unique_ptr< art::Assns<recob::PFParticle, recob::Track> > PFParticleToTrackCollection;
+    typedef std::unique_ptr< art::Assns<recob::PFParticle, recob::Shower> > PFParticleToShowerCollection;
+    typedef std::unique_ptr< art::Assns<recob::PFParticle, recob::PCAxis> > PFParticleToPCAxisCollection;
+    typedef std::unique_ptr< art::Assns<recob::Track, recob::Hit> > TrackToHitCollection;
+    typedef std::unique_ptr< art::Assns<recob::Track, recob::Hit, recob::TrackHitMeta> > TrackToHitWithMetaCollection;
+    typedef std::unique_ptr< art::Assns<recob::Shower, recob::Hit> > ShowerToHitCollection;
+    typedef std::unique_ptr< art::Assns<recob::Shower, recob::PCAxis> > ShowerToPCAxisCollection;
+
     /**
      *  @brief  Settings class
      */
@@ -80,8 +114,41 @@ public:
         std::string             m_testBeamInteractionVerticesInstanceLabel;  ///< The label for the test beam interaction vertices
         bool                    m_isNeutrinoRecoOnlyNoSlicing;               ///< If we are running the neutrino reconstruction only with no slicing
         std::string             m_hitfinderModuleLabel;                      ///< The hit finder module label
+        std::vector<std::string> m_fastClusterParamsInstanceLabels;          ///< The instance labels for which clusters are built with the fast parameter profile
+        bool                    m_shouldProducePfoSummary;                   ///< Whether to write the compact columnar pfo summary (see LArPandoraSummary)
+        std::string             m_pfoSummaryInstanceLabel;                   ///< The label for the pfo summary, appended to the current instance label
+        OutputTier              m_clearCosmicOutputTier;                     ///< The output tier for pfos in clear cosmic-ray hierarchies
+        OutputTier              m_sliceCosmicOutputTier;                     ///< The output tier for pfos in cosmic-ray hierarchies reconstructed in a slice
+        OutputTier              m_neutrinoOutputTier;                        ///< The output tier for pfos in neutrino hierarchies
+        unsigned int            m_spacePointDecimation;                      ///< The space point decimation factor for the kDecimatedSpacePoints tier
+        bool                    m_shouldProduceTracksAndShowers;             ///< Whether to build tracks and showers from the pfos, as LArPandoraTrackCreation and LArPandoraShowerCreation would
+        unsigned int            m_minTrajectoryPoints;                       ///< The minimum number of trajectory points for a track to be written
+        unsigned int            m_slidingFitHalfWindow;                      ///< The sliding fit half window used for the track trajectories
+        float                   m_wirePitchW;                                ///< The length scale of the sliding fits, from the geometry constants
+    };
+
+    /**
+     *  @brief  PfoProperties class, holding the hierarchy properties of a pfo that drive the output decisions
+     */
+    class PfoProperties
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        PfoProperties();
+
+        const pandora::ParticleFlowObject  *m_pParentPfo;           ///< The top-level parent of the pfo
+        size_t                              m_parentId;             ///< The id of the direct parent of the pfo, kPFParticlePrimary if it has none
+        bool                                m_isInNeutrinoHierarchy; ///< Whether the top-level parent is a neutrino
+        bool                                m_isClearCosmic;        ///< Whether the pfo is in a clear cosmic-ray hierarchy
+        bool                                m_isFromSlice;          ///< Whether the pfo was produced from a slice
+        unsigned int                        m_sliceIndex;           ///< The index of the slice from which the pfo was produced, if m_isFromSlice
+        float                               m_x0;                   ///< The stitching x0 shift of the parent, zero if not set
     };
 
+    typedef std::vector<PfoProperties> PfoPropertiesVector;
+
     /**
      *  @brief  Convert the Pandora PFOs into ART clusters and write into ART event
      *
@@ -138,6 +205,35 @@ public:
      */
     static unsigned int GetSliceIndex(const pandora::ParticleFlowObject *const pPfo);
 
+    /**
+     *  @brief  Build the table of hierarchy properties for the input pfos, resolving each parent link once through the pfo ids and
+     *          reading the properties map of each top-level parent once
+     *
+     *  @param  pfoVector the input list of pfos
+     *
+     *  @return the properties of each pfo, indexed by pfo id
+     */
+    static PfoPropertiesVector BuildPfoPropertiesTable(const pandora::PfoVector &pfoVector);
+
+    /**
+     *  @brief  Get the output tier from its name
+     *
+     *  @param  name the name of the tier: Full, DecimatedSpacePoints or SummaryOnly
+     *
+     *  @return the output tier
+     */
+    static OutputTier GetOutputTier(const std::string &name);
+
+    /**
+     *  @brief  Get the output tier of each pfo, according to the class (clear cosmic, slice cosmic or neutrino) of its hierarchy
+     *
+     *  @param  settings the settings
+     *  @param  pfoPropertiesTable the properties of each pfo
+     *
+     *  @return the output tier of each pfo, empty if all pfos should be written in full
+     */
+    static OutputTierVector GetOutputTiers(const Settings &settings, const PfoPropertiesVector &pfoPropertiesTable);
+
     /**
      *  @brief  Collect the current pfos (including all downstream pfos) from the master pandora instance
      *
@@ -181,11 +277,13 @@ public:
      *          Order is guaranteed provided pfoVector is ordered
      *
      *  @param  pfoVector the input list of pfos
+     *  @param  pfoTiers the output tier of each pfo (empty to write all pfos in full), no clusters are collected for summary-only pfos
      *  @param  pfoToClustersMap the output mapping from pfo ID to cluster IDs
      *
      *  @return the list of clusters collected
      */
-    static pandora::ClusterList CollectClusters(const pandora::PfoVector &pfoVector, IdToIdVectorMap &pfoToClustersMap);
+    static pandora::ClusterList CollectClusters(const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers,
+        IdToIdVectorMap &pfoToClustersMap);
 
     /**
      *  @brief  Collect a sorted vector of all 3D hits in the input pfo
@@ -200,11 +298,14 @@ public:
      *          Order is guaranteed provided pfoVector is ordered
      *
      *  @param  pfoVector the input list of pfos
+     *  @param  pfoTiers the output tier of each pfo (empty to write all pfos in full)
+     *  @param  spacePointDecimation the decimation factor for pfos with decimated space points
      *  @param  pfoToThreeDHitsMap the output mapping from pfo ID to 3D hit IDs
      *
      *  @return the list of 3D hits collected
      */
-    static pandora::CaloHitList Collect3DHits(const pandora::PfoVector &pfoVector, IdToIdVectorMap &pfoToThreeDHitsMap);
+    static pandora::CaloHitList Collect3DHits(const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers,
+        const unsigned int spacePointDecimation, IdToIdVectorMap &pfoToThreeDHitsMap);
 
     /**
      *  @brief  Find the index of an input object in an input list. Throw an exception if it doesn't exist
@@ -283,10 +384,12 @@ public:
      *  @param  outputClusters the output vector of clusters
      *  @param  outputClustersToHits the output associations between clusters and hits
      *  @param  pfoToArtClustersMap the output mapping from pfo ID to art cluster ID
+     *  @param  useFastClusterParams whether to fill only the cluster end points with their uncertainties, hit count and integral
      */
     static void BuildClusters(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
         const pandora::ClusterList &clusterList, const CaloHitToArtHitMap &pandoraHitToArtHitMap, const IdToIdVectorMap &pfoToClustersMap,
-        ClusterCollection &outputClusters, ClusterToHitCollection &outputClustersToHits, IdToIdVectorMap &pfoToArtClustersMap);
+        ClusterCollection &outputClusters, ClusterToHitCollection &outputClustersToHits, IdToIdVectorMap &pfoToArtClustersMap,
+        const bool useFastClusterParams = false);
 
     /**
      *  @brief  Convert between pfos and PFParticles and add them to the output vector
@@ -328,13 +431,36 @@ public:
      *  @param  event the art event
      *  @param  pProducer the address of the producer module
      *  @param  pfoVector the input list of pfos
+     *  @param  pfoTiers the output tier of each pfo, recorded in the metadata as "OutputTier" (empty if no output policy applied)
      *  @param  outputParticleMetadata the output vector of PFParticleMetadata
      *  @param  outputParticlesToMetadata the output associations between PFParticles and metadata
      */
     static void BuildParticleMetadata(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
-        const pandora::PfoVector &pfoVector, PFParticleMetadataCollection &outputParticleMetadata,
+        const pandora::PfoVector &pfoVector, const OutputTierVector &pfoTiers, PFParticleMetadataCollection &outputParticleMetadata,
         PFParticleToMetadataCollection &outputParticlesToMetadata);
 
+    /**
+     *  @brief  Build the compact columnar pfo summary, see LArPandoraSummary for the layout
+     *
+     *  @param  event the ART event
+     *  @param  hitfinderModuleLabel the label of the hit collection from which the pandora hits were made
+     *  @param  pfoVector the input list of pfos
+     *  @param  pfoPropertiesTable the properties of each pfo
+     *  @param  clusterList the input list of 2D pandora clusters
+     *  @param  threeDHitList the input list of 3D hits
+     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  pfoToClustersMap the input mapping from pfo ID to cluster IDs
+     *  @param  pfoToThreeDHitsMap the input mapping from pfo ID to 3D hit IDs
+     *  @param  outputPfoSummary the output pfo table
+     *  @param  outputPfoSummarySpacePoints the output space point positions
+     *  @param  outputPfoSummaryHits the output hit keys
+     *  @param  outputPfoSummaryHitTag the output input tag of the hit collection indexed by the hit keys
+     */
+    static void BuildPfoSummary(const art::Event &event, const std::string &hitfinderModuleLabel, const pandora::PfoVector &pfoVector, const PfoPropertiesVector &pfoPropertiesTable, const pandora::ClusterList &clusterList,
+        const pandora::CaloHitList &threeDHitList, const CaloHitToArtHitMap &pandoraHitToArtHitMap, const IdToIdVectorMap &pfoToClustersMap,
+        const IdToIdVectorMap &pfoToThreeDHitsMap, IntCollection &outputPfoSummary, FloatCollection &outputPfoSummarySpacePoints,
+        IntCollection &outputPfoSummaryHits, StringCollection &outputPfoSummaryHitTag);
+
     /**
      *  @brief  Build slices - collections of hits which each describe a single particle hierarchy
      *
@@ -344,6 +470,7 @@ public:
      *  @param  pProducer the address of the pandora producer
      *  @param  instanceLabel the label for the collections to be produced
      *  @param  pfoVector the input vector of all pfos to be output
+     *  @param  pfoPropertiesTable the properties of each pfo
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
      *  @param  outputSlices the output collection of slices to populate
      *  @param  outputParticlesToSlices the output association from particles to slices
@@ -351,7 +478,7 @@ public:
      */
     static void BuildSlices(const Settings &settings, const pandora::Pandora *const pPrimaryPandora, const art::Event &event,
     const art::EDProducer *const pProducer, const std::string &instanceLabel, const pandora::PfoVector &pfoVector,
-    const IdToHitMap &idToHitMap, SliceCollection &outputSlices, PFParticleToSliceCollection &outputParticlesToSlices,
+    const PfoPropertiesVector &pfoPropertiesTable, const IdToHitMap &idToHitMap, SliceCollection &outputSlices, PFParticleToSliceCollection &outputParticlesToSlices,
     SliceToHitCollection &outputSlicesToHits);
 
     /**
@@ -362,7 +489,7 @@ public:
     static unsigned int BuildDummySlice(SliceCollection &outputSlices);
 
     /**
-     *  @brief  Ouput a single slice containing all of the input hits
+     *  @brief  Ouput a single slice containing all of the input hits, taken from the input hit index rather than the event
      *
      *  @param  settings the settings
      *  @param  event the art event
@@ -400,12 +527,93 @@ public:
      *  @param  event the art event
      *  @param  pProducer the address of the producer module
      *  @param  instanceLabel the label for the collections to be produced
-     *  @param  pfoVector the input list of pfos
+     *  @param  pfoPropertiesTable the properties of each pfo
      *  @param  outputT0s the output vector of T0s
      *  @param  outputParticlesToT0s the output associations between PFParticles and T0s
      */
     static void BuildT0s(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
-        const pandora::PfoVector &pfoVector, T0Collection &outputT0s, PFParticleToT0Collection &outputParticlesToT0s);
+        const PfoPropertiesVector &pfoPropertiesTable, T0Collection &outputT0s, PFParticleToT0Collection &outputParticlesToT0s);
+
+    /**
+     *  @brief  Collect the art hits of each output cluster, in the order of the cluster to hit associations
+     *
+     *  @param  outputClustersToHits the output associations between clusters and hits
+     *  @param  nClusters the number of output clusters
+     *  @param  artClusterHits the output hits of each cluster, indexed by cluster id
+     */
+    static void CollectArtClusterHits(const ClusterToHitCollection &outputClustersToHits, const size_t nClusters, std::vector<HitVector> &artClusterHits);
+
+    /**
+     *  @brief  Get the inputs of a track or shower fit for a pfo, applying the selection of LArPandoraTrackCreation and LArPandoraShowerCreation
+     *
+     *  @param  pfoId the id of the pfo
+     *  @param  vertexVector the input vector of vertices
+     *  @param  threeDHitVector the input vector of 3D hits
+     *  @param  pfoToVerticesMap the input mapping from pfo ID to vertex IDs
+     *  @param  pfoToThreeDHitsMap the input mapping from pfo ID to 3D hit IDs
+     *  @param  pfoToArtClustersMap the input mapping from pfo ID to ART cluster IDs
+     *  @param  cartesianPointVector the output positions of the 3D hits, in the order of the pfo to space point associations
+     *  @param  vertexPosition the output vertex position
+     *
+     *  @return whether the pfo has space points, clusters and a single vertex
+     */
+    static bool GetFitInputs(const size_t pfoId, const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector,
+        const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+        pandora::CartesianPointVector &cartesianPointVector, pandora::CartesianVector &vertexPosition);
+
+    /**
+     *  @brief  Build tracks from the track-like pfos, matching the output of LArPandoraTrackCreation
+     *          Create the associations between PFParticles and tracks, and between tracks and hits
+     *
+     *  @param  settings the settings
+     *  @param  event the art event
+     *  @param  instanceLabel the label for the collections to be produced
+     *  @param  pfoVector the input vector of all pfos to be output
+     *  @param  vertexVector the input vector of vertices
+     *  @param  threeDHitVector the input vector of 3D hits
+     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  pfoToVerticesMap the input mapping from pfo ID to vertex IDs
+     *  @param  pfoToThreeDHitsMap the input mapping from pfo ID to 3D hit IDs
+     *  @param  pfoToArtClustersMap the input mapping from pfo ID to ART cluster IDs
+     *  @param  artClusterHits the input hits of each ART cluster
+     *  @param  outputTracks the output vector of tracks
+     *  @param  outputParticlesToTracks the output associations between PFParticles and tracks
+     *  @param  outputTracksToHits the output associations between tracks and hits
+     *  @param  outputTracksToHitsWithMeta the output associations between tracks and hits, with the index of each hit along the trajectory
+     */
+    static void BuildTracks(const Settings &settings, const art::Event &event, const std::string &instanceLabel, const pandora::PfoVector &pfoVector,
+        const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector, const CaloHitToArtHitMap &pandoraHitToArtHitMap,
+        const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+        const std::vector<HitVector> &artClusterHits, TrackCollection &outputTracks, PFParticleToTrackCollection &outputParticlesToTracks,
+        TrackToHitCollection &outputTracksToHits, TrackToHitWithMetaCollection &outputTracksToHitsWithMeta);
+
+    /**
+     *  @brief  Build showers and pca axes from the shower-like pfos, matching the output of LArPandoraShowerCreation
+     *          Create the associations between PFParticles and showers and pca axes, between showers and hits, and between showers and pca axes
+     *
+     *  @param  event the art event
+     *  @param  pProducer the address of the producer module
+     *  @param  instanceLabel the label for the collections to be produced
+     *  @param  pfoVector the input vector of all pfos to be output
+     *  @param  vertexVector the input vector of vertices
+     *  @param  threeDHitVector the input vector of 3D hits
+     *  @param  pfoToVerticesMap the input mapping from pfo ID to vertex IDs
+     *  @param  pfoToThreeDHitsMap the input mapping from pfo ID to 3D hit IDs
+     *  @param  pfoToArtClustersMap the input mapping from pfo ID to ART cluster IDs
+     *  @param  artClusterHits the input hits of each ART cluster
+     *  @param  outputShowers the output vector of showers
+     *  @param  outputPCAxes the output vector of pca axes
+     *  @param  outputParticlesToShowers the output associations between PFParticles and showers
+     *  @param  outputParticlesToPCAxes the output associations between PFParticles and pca axes
+     *  @param  outputShowersToHits the output associations between showers and hits
+     *  @param  outputShowersToPCAxes the output associations between showers and pca axes
+     */
+    static void BuildShowers(const art::Event &event, const art::EDProducer *const pProducer, const std::string &instanceLabel,
+        const pandora::PfoVector &pfoVector, const pandora::VertexVector &vertexVector, const pandora::CaloHitVector &threeDHitVector,
+        const IdToIdVectorMap &pfoToVerticesMap, const IdToIdVectorMap &pfoToThreeDHitsMap, const IdToIdVectorMap &pfoToArtClustersMap,
+        const std::vector<HitVector> &artClusterHits, ShowerCollection &outputShowers, PCAxisCollection &outputPCAxes,
+        PFParticleToShowerCollection &outputParticlesToShowers, PFParticleToPCAxisCollection &outputParticlesToPCAxes,
+        ShowerToHitCollection &outputShowersToHits, ShowerToPCAxisCollection &outputShowersToPCAxes);
 
     /**
      *  @brief  Convert from a pandora vertex to an ART vertex
@@ -427,6 +635,96 @@ public:
      */
     static recob::SpacePoint BuildSpacePoint(const pandora::CaloHit *const pCaloHit, const size_t spacePointId);
 
+    /**
+     *  @brief  Build an ART track from the trajectory points of a sliding fit, points with bogus positions being flagged as NoPoint
+     *
+     *  @param  id the id code for the track
+     *  @param  trackStateVector the vector of trajectory points for this track
+     *
+     *  @return the ART track
+     */
+    static recob::Track BuildTrack(const int id, const lar_content::LArTrackStateVector &trackStateVector);
+
+    /**
+     *  @brief  Run the pandora sliding fit of a track trajectory
+     *
+     *  @param  cartesianPointVector the input space point positions
+     *  @param  vertexPosition the input vertex position
+     *  @param  slidingFitHalfWindow the sliding fit half window
+     *  @param  wirePitchW the length scale of the sliding fit
+     *  @param  trackStateVector to receive the trajectory points
+     *  @param  indexVector to receive the space point indices in trajectory point order
+     *
+     *  @return whether the sliding fit succeeded
+     */
+    static bool GetSlidingFitTrajectory(const pandora::CartesianPointVector &cartesianPointVector, const pandora::CartesianVector &vertexPosition,
+        const unsigned int slidingFitHalfWindow, const float wirePitchW, lar_content::LArTrackStateVector &trackStateVector, pandora::IntVector &indexVector);
+
+    /**
+     *  @brief  Collect the hits of a track in trajectory point order, and pad the trajectory with invalid points so there is one per hit
+     *
+     *  @param  hitsFromSpacePoints the input hits from the space points, in trajectory point order
+     *  @param  hitsFromClusters the input hits from the clusters, those not found in the space points being added at the end
+     *  @param  trackStateVector the trajectory points, to receive the invalid points
+     *  @param  hitsInParticle to receive the hits of the track
+     */
+    static void GetTrackHits(const HitVector &hitsFromSpacePoints, const HitVector &hitsFromClusters, lar_content::LArTrackStateVector &trackStateVector,
+        HitVector &hitsInParticle);
+
+    /**
+     *  @brief  Associate a track with its hits, with the index of each hit along the trajectory as metadata
+     *
+     *  @param  pTrack the track
+     *  @param  hitsInParticle the hits of the track, as collected by GetTrackHits
+     *  @param  nHitsFromSpacePoints the number of hits from space points, which come first and are the only ones given an index
+     *  @param  outputTracksToHitsWithMeta the output associations between tracks and hits, with metadata
+     */
+    static void AddTrackHitMetadata(const art::Ptr<recob::Track> &pTrack, const HitVector &hitsInParticle, const size_t nHitsFromSpacePoints,
+        TrackToHitWithMetaCollection &outputTracksToHitsWithMeta);
+
+    /**
+     *  @brief  Run a fit for each entry of a vector, in parallel over up to a given number of threads. Each fit must only write to its
+     *          own entry, and the first exception thrown, in entry order, is rethrown once all the fits have run
+     *
+     *  @param  fits the fits to run
+     *  @param  nThreads the maximum number of threads
+     *  @param  fRunFit the function running a single fit
+     */
+    template <typename T, typename F>
+    static void RunFits(std::vector<T> &fits, const unsigned int nThreads, const F &fRunFit);
+
+    /**
+     *  @brief  Project the vertex onto the primary axis of a shower pca, and orient the axes to point away from the projected vertex
+     *
+     *  @param  initialLArShowerPCA the input shower pca
+     *  @param  vertexPosition the input vertex position
+     *  @param  projectedVertexPosition to receive the projected vertex position
+     *
+     *  @return the oriented shower pca
+     */
+    static lar_content::LArShowerPCA OrientShowerPCA(const lar_content::LArShowerPCA &initialLArShowerPCA, const pandora::CartesianVector &vertexPosition,
+        pandora::CartesianVector &projectedVertexPosition);
+
+    /**
+     *  @brief  Build an ART shower from a shower pca
+     *
+     *  @param  id the id code for the shower
+     *  @param  larShowerPCA the lar shower pca parameters extracted from pandora
+     *  @param  vertexPosition the shower vertex position
+     *
+     *  @return the ART shower
+     */
+    static recob::Shower BuildShower(const int id, const lar_content::LArShowerPCA &larShowerPCA, const pandora::CartesianVector &vertexPosition);
+
+    /**
+     *  @brief  Build an ART pca axis from a shower pca
+     *
+     *  @param  larShowerPCA the lar shower pca parameters extracted from pandora
+     *
+     *  @return the ART pca axis
+     */
+    static recob::PCAxis BuildPCAxis(const lar_content::LArShowerPCA &larShowerPCA);
+
     /**
      *  @brief  Collect a sorted list of all 2D hits in a cluster
      *
@@ -444,12 +742,13 @@ public:
      *  @param  pandoraClusterToArtClustersMap output mapping from pandora cluster ID to art cluster IDs
      *  @param  hitVectors the output vectors of hits for each cluster produced used to produce associations
      *  @param  algo algorithm set to fill cluster members
+     *  @param  useFastClusterParams whether to fill only the cluster end points with their uncertainties, hit count and integral (algo is then unused)
      *
      *  @param  the vector of ART clusters
      */
     static std::vector<recob::Cluster> BuildClusters(const pandora::Cluster *const pCluster, const pandora::ClusterList &clusterList,
         const CaloHitToArtHitMap &pandoraHitToArtHitMap, IdToIdVectorMap &pandoraClusterToArtClustersMap, std::vector<HitVector> &hitVectors,
-        size_t &nextId, cluster::ClusterParamsAlgBase &algo);
+        size_t &nextId, cluster::ClusterParamsAlgBase &algo, const bool useFastClusterParams = false);
 
     /**
      *  @brief  Build an ART cluster from an input vector of ART hits
@@ -467,6 +766,22 @@ public:
     static recob::Cluster BuildCluster(const size_t id, const HitVector &hitVector, const HitList &isolatedHits,
         cluster::ClusterParamsAlgBase &algo);
 
+    /**
+     *  @brief  Build an ART cluster from an input vector of ART hits, filling only the start/end wire and tick with their uncertainties,
+     *          hit count and integral
+     *
+     *  @param  id the id code for the cluster
+     *  @param  hitVector the input vector of hits
+     *  @param  isolatedHits the input list of isolated hits
+     *
+     *  @return the ART cluster
+     *
+     *  The parameters are found in a single pass over the hits, without running a ClusterParamsAlgBase. The end point uncertainties
+     *  are defined as in BuildCluster. Isolated hits contribute to the hit count and integral, but not to the end points. All other
+     *  cluster parameters (angles, opening angles, charges, widths and densities) are deliberately left at zero.
+     */
+    static recob::Cluster BuildClusterFastParams(const size_t id, const HitVector &hitVector, const HitList &isolatedHits);
+
     /**
      *  @brief  Convert from a pfo to and ART PFParticle
      *
@@ -481,14 +796,14 @@ public:
     /**
      *  @brief  If required, build a T0 for the input pfo
      *
-     *  @param  pPfo the input pfo
-     *  @param  pfoVector the input list of pfos
+     *  @param  pfoProperties the properties of the input pfo
+     *  @param  pfoId the id of the input pfo
      *  @param  nextId the ID of the T0 - will be incremented if the t0 was produced
      *  @param  t0 the output T0
      *
      *  @return if a T0 was produced (calculated from the stitching hit shift distance)
      */
-    static bool BuildT0(const pandora::ParticleFlowObject *const pPfo, const pandora::PfoVector &pfoVector, size_t &nextId, anab::T0 &t0);
+    static bool BuildT0(const PfoProperties &pfoProperties, const size_t pfoId, size_t &nextId, anab::T0 &t0);
 
     /**
      *  @brief  Add an association between objects with two given ids
@@ -606,6 +921,45 @@ inline void LArPandoraOutput::AddAssociation(const art::Event &event, const art:
         association->addSingle(pA, pB);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename F>
+inline void LArPandoraOutput::RunFits(std::vector<T> &fits, const unsigned int nThreads, const F &fRunFit)
+{
+    if ((nThreads < 2) || (fits.size() < 2))
+    {
+        for (T &fit : fits)
+            fRunFit(fit);
+
+        return;
+    }
+
+    // ATTN tbb would rethrow an arbitrary one of the exceptions, so each fit keeps its own and the choice doesn't depend on the scheduling
+    std::vector<std::exception_ptr> exceptions(fits.size());
+    tbb::task_arena arena(static_cast<int>(nThreads));
+
+    arena.execute([&fits, &fRunFit, &exceptions]()
+    {
+        tbb::parallel_for(size_t(0), fits.size(), [&fits, &fRunFit, &exceptions](const size_t fitIndex)
+        {
+            try
+            {
+                fRunFit(fits[fitIndex]);
+            }
+            catch (...)
+            {
+                exceptions[fitIndex] = std::current_exception();
+            }
+        });
+    });
+
+    for (const std::exception_ptr &pException : exceptions)
+    {
+        if (pException)
+            std::rethrow_exception(pException);
+    }
+}
+
 } // namespace lar_pandora
 
 #endif //  LAR_PANDORA_OUTPUT_H
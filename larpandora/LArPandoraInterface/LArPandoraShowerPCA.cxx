@@ -0,0 +1,266 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraShowerPCA.cxx
+ *
+ *  @brief  Single-pass principal component analysis of shower space points
+ */
+
+#include "lardataobj/RecoBase/SpacePoint.h"
+
+#include "Pandora/StatusCodes.h"
+
+#include "larpandoracontent/LArHelpers/LArPfoHelper.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraShowerPCA.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lar_pandora
+{
+
+lar_content::LArShowerPCA LArPandoraShowerPCA::GetPrincipalComponents(const SpacePointVector &spacePointVector, const pandora::CartesianVector &vertexPosition)
+{
+    const size_t nPoints(spacePointVector.size());
+
+    if (0 == nPoints)
+        throw pandora::StatusCodeException(pandora::STATUS_CODE_NOT_FOUND);
+
+    m_x.resize(nPoints);
+    m_y.resize(nPoints);
+    m_z.resize(nPoints);
+
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        const Double32_t *const xyz(spacePointVector[i]->XYZ());
+        m_x[i] = static_cast<float>(xyz[0]);
+        m_y[i] = static_cast<float>(xyz[1]);
+        m_z[i] = static_cast<float>(xyz[2]);
+    }
+
+    return this->GetArrayPrincipalComponents(vertexPosition);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+lar_content::LArShowerPCA LArPandoraShowerPCA::GetPrincipalComponents(const pandora::CartesianPointVector &cartesianPointVector,
+    const pandora::CartesianVector &vertexPosition)
+{
+    const size_t nPoints(cartesianPointVector.size());
+
+    if (0 == nPoints)
+        throw pandora::StatusCodeException(pandora::STATUS_CODE_NOT_FOUND);
+
+    m_x.resize(nPoints);
+    m_y.resize(nPoints);
+    m_z.resize(nPoints);
+
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        m_x[i] = cartesianPointVector[i].GetX();
+        m_y[i] = cartesianPointVector[i].GetY();
+        m_z[i] = cartesianPointVector[i].GetZ();
+    }
+
+    return this->GetArrayPrincipalComponents(vertexPosition);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+lar_content::LArShowerPCA LArPandoraShowerPCA::GetArrayPrincipalComponents(const pandora::CartesianVector &vertexPosition) const
+{
+    const size_t nPoints(m_x.size());
+
+    // ATTN the sums are taken relative to the first point, so the covariance doesn't suffer from cancellation far from the origin. The
+    // coordinates are widened before the subtraction, so the offsets and all the sums are in double precision
+    const float *const pX(m_x.data());
+    const float *const pY(m_y.data());
+    const float *const pZ(m_z.data());
+    const double x0(pX[0]), y0(pY[0]), z0(pZ[0]);
+
+    double sumX(0.), sumY(0.), sumZ(0.), sumXX(0.), sumYY(0.), sumZZ(0.), sumXY(0.), sumXZ(0.), sumYZ(0.);
+
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        const double dx(static_cast<double>(pX[i]) - x0), dy(static_cast<double>(pY[i]) - y0), dz(static_cast<double>(pZ[i]) - z0);
+        sumX += dx;
+        sumY += dy;
+        sumZ += dz;
+        sumXX += dx * dx;
+        sumYY += dy * dy;
+        sumZZ += dz * dz;
+        sumXY += dx * dy;
+        sumXZ += dx * dz;
+        sumYZ += dy * dz;
+    }
+
+    const double n(static_cast<double>(nPoints));
+    const double meanX(sumX / n), meanY(sumY / n), meanZ(sumZ / n);
+    const double covXX(sumXX / n - meanX * meanX), covYY(sumYY / n - meanY * meanY), covZZ(sumZZ / n - meanZ * meanZ);
+    const double covXY(sumXY / n - meanX * meanY), covXZ(sumXZ / n - meanX * meanZ), covYZ(sumYZ / n - meanY * meanZ);
+
+    const double covariance[3][3] = {{covXX, covXY, covXZ}, {covXY, covYY, covYZ}, {covXZ, covYZ, covZZ}};
+
+    double eigenValues[3] = {0., 0., 0.};
+    LArPandoraShowerPCA::GetEigenValues(covariance, eigenValues);
+
+    // Require that principal eigenvalue should always be positive
+    if (eigenValues[0] < std::numeric_limits<float>::epsilon())
+        throw pandora::StatusCodeException(pandora::STATUS_CODE_NOT_FOUND);
+
+    // ATTN a repeated eigenvalue leaves its eigenvectors free within a plane (or all of space), so any orthonormal choice is taken
+    double primary[3] = {1., 0., 0.}, secondary[3] = {0., 1., 0.}, tertiary[3] = {0., 0., 1.};
+    const bool hasPrimary(LArPandoraShowerPCA::GetEigenVector(covariance, eigenValues[0], primary));
+    const bool hasTertiary(LArPandoraShowerPCA::GetEigenVector(covariance, eigenValues[2], tertiary));
+
+    if (hasPrimary || hasTertiary)
+    {
+        if (!hasTertiary)
+            LArPandoraShowerPCA::GetPerpendicular(primary, tertiary);
+
+        if (!hasPrimary)
+            LArPandoraShowerPCA::GetPerpendicular(tertiary, primary);
+
+        // Secondary axis completes a right-handed set, then the tertiary axis is made exactly perpendicular to the other two
+        secondary[0] = tertiary[1] * primary[2] - tertiary[2] * primary[1];
+        secondary[1] = tertiary[2] * primary[0] - tertiary[0] * primary[2];
+        secondary[2] = tertiary[0] * primary[1] - tertiary[1] * primary[0];
+
+        const double secondaryNorm(std::sqrt(secondary[0] * secondary[0] + secondary[1] * secondary[1] + secondary[2] * secondary[2]));
+
+        for (unsigned int i = 0; i < 3; ++i)
+            secondary[i] /= secondaryNorm;
+
+        tertiary[0] = primary[1] * secondary[2] - primary[2] * secondary[1];
+        tertiary[1] = primary[2] * secondary[0] - primary[0] * secondary[2];
+        tertiary[2] = primary[0] * secondary[1] - primary[1] * secondary[0];
+    }
+
+    const pandora::CartesianVector centroid(static_cast<float>(x0 + meanX), static_cast<float>(y0 + meanY), static_cast<float>(z0 + meanZ));
+    const pandora::CartesianVector primaryAxis(primary[0], primary[1], primary[2]);
+    const pandora::CartesianVector secondaryAxis(secondary[0], secondary[1], secondary[2]);
+    const pandora::CartesianVector tertiaryAxis(tertiary[0], tertiary[1], tertiary[2]);
+
+    // By convention, principal axis should always point away from vertex
+    const float testProjection(primaryAxis.GetDotProduct(vertexPosition - centroid));
+    const float directionScaleFactor((testProjection > std::numeric_limits<float>::epsilon()) ? -1.f : 1.f);
+
+    return lar_content::LArShowerPCA(centroid, primaryAxis * directionScaleFactor, secondaryAxis * directionScaleFactor, tertiaryAxis * directionScaleFactor,
+        pandora::CartesianVector(eigenValues[0], eigenValues[1], eigenValues[2]));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+lar_content::LArShowerPCA LArPandoraShowerPCA::GetPandoraPrincipalComponents(const SpacePointVector &spacePointVector,
+    const pandora::CartesianVector &vertexPosition)
+{
+    // Copy information into expected pandora form
+    pandora::CartesianPointVector cartesianPointVector;
+    for (const art::Ptr<recob::SpacePoint> spacePoint : spacePointVector)
+        cartesianPointVector.emplace_back(pandora::CartesianVector(spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
+
+    return lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraShowerPCA::GetEigenValues(const double matrix[3][3], double eigenValues[3])
+{
+    // Trigonometric solution of the characteristic cubic, for a real symmetric matrix
+    const double offDiagonal2(matrix[0][1] * matrix[0][1] + matrix[0][2] * matrix[0][2] + matrix[1][2] * matrix[1][2]);
+    const double q((matrix[0][0] + matrix[1][1] + matrix[2][2]) / 3.);
+    const double p2((matrix[0][0] - q) * (matrix[0][0] - q) + (matrix[1][1] - q) * (matrix[1][1] - q) + (matrix[2][2] - q) * (matrix[2][2] - q) +
+        2. * offDiagonal2);
+
+    if (p2 <= 0.)
+    {
+        eigenValues[0] = eigenValues[1] = eigenValues[2] = q;
+        return;
+    }
+
+    const double p(std::sqrt(p2 / 6.));
+    const double b00((matrix[0][0] - q) / p), b11((matrix[1][1] - q) / p), b22((matrix[2][2] - q) / p);
+    const double b01(matrix[0][1] / p), b02(matrix[0][2] / p), b12(matrix[1][2] / p);
+    const double r(0.5 * (b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02) + b02 * (b01 * b12 - b11 * b02)));
+    const double phi((r <= -1.) ? M_PI / 3. : (r >= 1.) ? 0. : std::acos(r) / 3.);
+
+    eigenValues[0] = q + 2. * p * std::cos(phi);
+    eigenValues[2] = q + 2. * p * std::cos(phi + 2. * M_PI / 3.);
+    eigenValues[1] = 3. * q - eigenValues[0] - eigenValues[2];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LArPandoraShowerPCA::GetEigenVector(const double matrix[3][3], const double eigenValue, double eigenVector[3])
+{
+    // The eigenvector is perpendicular to the rows of (matrix - eigenValue * I), so take the best conditioned cross product of two rows
+    const double rows[3][3] = {{matrix[0][0] - eigenValue, matrix[0][1], matrix[0][2]},
+        {matrix[1][0], matrix[1][1] - eigenValue, matrix[1][2]},
+        {matrix[2][0], matrix[2][1], matrix[2][2] - eigenValue}};
+
+    double bestVector[3] = {0., 0., 0.};
+    double bestNorm2(0.), maxRowNorm2(0.);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        maxRowNorm2 = std::max(maxRowNorm2, rows[i][0] * rows[i][0] + rows[i][1] * rows[i][1] + rows[i][2] * rows[i][2]);
+
+        for (unsigned int j = i + 1; j < 3; ++j)
+        {
+            const double cross[3] = {rows[i][1] * rows[j][2] - rows[i][2] * rows[j][1], rows[i][2] * rows[j][0] - rows[i][0] * rows[j][2],
+                rows[i][0] * rows[j][1] - rows[i][1] * rows[j][0]};
+            const double norm2(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+            if (norm2 > bestNorm2)
+            {
+                bestNorm2 = norm2;
+                std::copy(cross, cross + 3, bestVector);
+            }
+        }
+    }
+
+    // ATTN the cross products of a rank one matrix (repeated eigenvalue) vanish up to rounding, relative to the squared row lengths
+    if (bestNorm2 <= 1.e-12 * maxRowNorm2 * maxRowNorm2)
+        return false;
+
+    const double norm(std::sqrt(bestNorm2));
+
+    for (unsigned int i = 0; i < 3; ++i)
+        eigenVector[i] = bestVector[i] / norm;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraShowerPCA::GetPerpendicular(const double vector[3], double perpendicular[3])
+{
+    // Cross with the coordinate axis least aligned with the vector
+    const double absX(std::fabs(vector[0])), absY(std::fabs(vector[1])), absZ(std::fabs(vector[2]));
+
+    if ((absX <= absY) && (absX <= absZ))
+    {
+        perpendicular[0] = 0.;
+        perpendicular[1] = vector[2];
+        perpendicular[2] = -vector[1];
+    }
+    else if (absY <= absZ)
+    {
+        perpendicular[0] = -vector[2];
+        perpendicular[1] = 0.;
+        perpendicular[2] = vector[0];
+    }
+    else
+    {
+        perpendicular[0] = vector[1];
+        perpendicular[1] = -vector[0];
+        perpendicular[2] = 0.;
+    }
+
+    const double norm(std::sqrt(perpendicular[0] * perpendicular[0] + perpendicular[1] * perpendicular[1] + perpendicular[2] * perpendicular[2]));
+
+    for (unsigned int i = 0; i < 3; ++i)
+        perpendicular[i] /= norm;
+}
+
+} // namespace lar_pandora
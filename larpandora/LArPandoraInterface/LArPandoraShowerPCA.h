@@ -0,0 +1,110 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraShowerPCA.h
+ *
+ *  @brief  Single-pass principal component analysis of shower space points
+ */
+
+#ifndef LAR_PANDORA_SHOWER_PCA_H
+#define LAR_PANDORA_SHOWER_PCA_H 1
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include "larpandoracontent/LArObjects/LArPfoObjects.h"
+
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  LArPandoraShowerPCA class
+ *
+ *  Alternative to lar_content::LArPfoHelper::GetPrincipalComponents, working directly from the space points. The coordinates are copied
+ *  into one array per coordinate, then the centroid and covariance are accumulated together in a single loop, in double precision and
+ *  using sums relative to the first point to limit cancellation. The eigenvalues and eigenvectors of the covariance are found in closed
+ *  form. The arrays are kept between calls, so an instance should be reused for all showers in a job. Agreement with the pandora
+ *  implementation can be checked in LArPandoraShowerCreation with CheckSinglePassPCA, and is tested in test/LArPandoraShowerPCA_test.
+ *  From space points, test/LArPandoraShowerPCA_benchmark measures it 6-8 times faster than the pandora implementation for showers of
+ *  10^4 to 10^6 points, mostly by avoiding the copies into pandora's point vectors, and 4-7 times faster from the same positions.
+ */
+class LArPandoraShowerPCA
+{
+public:
+    /**
+     *  @brief  Get the principal components of a set of space points, following the conventions of LArPfoHelper::GetPrincipalComponents
+     *
+     *  The axes are ordered by decreasing eigenvalue and all point away from the vertex along the primary axis. The signs of the secondary
+     *  and tertiary axes are otherwise arbitrary, as for the pandora implementation.
+     *
+     *  @param  spacePointVector the space points
+     *  @param  vertexPosition the vertex position
+     *
+     *  @return the principal components, throws pandora::StatusCodeException if the principal eigenvalue isn't positive
+     */
+    lar_content::LArShowerPCA GetPrincipalComponents(const SpacePointVector &spacePointVector, const pandora::CartesianVector &vertexPosition);
+
+    /**
+     *  @brief  Get the principal components of a set of positions, as for the space points
+     *
+     *  @param  cartesianPointVector the positions
+     *  @param  vertexPosition the vertex position
+     *
+     *  @return the principal components, throws pandora::StatusCodeException if the principal eigenvalue isn't positive
+     */
+    lar_content::LArShowerPCA GetPrincipalComponents(const pandora::CartesianPointVector &cartesianPointVector, const pandora::CartesianVector &vertexPosition);
+
+    /**
+     *  @brief  Get the principal components of a set of space points from lar_content::LArPfoHelper::GetPrincipalComponents
+     *
+     *  @param  spacePointVector the space points
+     *  @param  vertexPosition the vertex position
+     *
+     *  @return the principal components, throws pandora::StatusCodeException if the principal eigenvalue isn't positive
+     */
+    static lar_content::LArShowerPCA GetPandoraPrincipalComponents(const SpacePointVector &spacePointVector, const pandora::CartesianVector &vertexPosition);
+
+private:
+    /**
+     *  @brief  Get the principal components of the coordinates held in the arrays
+     *
+     *  @param  vertexPosition the vertex position
+     *
+     *  @return the principal components, throws pandora::StatusCodeException if the principal eigenvalue isn't positive
+     */
+    lar_content::LArShowerPCA GetArrayPrincipalComponents(const pandora::CartesianVector &vertexPosition) const;
+
+    /**
+     *  @brief  Get the eigenvalues of a symmetric 3x3 matrix, in decreasing order
+     *
+     *  @param  matrix the matrix
+     *  @param  eigenValues the output eigenvalues
+     */
+    static void GetEigenValues(const double matrix[3][3], double eigenValues[3]);
+
+    /**
+     *  @brief  Get the eigenvector of a symmetric 3x3 matrix for a given eigenvalue
+     *
+     *  @param  matrix the matrix
+     *  @param  eigenValue the eigenvalue
+     *  @param  eigenVector the output unit eigenvector
+     *
+     *  @return whether the eigenvector is well defined, which isn't the case for a repeated eigenvalue
+     */
+    static bool GetEigenVector(const double matrix[3][3], const double eigenValue, double eigenVector[3]);
+
+    /**
+     *  @brief  Get a unit vector perpendicular to a given unit vector
+     *
+     *  @param  vector the unit vector
+     *  @param  perpendicular the output perpendicular unit vector
+     */
+    static void GetPerpendicular(const double vector[3], double perpendicular[3]);
+
+    std::vector<float>  m_x;    ///< The x coordinates of the space points
+    std::vector<float>  m_y;    ///< The y coordinates of the space points
+    std::vector<float>  m_z;    ///< The z coordinates of the space points
+};
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_SHOWER_PCA_H
@@ -0,0 +1,83 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraSummary.cxx
+ *
+ *  @brief  Reader for the compact columnar pfo summary written by LArPandoraOutput
+ */
+
+#include "cetlib_except/exception.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraSummary.h"
+
+namespace lar_pandora
+{
+
+const std::string LArPandoraSummary::kPfoSuffix("Pfos");
+const std::string LArPandoraSummary::kSpacePointSuffix("SpacePoints");
+const std::string LArPandoraSummary::kHitSuffix("Hits");
+const std::string LArPandoraSummary::kHitTagSuffix("HitTag");
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+LArPandoraSummary::LArPandoraSummary(const art::Event &evt, const std::string &label, const std::string &summaryLabel) :
+    m_pPfos(nullptr),
+    m_pSpacePoints(nullptr),
+    m_pHitKeys(nullptr)
+{
+    art::Handle< std::vector<int> > pfoHandle;
+    evt.getByLabel(label, summaryLabel + kPfoSuffix, pfoHandle);
+
+    art::Handle< std::vector<float> > spacePointHandle;
+    evt.getByLabel(label, summaryLabel + kSpacePointSuffix, spacePointHandle);
+
+    art::Handle< std::vector<int> > hitKeyHandle;
+    evt.getByLabel(label, summaryLabel + kHitSuffix, hitKeyHandle);
+
+    art::Handle< std::string > hitTagHandle;
+    evt.getByLabel(label, summaryLabel + kHitTagSuffix, hitTagHandle);
+
+    if (!pfoHandle.isValid() || !spacePointHandle.isValid() || !hitKeyHandle.isValid() || !hitTagHandle.isValid())
+        throw cet::exception("LArPandora") << " LArPandoraSummary::LArPandoraSummary --- couldn't find the pfo summary with label: " << label << ", " << summaryLabel;
+
+    if (pfoHandle->size() % kNPfoColumns || spacePointHandle->size() % 3)
+        throw cet::exception("LArPandora") << " LArPandoraSummary::LArPandoraSummary --- the pfo summary columns have inconsistent sizes ";
+
+    m_pPfos = pfoHandle.product();
+    m_pSpacePoints = spacePointHandle.product();
+    m_pHitKeys = hitKeyHandle.product();
+    m_hitTag = art::InputTag(*hitTagHandle);
+
+    // ATTN: The tag includes the process name, so this is the collection the keys were written against, not a later reprocessing
+    if (!evt.getByLabel(m_hitTag, m_hitHandle))
+        return;
+
+    for (const int hitKey : *m_pHitKeys)
+    {
+        if ((hitKey < 0) || (static_cast<size_t>(hitKey) >= m_hitHandle->size()))
+            throw cet::exception("LArPandora") << " LArPandoraSummary::LArPandoraSummary --- hit key " << hitKey << " is out of range for hit collection " << m_hitTag;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+art::Ptr<recob::Hit> LArPandoraSummary::GetHit(const size_t pfoId, const size_t index) const
+{
+    if (index >= this->GetNumberOfHits(pfoId))
+        throw cet::exception("LArPandora") << " LArPandoraSummary::GetHit --- pfo " << pfoId << " has no hit with index " << index;
+
+    if (!m_hitHandle.isValid())
+        throw cet::exception("LArPandora") << " LArPandoraSummary::GetHit --- hit collection " << m_hitTag << " is not available in this event ";
+
+    return art::Ptr<recob::Hit>(m_hitHandle, this->GetHitKeys(pfoId)[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int LArPandoraSummary::GetColumn(const size_t pfoId, const PfoColumn column) const
+{
+    if (pfoId >= this->GetNumberOfPfos())
+        throw cet::exception("LArPandora") << " LArPandoraSummary::GetColumn --- no pfo with id " << pfoId;
+
+    return (*m_pPfos)[pfoId * kNPfoColumns + column];
+}
+
+} // namespace lar_pandora
@@ -0,0 +1,215 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraSummary.h
+ *
+ *  @brief  Reader for the compact columnar pfo summary written by LArPandoraOutput
+ */
+
+#ifndef LAR_PANDORA_SUMMARY_H
+#define LAR_PANDORA_SUMMARY_H 1
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include "lardataobj/RecoBase/Hit.h"
+
+#include <string>
+#include <vector>
+
+namespace lar_pandora
+{
+
+/**
+ *  @brief  LArPandoraSummary class
+ *
+ *  The summary is stored as three flat columns and a hit tag, each a separate product with instance name summaryLabel + suffix:
+ *   - Pfos: one row of kNPfoColumns ints per pfo (pdg code, parent id, slice index, space point and hit offsets)
+ *   - SpacePoints: x, y, z floats for each space point, grouped by pfo
+ *   - Hits: the keys of the 2D hits owned by each pfo, grouped by pfo
+ *   - HitTag: the encoded input tag, including the process name, of the hit collection indexed by the hit keys
+ */
+class LArPandoraSummary
+{
+public:
+    /**
+     *  @brief  The columns of a row in the pfo table
+     */
+    enum PfoColumn
+    {
+        kPdgCode = 0,           ///< The pdg code of the pfo
+        kParentId,              ///< The id of the parent pfo, or kNoId if primary
+        kSliceIndex,            ///< The index of the pandora slice from which the pfo was produced, or kNoId
+        kSpacePointBegin,       ///< The first space point of the pfo
+        kSpacePointEnd,         ///< One past the last space point of the pfo
+        kHitBegin,              ///< The first hit of the pfo
+        kHitEnd,                ///< One past the last hit of the pfo
+        kNPfoColumns            ///< The number of columns in a row
+    };
+
+    static const int            kNoId = -1;                 ///< The value used for a missing parent id or slice index
+    static const std::string    kPfoSuffix;                 ///< The instance name suffix of the pfo table
+    static const std::string    kSpacePointSuffix;          ///< The instance name suffix of the space point positions
+    static const std::string    kHitSuffix;                 ///< The instance name suffix of the hit keys
+    static const std::string    kHitTagSuffix;              ///< The instance name suffix of the hit collection tag
+
+    /**
+     *  @brief  Constructor, reads the summary columns from the event (the columns are not copied) and resolves the hit collection
+     *          indexed by the hit keys, if it is present in the event
+     *
+     *  @param  evt the art event
+     *  @param  label the label of the pandora producer
+     *  @param  summaryLabel the instance name prefix of the summary products
+     */
+    LArPandoraSummary(const art::Event &evt, const std::string &label, const std::string &summaryLabel = "pfoSummary");
+
+    /**
+     *  @brief  Get the number of pfos
+     */
+    size_t GetNumberOfPfos() const;
+
+    /**
+     *  @brief  Get the pdg code of a pfo
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    int GetPdgCode(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the id of the parent of a pfo, kNoId if the pfo is primary
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    int GetParentId(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the index of the pandora slice from which a pfo was produced, kNoId if it was not from a slice
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    int GetSliceIndex(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the number of space points of a pfo
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    size_t GetNumberOfSpacePoints(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the position of the first space point of a pfo, subsequent space points follow as x, y, z triplets
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    const float *GetSpacePoints(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the number of hits owned by a pfo
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    size_t GetNumberOfHits(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the keys of the hits owned by a pfo, in the hit collection given by GetHitTag
+     *
+     *  @param  pfoId the id of the pfo
+     */
+    const int *GetHitKeys(const size_t pfoId) const;
+
+    /**
+     *  @brief  Get the input tag of the hit collection indexed by the hit keys
+     */
+    const art::InputTag &GetHitTag() const;
+
+    /**
+     *  @brief  Get a hit owned by a pfo
+     *
+     *  @param  pfoId the id of the pfo
+     *  @param  index the index of the hit, less than GetNumberOfHits(pfoId)
+     */
+    art::Ptr<recob::Hit> GetHit(const size_t pfoId, const size_t index) const;
+
+private:
+    /**
+     *  @brief  Get a column of a row in the pfo table
+     *
+     *  @param  pfoId the id of the pfo
+     *  @param  column the column
+     */
+    int GetColumn(const size_t pfoId, const PfoColumn column) const;
+
+    const std::vector<int>     *m_pPfos;            ///< The pfo table, owned by the event
+    const std::vector<float>   *m_pSpacePoints;     ///< The space point positions, owned by the event
+    const std::vector<int>     *m_pHitKeys;         ///< The hit keys, owned by the event
+    art::InputTag               m_hitTag;           ///< The input tag of the hit collection indexed by the hit keys
+    art::Handle< std::vector<recob::Hit> > m_hitHandle; ///< The hit collection indexed by the hit keys, invalid if absent from the event
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline size_t LArPandoraSummary::GetNumberOfPfos() const
+{
+    return m_pPfos->size() / kNPfoColumns;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline int LArPandoraSummary::GetPdgCode(const size_t pfoId) const
+{
+    return this->GetColumn(pfoId, kPdgCode);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline int LArPandoraSummary::GetParentId(const size_t pfoId) const
+{
+    return this->GetColumn(pfoId, kParentId);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline int LArPandoraSummary::GetSliceIndex(const size_t pfoId) const
+{
+    return this->GetColumn(pfoId, kSliceIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline size_t LArPandoraSummary::GetNumberOfSpacePoints(const size_t pfoId) const
+{
+    return static_cast<size_t>(this->GetColumn(pfoId, kSpacePointEnd) - this->GetColumn(pfoId, kSpacePointBegin));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const float *LArPandoraSummary::GetSpacePoints(const size_t pfoId) const
+{
+    return m_pSpacePoints->data() + 3 * this->GetColumn(pfoId, kSpacePointBegin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline size_t LArPandoraSummary::GetNumberOfHits(const size_t pfoId) const
+{
+    return static_cast<size_t>(this->GetColumn(pfoId, kHitEnd) - this->GetColumn(pfoId, kHitBegin));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const int *LArPandoraSummary::GetHitKeys(const size_t pfoId) const
+{
+    return m_pHitKeys->data() + this->GetColumn(pfoId, kHitBegin);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline const art::InputTag &LArPandoraSummary::GetHitTag() const
+{
+    return m_hitTag;
+}
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_SUMMARY_H
@@ -0,0 +1,105 @@
+/**
+ *  @file   test/LArPandoraShowerPCA_benchmark.cc
+ *
+ *  @brief  Timing of the single-pass shower pca against lar_content::LArPfoHelper::GetPrincipalComponents, for showers of 10^4 to 10^6
+ *          space points. Not run by default: LArPandoraShowerPCA_benchmark [number of passes]
+ */
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include "lardataobj/RecoBase/SpacePoint.h"
+
+#include "larpandoracontent/LArHelpers/LArPfoHelper.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraShowerPCA.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace lar_pandora;
+
+namespace
+{
+
+/**
+ *  @brief  Get the mean time per call of a function, in ms
+ *
+ *  @param  nPasses the number of calls
+ *  @param  function the function
+ */
+template <typename T>
+double GetTime(const unsigned int nPasses, const T &function)
+{
+    const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+    for (unsigned int pass = 0; pass < nPasses; ++pass)
+        function();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / nPasses;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    const unsigned int nPasses((argc > 1) ? std::atoi(argv[1]) : 10);
+
+    std::mt19937 generator(20191019);
+    std::normal_distribution<double> gaussian(0., 1.);
+
+    std::cout << std::setw(10) << "points" << std::setw(16) << "pandora (ms)" << std::setw(16) << "single (ms)" << std::setw(16) <<
+        "pandora sp (ms)" << std::setw(16) << "single sp (ms)" << std::endl;
+
+    for (const unsigned int nPoints : {10000u, 100000u, 1000000u})
+    {
+        // An electromagnetic-like shower: long along z, narrow across, away from the origin
+        std::vector<recob::SpacePoint> spacePoints;
+        pandora::CartesianPointVector cartesianPointVector;
+
+        for (unsigned int i = 0; i < nPoints; ++i)
+        {
+            const Double32_t xyz[3] = {120. + 3. * gaussian(generator), -40. + 3. * gaussian(generator), 500. + 30. * gaussian(generator)};
+            const Double32_t err[6] = {0., 0., 0., 0., 0., 0.};
+            spacePoints.emplace_back(xyz, err, 0., static_cast<int>(i));
+            cartesianPointVector.emplace_back(xyz[0], xyz[1], xyz[2]);
+        }
+
+        SpacePointVector spacePointVector;
+        const art::ProductID productId(1);
+
+        for (unsigned int i = 0; i < nPoints; ++i)
+            spacePointVector.emplace_back(productId, &spacePoints[i], i);
+
+        const pandora::CartesianVector vertexPosition(120.f, -40.f, 400.f);
+        LArPandoraShowerPCA showerPCA;
+        float sum(0.f);
+
+        // ATTN one untimed call of each fills the caches and sizes the arrays of the single-pass pca, as for a reused instance in a job
+        sum += lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition).GetEigenValues().GetX();
+        sum += showerPCA.GetPrincipalComponents(spacePointVector, vertexPosition).GetEigenValues().GetX();
+
+        const double pandoraTime(GetTime(nPasses, [&]()
+            { sum += lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition).GetEigenValues().GetX(); }));
+        const double singlePassTime(GetTime(nPasses, [&]()
+            { sum += showerPCA.GetPrincipalComponents(cartesianPointVector, vertexPosition).GetEigenValues().GetX(); }));
+        const double pandoraSpacePointTime(GetTime(nPasses, [&]()
+            { sum += LArPandoraShowerPCA::GetPandoraPrincipalComponents(spacePointVector, vertexPosition).GetEigenValues().GetX(); }));
+        const double singlePassSpacePointTime(GetTime(nPasses, [&]()
+            { sum += showerPCA.GetPrincipalComponents(spacePointVector, vertexPosition).GetEigenValues().GetX(); }));
+
+        std::cout << std::setw(10) << nPoints << std::fixed << std::setprecision(3) << std::setw(16) << pandoraTime << std::setw(16) <<
+            singlePassTime << std::setw(16) << pandoraSpacePointTime << std::setw(16) << singlePassSpacePointTime << std::endl;
+
+        if (!(sum > 0.f))
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,323 @@
+/**
+ *  @file   test/LArPandoraShowerPCA_test.cc
+ *
+ *  @brief  Check of the single-pass shower pca against lar_content::LArPfoHelper::GetPrincipalComponents, including degenerate showers
+ */
+
+#define BOOST_TEST_MODULE ( LArPandoraShowerPCA_test )
+#include "boost/test/unit_test.hpp"
+
+#include "Pandora/StatusCodes.h"
+
+#include "larpandoracontent/LArHelpers/LArPfoHelper.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraShowerPCA.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace lar_pandora;
+
+namespace
+{
+
+/**
+ *  @brief  Get the covariance of a set of positions, normalised by the number of positions, in two passes in double precision
+ *
+ *  @param  pointVector the positions
+ *  @param  covariance the output covariance
+ */
+void GetCovariance(const pandora::CartesianPointVector &pointVector, double covariance[3][3])
+{
+    double mean[3] = {0., 0., 0.};
+
+    for (const pandora::CartesianVector &point : pointVector)
+    {
+        mean[0] += point.GetX();
+        mean[1] += point.GetY();
+        mean[2] += point.GetZ();
+    }
+
+    for (unsigned int i = 0; i < 3; ++i)
+        mean[i] /= static_cast<double>(pointVector.size());
+
+    for (unsigned int i = 0; i < 3; ++i)
+        std::fill(covariance[i], covariance[i] + 3, 0.);
+
+    for (const pandora::CartesianVector &point : pointVector)
+    {
+        const double delta[3] = {point.GetX() - mean[0], point.GetY() - mean[1], point.GetZ() - mean[2]};
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            for (unsigned int j = 0; j < 3; ++j)
+                covariance[i][j] += delta[i] * delta[j] / static_cast<double>(pointVector.size());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Check that the axes of a pca are orthonormal and that each is an eigenvector of the covariance with its eigenvalue
+ *
+ *  @param  pointVector the positions
+ *  @param  pca the principal components of the positions
+ */
+void CheckEigenSystem(const pandora::CartesianPointVector &pointVector, const lar_content::LArShowerPCA &pca)
+{
+    double covariance[3][3];
+    GetCovariance(pointVector, covariance);
+
+    const pandora::CartesianVector &eigenValues(pca.GetEigenValues());
+    const double scale(std::max(1., static_cast<double>(eigenValues.GetX())));
+
+    BOOST_CHECK_GE(eigenValues.GetX(), eigenValues.GetY());
+    BOOST_CHECK_GE(eigenValues.GetY(), eigenValues.GetZ() - 1.e-5 * scale);
+
+    const pandora::CartesianVector axes[3] = {pca.GetPrimaryAxis(), pca.GetSecondaryAxis(), pca.GetTertiaryAxis()};
+    const double values[3] = {eigenValues.GetX(), eigenValues.GetY(), eigenValues.GetZ()};
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        BOOST_CHECK_SMALL(axes[i].GetMagnitude() - 1.f, 1.e-5f);
+
+        for (unsigned int j = i + 1; j < 3; ++j)
+            BOOST_CHECK_SMALL(axes[i].GetDotProduct(axes[j]), 1.e-5f);
+
+        const double axis[3] = {axes[i].GetX(), axes[i].GetY(), axes[i].GetZ()};
+        double residual2(0.);
+
+        for (unsigned int row = 0; row < 3; ++row)
+        {
+            const double residual(covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2] - values[i] * axis[row]);
+            residual2 += residual * residual;
+        }
+
+        BOOST_CHECK_SMALL(std::sqrt(residual2) / scale, 1.e-4);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Get the positions of a random shower, a gaussian blob with the given widths along a random orthonormal set of axes
+ *
+ *  @param  generator the random number generator
+ *  @param  nPoints the number of positions
+ *  @param  centre the centre of the shower
+ *  @param  widths the widths along the three axes
+ *  @param  pointVector the output positions
+ */
+void GetRandomShower(std::mt19937 &generator, const unsigned int nPoints, const pandora::CartesianVector &centre, const double widths[3],
+    pandora::CartesianPointVector &pointVector)
+{
+    std::normal_distribution<double> gaussian(0., 1.);
+    double axes[3][3];
+
+    // Gram-Schmidt orthonormalisation of three random vectors
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int k = 0; k < 3; ++k)
+            axes[i][k] = gaussian(generator);
+
+        for (unsigned int j = 0; j < i; ++j)
+        {
+            const double projection(axes[i][0] * axes[j][0] + axes[i][1] * axes[j][1] + axes[i][2] * axes[j][2]);
+
+            for (unsigned int k = 0; k < 3; ++k)
+                axes[i][k] -= projection * axes[j][k];
+        }
+
+        const double norm(std::sqrt(axes[i][0] * axes[i][0] + axes[i][1] * axes[i][1] + axes[i][2] * axes[i][2]));
+
+        for (unsigned int k = 0; k < 3; ++k)
+            axes[i][k] /= norm;
+    }
+
+    pointVector.clear();
+
+    for (unsigned int n = 0; n < nPoints; ++n)
+    {
+        const double u[3] = {widths[0] * gaussian(generator), widths[1] * gaussian(generator), widths[2] * gaussian(generator)};
+        const double x(u[0] * axes[0][0] + u[1] * axes[1][0] + u[2] * axes[2][0]);
+        const double y(u[0] * axes[0][1] + u[1] * axes[1][1] + u[2] * axes[2][1]);
+        const double z(u[0] * axes[0][2] + u[1] * axes[1][2] + u[2] * axes[2][2]);
+        pointVector.emplace_back(centre.GetX() + x, centre.GetY() + y, centre.GetZ() + z);
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(RandomShowersMatchPandora)
+{
+    std::mt19937 generator(20191019);
+    std::uniform_real_distribution<double> width(0.1, 20.);
+    std::uniform_real_distribution<double> position(-500., 500.);
+
+    LArPandoraShowerPCA showerPCA;
+    pandora::CartesianPointVector pointVector;
+
+    for (unsigned int shower = 0; shower < 1000; ++shower)
+    {
+        // ATTN the widths are kept apart, so that the axes are well defined and can be compared with those from pandora
+        const double longitudinal(width(generator));
+        const double widths[3] = {longitudinal, 0.5 * longitudinal, 0.1 * longitudinal};
+        const pandora::CartesianVector centre(position(generator), position(generator), position(generator));
+        GetRandomShower(generator, 1000, centre, widths, pointVector);
+
+        const pandora::CartesianVector vertexPosition(centre.GetX() + 100.f, centre.GetY(), centre.GetZ());
+        const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, vertexPosition));
+        const lar_content::LArShowerPCA pandoraPCA(lar_content::LArPfoHelper::GetPrincipalComponents(pointVector, vertexPosition));
+
+        CheckEigenSystem(pointVector, pca);
+
+        BOOST_CHECK_SMALL((pca.GetCentroid() - pandoraPCA.GetCentroid()).GetMagnitude(), 1.e-4f * std::max(1.f, centre.GetMagnitude()));
+        BOOST_CHECK_CLOSE(pca.GetEigenValues().GetX(), pandoraPCA.GetEigenValues().GetX(), 1.e-2);
+        BOOST_CHECK_CLOSE(pca.GetEigenValues().GetY(), pandoraPCA.GetEigenValues().GetY(), 1.e-2);
+        BOOST_CHECK_CLOSE(pca.GetEigenValues().GetZ(), pandoraPCA.GetEigenValues().GetZ(), 1.e-1);
+
+        // The primary axes share their orientation, the signs of the others are arbitrary
+        BOOST_CHECK_GT(pca.GetPrimaryAxis().GetDotProduct(pandoraPCA.GetPrimaryAxis()), 1.f - 1.e-4f);
+        BOOST_CHECK_GT(std::fabs(pca.GetSecondaryAxis().GetDotProduct(pandoraPCA.GetSecondaryAxis())), 1.f - 1.e-4f);
+        BOOST_CHECK_GT(std::fabs(pca.GetTertiaryAxis().GetDotProduct(pandoraPCA.GetTertiaryAxis())), 1.f - 1.e-4f);
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(AxisAlignedShower)
+{
+    // Diagonal covariance, whose off-diagonal elements vanish exactly
+    pandora::CartesianPointVector pointVector;
+
+    for (const float x : {-3.f, 3.f})
+    {
+        for (const float y : {-2.f, 2.f})
+        {
+            for (const float z : {-1.f, 1.f})
+                pointVector.emplace_back(100.f + x, 200.f + y, 300.f + z);
+        }
+    }
+
+    LArPandoraShowerPCA showerPCA;
+    const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, pandora::CartesianVector(0.f, 200.f, 300.f)));
+
+    CheckEigenSystem(pointVector, pca);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetX(), 9.f, 1.e-3);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetY(), 4.f, 1.e-3);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetZ(), 1.f, 1.e-3);
+    BOOST_CHECK_GT(pca.GetPrimaryAxis().GetX(), 1.f - 1.e-5f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(CollinearShower)
+{
+    // Rank one covariance: the secondary and tertiary eigenvalues are both zero, so only the primary axis is defined
+    const pandora::CartesianVector direction(pandora::CartesianVector(1.f, 2.f, -2.f) * (1. / 3.));
+    pandora::CartesianPointVector pointVector;
+
+    for (unsigned int i = 0; i < 100; ++i)
+        pointVector.push_back(pandora::CartesianVector(50.f, -20.f, 700.f) + direction * (0.5 * i));
+
+    LArPandoraShowerPCA showerPCA;
+    const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, pointVector.front()));
+
+    CheckEigenSystem(pointVector, pca);
+    BOOST_CHECK_SMALL(pca.GetEigenValues().GetY(), 1.e-4f * pca.GetEigenValues().GetX());
+    BOOST_CHECK_SMALL(pca.GetEigenValues().GetZ(), 1.e-4f * pca.GetEigenValues().GetX());
+    BOOST_CHECK_GT(pca.GetPrimaryAxis().GetDotProduct(direction), 1.f - 1.e-5f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ProlateShower)
+{
+    // Repeated secondary and tertiary eigenvalues: a line of rings, so the axes perpendicular to the line are free within a plane
+    pandora::CartesianPointVector pointVector;
+
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+        for (unsigned int j = 0; j < 8; ++j)
+        {
+            const double phi(2. * M_PI * j / 8.);
+            pointVector.emplace_back(-10.f + i, 5.f + 0.5 * std::cos(phi), 5.f + 0.5 * std::sin(phi));
+        }
+    }
+
+    LArPandoraShowerPCA showerPCA;
+    const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, pandora::CartesianVector(-20.f, 5.f, 5.f)));
+
+    CheckEigenSystem(pointVector, pca);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetY(), pca.GetEigenValues().GetZ(), 1.e-2);
+    BOOST_CHECK_GT(pca.GetPrimaryAxis().GetX(), 1.f - 1.e-5f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(OblateShower)
+{
+    // Repeated primary and secondary eigenvalues: a ring in a tilted plane, so only the tertiary axis, the normal, is defined
+    const pandora::CartesianVector normal(pandora::CartesianVector(2.f, -1.f, 2.f) * (1. / 3.));
+    const pandora::CartesianVector inPlane1(pandora::CartesianVector(1.f, 2.f, 0.f) * (1. / std::sqrt(5.)));
+    const pandora::CartesianVector inPlane2(normal.GetCrossProduct(inPlane1));
+    pandora::CartesianPointVector pointVector;
+
+    for (unsigned int j = 0; j < 360; ++j)
+    {
+        const double phi(2. * M_PI * j / 360.);
+        pointVector.push_back(pandora::CartesianVector(-300.f, 100.f, 900.f) + inPlane1 * (10. * std::cos(phi)) + inPlane2 * (10. * std::sin(phi)));
+    }
+
+    LArPandoraShowerPCA showerPCA;
+    const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, pandora::CartesianVector(0.f, 0.f, 0.f)));
+
+    CheckEigenSystem(pointVector, pca);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetX(), pca.GetEigenValues().GetY(), 1.e-2);
+    BOOST_CHECK_SMALL(pca.GetEigenValues().GetZ(), 1.e-4f * pca.GetEigenValues().GetX());
+    BOOST_CHECK_GT(std::fabs(pca.GetTertiaryAxis().GetDotProduct(normal)), 1.f - 1.e-4f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(IsotropicShower)
+{
+    // Three repeated eigenvalues: the corners of a cube, so any orthonormal set of axes is valid
+    pandora::CartesianPointVector pointVector;
+
+    for (const float x : {-1.f, 1.f})
+    {
+        for (const float y : {-1.f, 1.f})
+        {
+            for (const float z : {-1.f, 1.f})
+                pointVector.emplace_back(400.f + x, -150.f + y, 20.f + z);
+        }
+    }
+
+    LArPandoraShowerPCA showerPCA;
+    const lar_content::LArShowerPCA pca(showerPCA.GetPrincipalComponents(pointVector, pandora::CartesianVector(0.f, 0.f, 0.f)));
+
+    CheckEigenSystem(pointVector, pca);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetX(), 1.f, 1.e-3);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetY(), 1.f, 1.e-3);
+    BOOST_CHECK_CLOSE(pca.GetEigenValues().GetZ(), 1.f, 1.e-3);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(PointlikeShower)
+{
+    // No spread at all, as for pandora the principal eigenvalue must be positive
+    const pandora::CartesianPointVector pointVector(10, pandora::CartesianVector(1.f, 2.f, 3.f));
+    const pandora::CartesianVector vertexPosition(0.f, 0.f, 0.f);
+
+    LArPandoraShowerPCA showerPCA;
+    BOOST_CHECK_THROW(showerPCA.GetPrincipalComponents(pointVector, vertexPosition), pandora::StatusCodeException);
+    BOOST_CHECK_THROW(lar_content::LArPfoHelper::GetPrincipalComponents(pointVector, vertexPosition), pandora::StatusCodeException);
+    BOOST_CHECK_THROW(showerPCA.GetPrincipalComponents(pandora::CartesianPointVector(), vertexPosition), pandora::StatusCodeException);
+}